@@ -1,179 +1,228 @@
 // sequence containers performance comparison
+// Build: g++ -std=c++20 -O2 -I../../Module_2_threading/samples/async_future_promise sample2.cpp
+// Run with --csv or --json for machine-readable results on stdout; the tables then go to stderr.
 #include <algorithm>
 #include <chrono>
 #include <deque>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <list>
+#include <ostream>
 #include <random>
+#include <sstream>
+#include <string>
 #include <vector>
 
+#include "MicroBenchmark.h"
+
 #define TEST_COUNT 1000
 class ContainerBenchmark {
  private:
   static const int DATA_SIZE = 50000;
   std::mt19937 rng{std::random_device{}()};
   std::uniform_int_distribution<int> dist{1, 100000};
-  // Helper function to measure execution time
-  template <typename Func>
-  double measureTime(Func&& func) {
-    auto start = std::chrono::high_resolution_clock::now();
-    func();
-    auto end = std::chrono::high_resolution_clock::now();
-    auto duration =
-        std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-    return duration.count() / 1000.0;  // Convert to milliseconds
+  std::ostream& out_;
+  std::vector<microbench::Summary> results_;
+
+  // Values are drawn once so the timed loops measure the container, not the RNG
+  std::vector<int> randomValues(int count) {
+    std::vector<int> values(count);
+    std::generate(values.begin(), values.end(), [&]() { return dist(rng); });
+    return values;
+  }
+
+  // Times `func` on a fresh container from `make` per sample (warmup, median, 95% CI); building it is not timed
+  template <typename Make, typename Func>
+  microbench::Summary measureTime(std::string name, Make&& make, Func&& func) {
+    const microbench::Options options{.warmupRuns = 1, .minSamples = 5, .maxSamples = 50};
+    results_.push_back(microbench::measureTimed(
+        std::move(name),
+        [&]() {
+          auto container = make();
+          const auto start = microbench::Clock::now();
+          func(container);
+          microbench::ClobberMemory();
+          const auto elapsed = microbench::Clock::now() - start;
+          microbench::DoNotOptimize(container);
+          return elapsed;
+        },
+        options));
+    return results_.back();
+  }
+
+  // Median with its CI, in milliseconds
+  static std::string cell(const microbench::Summary& s) {
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(3) << s.medianMillis() << " +-"
+         << (s.ciHighNanos - s.ciLowNanos) / 2e6;
+    return text.str();
+  }
+
+  void header() {
+    out_ << std::setw(20) << "Operation" << std::setw(24) << "Vector (ms)" << std::setw(24) << "List (ms)"
+         << std::setw(24) << "Deque (ms)" << std::endl;
+    out_ << std::string(92, '-') << std::endl;
   }
 
  public:
+  explicit ContainerBenchmark(std::ostream& out) : out_(out) {}
+
+  const std::vector<microbench::Summary>& results() const { return results_; }
+
   void benchmarkSequenceContainers() {
-    std::cout << "=== SEQUENCE CONTAINER PERFORMANCE COMPARISON ==="
-              << std::endl;
-    std::cout << "Data size: " << DATA_SIZE << " elements\n" << std::endl;
-    // Test containers
-    std::vector<int> testVector;
-    std::list<int> testList;
-    std::deque<int> testDeque;
-    // Reserve space for vector to avoid reallocation during benchmark
-    testVector.reserve(DATA_SIZE);
-    std::cout << std::fixed << std::setprecision(3);
-    std::cout << std::setw(20) << "Operation" << std::setw(15) << "Vector (ms)"
-              << std::setw(15) << "List (ms)" << std::setw(15) << "Deque (ms)"
-              << std::endl;
-    std::cout << std::string(65, '-') << std::endl;
-    // Test back insertion performance
-    double vectorBackTime = measureTime([&]() {
-      for (int i = 0; i < DATA_SIZE; ++i) {
-        testVector.push_back(dist(rng));
+    out_ << "=== SEQUENCE CONTAINER PERFORMANCE COMPARISON ===" << std::endl;
+    out_ << "Data size: " << DATA_SIZE << " elements (median +- 95% CI half-width)\n" << std::endl;
+    const std::vector<int> values = randomValues(DATA_SIZE);
+    header();
+    // Test back insertion performance; reserve space for vector to avoid reallocation during benchmark
+    const auto reserved = []() {
+      std::vector<int> v;
+      v.reserve(DATA_SIZE);
+      return v;
+    };
+    const auto emptyList = []() { return std::list<int>{}; };
+    const auto emptyDeque = []() { return std::deque<int>{}; };
+    const auto vectorBack = measureTime("back insertion/vector", reserved, [&](std::vector<int>& v) {
+      for (int value : values) {
+        v.push_back(value);
       }
     });
-    double listBackTime = measureTime([&]() {
-      for (int i = 0; i < DATA_SIZE; ++i) {
-        testList.push_back(dist(rng));
+    const auto listBack = measureTime("back insertion/list", emptyList, [&](std::list<int>& l) {
+      for (int value : values) {
+        l.push_back(value);
       }
     });
-    double dequeBackTime = measureTime([&]() {
-      for (int i = 0; i < DATA_SIZE; ++i) {
-        testDeque.push_back(dist(rng));
+    const auto dequeBack = measureTime("back insertion/deque", emptyDeque, [&](std::deque<int>& d) {
+      for (int value : values) {
+        d.push_back(value);
       }
     });
-    std::cout << std::setw(20) << "Back Insertion" << std::setw(15)
-              << vectorBackTime << std::setw(15) << listBackTime
-              << std::setw(15) << dequeBackTime << std::endl;
+    out_ << std::setw(20) << "Back Insertion" << std::setw(24) << cell(vectorBack) << std::setw(24)
+         << cell(listBack) << std::setw(24) << cell(dequeBack) << std::endl;
     // Test front insertion performance (skip vector due to poor performance)
-    std::list<int> frontTestList;
-    std::deque<int> frontTestDeque;
-    double listFrontTime = measureTime([&]() {
-      for (int i = 0; i < DATA_SIZE; ++i) {
-        frontTestList.push_front(dist(rng));
+    const auto listFront = measureTime("front insertion/list", emptyList, [&](std::list<int>& l) {
+      for (int value : values) {
+        l.push_front(value);
       }
     });
-    double dequeFrontTime = measureTime([&]() {
-      for (int i = 0; i < DATA_SIZE; ++i) {
-        frontTestDeque.push_front(dist(rng));
+    const auto dequeFront = measureTime("front insertion/deque", emptyDeque, [&](std::deque<int>& d) {
+      for (int value : values) {
+        d.push_front(value);
       }
     });
-    std::cout << std::setw(20) << "Front Insertion" << std::setw(15)
-              << "N/A (O(n))" << std::setw(15) << listFrontTime << std::setw(15)
-              << dequeFrontTime << std::endl;
+    out_ << std::setw(20) << "Front Insertion" << std::setw(24) << "N/A (O(n))" << std::setw(24) << cell(listFront)
+         << std::setw(24) << cell(dequeFront) << std::endl;
     // Test random access performance
+    const std::vector<int> testVector(values.begin(), values.end());
+    const std::list<int> testList(values.begin(), values.end());
+    const std::deque<int> testDeque(values.begin(), values.end());
     std::vector<int> positions;
     for (int i = 0; i < 10000; ++i) {
-      positions.push_back(std::uniform_int_distribution<int>{
-          0, static_cast<int>(testVector.size() - 1)}(rng));
+      positions.push_back(
+          std::uniform_int_distribution<int>{0, static_cast<int>(testVector.size() - 1)}(rng));
     }
-    double vectorAccessTime = measureTime([&]() {
-      volatile int sum = 0;  // Prevent optimization
-      for (int pos : positions) {
-        sum += testVector[pos];
-      }
-    });
-    double dequeAccessTime = measureTime([&]() {
-      volatile int sum = 0;
-      for (int pos : positions) {
-        sum += testDeque[pos];
-      }
-    });
-    // List random access is O(n) - demonstrate with smaller sample
-    std::vector<int> smallPositions(positions.begin(),
-                                    positions.begin() + 1000);
-    double listAccessTime = measureTime([&]() {
-                              volatile int sum = 0;
-                              for (int pos : smallPositions) {
-                                auto it = testList.begin();
-                                std::advance(it, pos);
-                                sum += *it;
-                              }
-                            }) *
-                            10;  // Scale up to compare with others        
-    std::cout << std::setw(20) << "Random Access" << std::setw(15)
-              << vectorAccessTime << std::setw(15) << listAccessTime << " (est)"
-              << std::setw(15) << dequeAccessTime << std::endl;
-    std::cout << std::string(65, '-') << std::endl;
-    std::cout << "Performance Analysis:" << std::endl;
-    std::cout << "• Vector: Excellent random access, good back insertion, poor "
-                 "front insertion"
-              << std::endl;
-    std::cout << "• List: Good insertion anywhere, poor random access"
-              << std::endl;
-    std::cout << "• Deque: Good insertion at ends, good random access"
-              << std::endl;
+    // Read-only bodies need no fresh copy, so measure() can batch them
+    const microbench::Options accessOptions{.minSamples = 5, .maxSamples = 50};
+    results_.push_back(microbench::measure(
+        "random access/vector",
+        [&]() {
+          long long sum = 0;
+          for (int pos : positions) {
+            sum += testVector[pos];
+          }
+          microbench::DoNotOptimize(sum);
+        },
+        accessOptions));
+    const microbench::Summary vectorAccess = results_.back();
+    results_.push_back(microbench::measure(
+        "random access/deque",
+        [&]() {
+          long long sum = 0;
+          for (int pos : positions) {
+            sum += testDeque[pos];
+          }
+          microbench::DoNotOptimize(sum);
+        },
+        accessOptions));
+    const microbench::Summary dequeAccess = results_.back();
+    // List random access is O(n) - demonstrate with smaller sample, scaled up to compare with others
+    std::vector<int> smallPositions(positions.begin(), positions.begin() + 1000);
+    results_.push_back(microbench::measure(
+        "random access/list (1/10 of positions)",
+        [&]() {
+          long long sum = 0;
+          for (int pos : smallPositions) {
+            auto it = testList.begin();
+            std::advance(it, pos);
+            sum += *it;
+          }
+          microbench::DoNotOptimize(sum);
+        },
+        accessOptions));
+    microbench::Summary listAccess = results_.back();
+    listAccess.medianNanos *= 10;
+    listAccess.ciLowNanos *= 10;
+    listAccess.ciHighNanos *= 10;
+    out_ << std::setw(20) << "Random Access" << std::setw(24) << cell(vectorAccess) << std::setw(24)
+         << cell(listAccess) + " (est)" << std::setw(24) << cell(dequeAccess) << std::endl;
+    out_ << std::string(92, '-') << std::endl;
+    out_ << "Performance Analysis:" << std::endl;
+    out_ << "• Vector: Excellent random access, good back insertion, poor "
+            "front insertion"
+         << std::endl;
+    out_ << "• List: Good insertion anywhere, poor random access" << std::endl;
+    out_ << "• Deque: Good insertion at ends, good random access" << std::endl;
   }
   void benchmarkMiddleOperations() {
-    std::cout << "\n=== MIDDLE INSERTION/DELETION COMPARISON ===" << std::endl;
-    const int SMALLER_SIZE = 10000;  // Reduced for middle operations        
-    // Prepare containers with initial data
-    std::vector<int> testVector;
-    std::list<int> testList;
-    std::deque<int> testDeque;
-    for (int i = 0; i < SMALLER_SIZE; ++i) {
-      int value = dist(rng);
-      testVector.push_back(value);
-      testList.push_back(value);
-      testDeque.push_back(value);
-    }
-    std::cout << std::fixed << std::setprecision(3);
-    std::cout << std::setw(20) << "Operation" << std::setw(15) << "Vector (ms)"
-              << std::setw(15) << "List (ms)" << std::setw(15) << "Deque (ms)"
-              << std::endl;
-    std::cout << std::string(65, '-') << std::endl;
+    out_ << "\n=== MIDDLE INSERTION/DELETION COMPARISON ===" << std::endl;
+    const int SMALLER_SIZE = 10000;  // Reduced for middle operations
+    // Prepare containers with initial data; every sample starts from a copy of these
+    const std::vector<int> initial = randomValues(SMALLER_SIZE);
+    const std::vector<int> values = randomValues(TEST_COUNT);
+    const std::vector<int> testVector(initial.begin(), initial.end());
+    const std::list<int> testList(initial.begin(), initial.end());
+    const std::deque<int> testDeque(initial.begin(), initial.end());
+    const auto copyVector = [&]() { return testVector; };
+    const auto copyList = [&]() { return testList; };
+    const auto copyDeque = [&]() { return testDeque; };
+    header();
     // Test middle insertion
-    double vectorMiddleInsert = measureTime([&]() {
-      for (int i = 0; i < TEST_COUNT; ++i) {
-        auto it = testVector.begin() + testVector.size() / 2;
-        testVector.insert(it, dist(rng));
+    const auto vectorMiddleInsert = measureTime("middle insertion/vector", copyVector, [&](std::vector<int>& v) {
+      for (int value : values) {
+        v.insert(v.begin() + v.size() / 2, value);
       }
     });
-    double listMiddleInsert = measureTime([&]() {
-      for (int i = 0; i < TEST_COUNT; ++i) {
-        auto it = testList.begin();
-        std::advance(it, testList.size() / 2);
-        testList.insert(it, dist(rng));
+    const auto listMiddleInsert = measureTime("middle insertion/list", copyList, [&](std::list<int>& l) {
+      for (int value : values) {
+        auto it = l.begin();
+        std::advance(it, l.size() / 2);
+        l.insert(it, value);
       }
     });
-    double dequeMiddleInsert = measureTime([&]() {
-      for (int i = 0; i < TEST_COUNT; ++i) {
-        auto it = testDeque.begin() + testDeque.size() / 2;
-        testDeque.insert(it, dist(rng));
+    const auto dequeMiddleInsert = measureTime("middle insertion/deque", copyDeque, [&](std::deque<int>& d) {
+      for (int value : values) {
+        d.insert(d.begin() + d.size() / 2, value);
       }
     });
-    std::cout << std::setw(20) << "Middle Insertion" << std::setw(15)
-              << vectorMiddleInsert << std::setw(15) << listMiddleInsert
-              << std::setw(15) << dequeMiddleInsert << std::endl;
-    std::cout << std::string(65, '-') << std::endl;
-    std::cout << "Middle Operations Analysis:" << std::endl;
-    std::cout << "• Vector: O(n) - Must shift all subsequent elements"
-              << std::endl;
-    std::cout << "• List: O(1) - Direct insertion at position" << std::endl;
-    std::cout << "• Deque: O(n) - Must shift elements, but better than vector"
-              << std::endl;
+    out_ << std::setw(20) << "Middle Insertion" << std::setw(24) << cell(vectorMiddleInsert) << std::setw(24)
+         << cell(listMiddleInsert) << std::setw(24) << cell(dequeMiddleInsert) << std::endl;
+    out_ << std::string(92, '-') << std::endl;
+    out_ << "Middle Operations Analysis:" << std::endl;
+    out_ << "• Vector: O(n) - Must shift all subsequent elements" << std::endl;
+    out_ << "• List: O(1) - Direct insertion at position" << std::endl;
+    out_ << "• Deque: O(n) - Must shift elements, but better than vector" << std::endl;
   }
 };
-int main() {
-  std::cout << "STL SEQUENCE CONTAINER PERFORMANCE ANALYSIS" << std::endl;
-  std::cout << "===========================================" << std::endl;
-  ContainerBenchmark benchmark;
+int main(int argc, char* argv[]) {
+  const auto format = microbench::formatFromArgs(argc, argv);
+  std::ostream& out = format == microbench::Format::Table ? std::cout : std::cerr;
+  out << "STL SEQUENCE CONTAINER PERFORMANCE ANALYSIS" << std::endl;
+  out << "===========================================" << std::endl;
+  ContainerBenchmark benchmark(out);
   benchmark.benchmarkSequenceContainers();
   benchmark.benchmarkMiddleOperations();
+  out << std::endl;
+  microbench::write(std::cout, benchmark.results(), format);
   return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,187 @@
+#ifndef ACTOR_H
+#define ACTOR_H
+
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "DynamicThreadPool.h"
+#include "MpscQueue.h"
+#include "logging.h"
+
+// State with many writers and one serialized reader, without a lock around the state.
+//
+// Any thread may send(); messages land in the actor's IntrusiveMpscQueue mailbox. When the mailbox goes from empty to
+// non-empty, the sender schedules one turn on the DynamicThreadPool. A turn handles at most `batchSize` messages and
+// then either hands the worker back (mailbox drained) or resubmits itself behind whatever else is queued on the pool,
+// so one busy actor cannot monopolise a worker. A single `pending_` counter decides who schedules: only the 0 -> 1
+// transition submits a turn and only the turn that leaves messages behind submits the next one, so at most one turn
+// exists at any time and the handler never runs concurrently with itself. Everything the handler touches between
+// turns is therefore owned by the actor.
+//
+// A plain Message travels in a heap-allocated envelope (one allocation per send). A Message derived from
+// lockfree::MpscNode is linked into the mailbox as is: send(Message*) takes a node the caller owns, so sending never
+// allocates. The actor hands each node to the `release` callback once its handler has returned, e.g. to push it back
+// onto the sender's free list; until then the node must not be sent again or freed. The handler must not block: it
+// holds a pool worker. Exceptions it throws are counted and logged; the actor keeps going with the next message.
+// Destroy actors before their pool, and stop sending first: the destructor waits for the mailbox to drain.
+template <typename Message>
+class Actor {
+ public:
+  static constexpr bool kIntrusive = std::derived_from<Message, lockfree::MpscNode>;
+
+  using Handler = std::function<void(Message&)>;
+  using Release = std::function<void(Message*)>;  // intrusive messages only
+
+  struct Stats {
+    std::uint64_t processed;
+    std::uint64_t turns;
+    std::uint64_t failures;
+    std::size_t pending;
+  };
+
+ private:
+  struct Envelope : lockfree::MpscNode {
+    Message message;
+
+    explicit Envelope(Message msg) : message(std::move(msg)) {}
+  };
+  using Node = std::conditional_t<kIntrusive, Message, Envelope>;
+
+  DynamicThreadPool& pool_;
+  Handler handler_;
+  const std::size_t batchSize_;
+  const TaskPriority priority_;
+  const std::string name_;
+  const Release release_;
+
+  lockfree::IntrusiveMpscQueue<Node> mailbox_;
+  alignas(64) std::atomic<std::size_t> pending_{0};  // sent and not yet handled
+
+  // Written by turns only; read by stats()
+  std::atomic<std::uint64_t> processed_{0};
+  std::atomic<std::uint64_t> turns_{0};
+  std::atomic<std::uint64_t> failures_{0};
+
+  static Message& messageOf(Node* node) {
+    if constexpr (kIntrusive) {
+      return *node;
+    } else {
+      return node->message;
+    }
+  }
+
+  void retire(Node* node) {
+    if constexpr (kIntrusive) {
+      if (release_) {
+        release_(node);
+      }
+    } else {
+      delete node;
+    }
+  }
+
+  void enqueue(Node* node) {
+    mailbox_.push(node);
+    if (pending_.fetch_add(1, std::memory_order_acq_rel) == 0) {
+      schedule();
+    }
+  }
+
+  void schedule() {
+    pool_.submit([this] { runTurn(); }, priority_, name_);
+  }
+
+  void runTurn() {
+    std::size_t handled = 0;
+    // A null pop with pending_ > 0 is a sender between its two push steps: end the turn and come back
+    while (handled < batchSize_) {
+      Node* node = mailbox_.pop();
+      if (node == nullptr) {
+        break;
+      }
+      try {
+        handler_(messageOf(node));
+      } catch (const std::exception& e) {
+        failures_.fetch_add(1, std::memory_order_relaxed);
+        logging::logSync(std::cerr, "Actor ", name_, " handler failed: ", e.what(), "\n");
+      } catch (...) {
+        failures_.fetch_add(1, std::memory_order_relaxed);
+        logging::logSync(std::cerr, "Actor ", name_, " handler failed with unknown exception\n");
+      }
+      retire(node);
+      ++handled;
+    }
+    processed_.fetch_add(handled, std::memory_order_relaxed);
+    turns_.fetch_add(1, std::memory_order_relaxed);
+    if (handled == 0) {
+      std::this_thread::yield();
+    }
+    // Last touch of `this` when the mailbox is drained: the destructor may run as soon as pending_ reads zero
+    if (pending_.fetch_sub(handled, std::memory_order_acq_rel) > handled) {
+      schedule();
+    }
+  }
+
+ public:
+  Actor(DynamicThreadPool& pool, Handler handler, std::string name = "actor", std::size_t batchSize = 64,
+        TaskPriority priority = TaskPriority::NORMAL)
+      : pool_(pool),
+        handler_(std::move(handler)),
+        batchSize_(batchSize == 0 ? 1 : batchSize),
+        priority_(priority),
+        name_(std::move(name)) {}
+
+  // Intrusive messages: `release` gets every node back after its handler returned (may be empty)
+  Actor(DynamicThreadPool& pool, Handler handler, Release release, std::string name = "actor",
+        std::size_t batchSize = 64, TaskPriority priority = TaskPriority::NORMAL)
+    requires kIntrusive
+      : pool_(pool),
+        handler_(std::move(handler)),
+        batchSize_(batchSize == 0 ? 1 : batchSize),
+        priority_(priority),
+        name_(std::move(name)),
+        release_(std::move(release)) {}
+
+  Actor(const Actor&) = delete;
+  Actor& operator=(const Actor&) = delete;
+
+  ~Actor() { drain(); }
+
+  void send(Message message)
+    requires(!kIntrusive)
+  {
+    enqueue(new Envelope(std::move(message)));
+  }
+
+  // Links the caller's node; no allocation. The node is the actor's until it comes back through `release`.
+  void send(Message* node)
+    requires kIntrusive
+  {
+    enqueue(node);
+  }
+
+  // Waits (yielding) until every message sent so far has been handled; must not be called from this actor's handler
+  void drain() const {
+    while (pending_.load(std::memory_order_acquire) != 0) {
+      std::this_thread::yield();
+    }
+  }
+
+  const std::string& name() const { return name_; }
+
+  Stats stats() const {
+    return Stats{processed_.load(std::memory_order_relaxed), turns_.load(std::memory_order_relaxed),
+                 failures_.load(std::memory_order_relaxed), pending_.load(std::memory_order_relaxed)};
+  }
+};
+
+#endif  // ACTOR_H
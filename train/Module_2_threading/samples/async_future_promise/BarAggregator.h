@@ -0,0 +1,219 @@
+#ifndef BAR_AGGREGATOR_H
+#define BAR_AGGREGATOR_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+struct OhlcBar {
+  std::int64_t startNanos{0};
+  double open{0.0};
+  double high{0.0};
+  double low{0.0};
+  double close{0.0};
+  std::int64_t volume{0};
+  std::uint32_t tickCount{0};
+};
+
+struct BarCloseEvent {
+  std::size_t symbolId;
+  std::string_view symbol;
+  std::size_t timeframeIndex;
+  std::chrono::nanoseconds timeframe;
+  const OhlcBar& bar;
+};
+
+// Incremental multi-timeframe OHLCV builder. All storage (open bar + ring of closed bars per symbol per timeframe) is
+// allocated up front, so the per-tick path never allocates once a symbol is registered. Not thread-safe: feed it from
+// a single thread (e.g. the tick consumer that owns the price table).
+//
+// Ticks are expected in timestamp order per symbol. A late tick, one whose bucket is older than the newest bar opened
+// for that timeframe or whose bar flush() has already closed, is left out of that timeframe (its bar has been
+// published already) and counted in lateTicks(); it still updates longer timeframes whose current bar covers it.
+class BarAggregator {
+ public:
+  using Clock = std::chrono::steady_clock;
+  using BarCloseHandler = std::function<void(const BarCloseEvent&)>;
+  static constexpr std::size_t kInvalidSymbol = static_cast<std::size_t>(-1);
+
+ private:
+  struct SeriesState {
+    OhlcBar current;
+    bool open{false};
+    std::int64_t newestStart{std::numeric_limits<std::int64_t>::min()};  // start of the newest bar opened
+    std::size_t historyHead{0};   // next write position in the history ring
+    std::size_t historyCount{0};  // closed bars stored (<= historyDepth_)
+  };
+
+  std::vector<std::chrono::nanoseconds> timeframes_;
+  std::size_t maxSymbols_;
+  std::size_t historyDepth_;
+
+  // Flat layout: series index = symbolId * timeframes + timeframeIndex
+  std::vector<SeriesState> series_;
+  std::vector<OhlcBar> history_;  // historyDepth_ bars per series
+
+  std::unordered_map<std::string, std::size_t> symbolIds_;
+  std::vector<std::string> symbolNames_;
+  std::vector<BarCloseHandler> subscribers_;
+  std::uint64_t barsClosed_{0};
+  std::uint64_t lateTicks_{0};
+
+  SeriesState& seriesAt(std::size_t symbolId, std::size_t tf) { return series_[symbolId * timeframes_.size() + tf]; }
+
+  const SeriesState& seriesAt(std::size_t symbolId, std::size_t tf) const {
+    return series_[symbolId * timeframes_.size() + tf];
+  }
+
+  OhlcBar* historyOf(std::size_t symbolId, std::size_t tf) {
+    return history_.data() + (symbolId * timeframes_.size() + tf) * historyDepth_;
+  }
+
+  const OhlcBar* historyOf(std::size_t symbolId, std::size_t tf) const {
+    return history_.data() + (symbolId * timeframes_.size() + tf) * historyDepth_;
+  }
+
+  void closeBar(std::size_t symbolId, std::size_t tf, SeriesState& state) {
+    OhlcBar* ring = historyOf(symbolId, tf);
+    ring[state.historyHead] = state.current;
+    const OhlcBar& closed = ring[state.historyHead];
+    state.historyHead = (state.historyHead + 1) % historyDepth_;
+    state.historyCount = std::min(state.historyCount + 1, historyDepth_);
+    state.open = false;
+    ++barsClosed_;
+
+    if (!subscribers_.empty()) {
+      const BarCloseEvent event{symbolId, symbolNames_[symbolId], tf, timeframes_[tf], closed};
+      for (const auto& subscriber : subscribers_) {
+        subscriber(event);
+      }
+    }
+  }
+
+ public:
+  BarAggregator(std::initializer_list<std::chrono::nanoseconds> timeframes, std::size_t maxSymbols,
+                std::size_t historyDepth = 64)
+      : timeframes_(timeframes), maxSymbols_(maxSymbols), historyDepth_(historyDepth) {
+    if (timeframes_.empty() || historyDepth_ == 0) {
+      throw std::invalid_argument("BarAggregator: need at least one timeframe and a non-zero history depth");
+    }
+    series_.resize(maxSymbols_ * timeframes_.size());
+    history_.resize(maxSymbols_ * timeframes_.size() * historyDepth_);
+    symbolIds_.reserve(maxSymbols_);
+    symbolNames_.reserve(maxSymbols_);
+  }
+
+  // Subscribers must be added before ticks start flowing
+  void subscribe(BarCloseHandler handler) { subscribers_.push_back(std::move(handler)); }
+
+  // Returns kInvalidSymbol once maxSymbols is reached
+  std::size_t registerSymbol(const std::string& symbol) {
+    if (auto it = symbolIds_.find(symbol); it != symbolIds_.end()) {
+      return it->second;
+    }
+    if (symbolNames_.size() >= maxSymbols_) {
+      return kInvalidSymbol;
+    }
+    const std::size_t id = symbolNames_.size();
+    symbolNames_.push_back(symbol);
+    symbolIds_.emplace(symbol, id);
+    return id;
+  }
+
+  std::size_t symbolId(const std::string& symbol) const {
+    auto it = symbolIds_.find(symbol);
+    return it == symbolIds_.end() ? kInvalidSymbol : it->second;
+  }
+
+  void onTick(std::size_t symbolId, double price, std::int64_t volume, Clock::time_point timestamp) {
+    const std::int64_t nowNanos =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch()).count();
+
+    bool late = false;
+    for (std::size_t tf = 0; tf < timeframes_.size(); ++tf) {
+      const std::int64_t period = timeframes_[tf].count();
+      const std::int64_t bucketStart = nowNanos - (nowNanos % period);
+      SeriesState& state = seriesAt(symbolId, tf);
+
+      // Older than the newest bar, or in the newest bucket after flush() already closed it
+      if (bucketStart < state.newestStart || (!state.open && bucketStart == state.newestStart)) {
+        late = true;
+        continue;
+      }
+      if (state.open && bucketStart != state.current.startNanos) {
+        closeBar(symbolId, tf, state);
+      }
+
+      OhlcBar& bar = state.current;
+      if (!state.open) {
+        bar = OhlcBar{bucketStart, price, price, price, price, volume, 1};
+        state.open = true;
+        state.newestStart = bucketStart;
+        continue;
+      }
+
+      bar.high = std::max(bar.high, price);
+      bar.low = std::min(bar.low, price);
+      bar.close = price;
+      bar.volume += volume;
+      ++bar.tickCount;
+    }
+    lateTicks_ += late ? 1 : 0;
+  }
+
+  void onTick(const std::string& symbol, double price, std::int64_t volume, Clock::time_point timestamp) {
+    const std::size_t id = registerSymbol(symbol);
+    if (id != kInvalidSymbol) {
+      onTick(id, price, volume, timestamp);
+    }
+  }
+
+  // Close every open bar whose bucket has ended by `now`; lets quiet symbols still emit bar-close events
+  void flush(Clock::time_point now) {
+    const std::int64_t nowNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
+    for (std::size_t symbolId = 0; symbolId < symbolNames_.size(); ++symbolId) {
+      for (std::size_t tf = 0; tf < timeframes_.size(); ++tf) {
+        SeriesState& state = seriesAt(symbolId, tf);
+        if (state.open && nowNanos >= state.current.startNanos + timeframes_[tf].count()) {
+          closeBar(symbolId, tf, state);
+        }
+      }
+    }
+  }
+
+  // The bar still being built, if any
+  const OhlcBar* currentBar(std::size_t symbolId, std::size_t tf) const {
+    const SeriesState& state = seriesAt(symbolId, tf);
+    return state.open ? &state.current : nullptr;
+  }
+
+  // ago = 0 is the most recently closed bar
+  const OhlcBar* closedBar(std::size_t symbolId, std::size_t tf, std::size_t ago = 0) const {
+    const SeriesState& state = seriesAt(symbolId, tf);
+    if (ago >= state.historyCount) {
+      return nullptr;
+    }
+    const std::size_t index = (state.historyHead + historyDepth_ - 1 - ago) % historyDepth_;
+    return historyOf(symbolId, tf) + index;
+  }
+
+  std::size_t timeframeCount() const { return timeframes_.size(); }
+
+  std::size_t symbolCount() const { return symbolNames_.size(); }
+
+  std::uint64_t barsClosed() const { return barsClosed_; }
+
+  // Ticks left out of at least one timeframe for arriving after their bar was closed
+  std::uint64_t lateTicks() const { return lateTicks_; }
+};
+
+#endif  // BAR_AGGREGATOR_H
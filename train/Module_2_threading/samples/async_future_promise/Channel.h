@@ -0,0 +1,341 @@
+#ifndef CHANNEL_H
+#define CHANNEL_H
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Go-style channels.
+//
+// Channel<T>(capacity) is a closable FIFO shared by any number of senders and receivers. With capacity > 0, send()
+// blocks only while the buffer is full. With capacity 0 the channel is unbuffered: send() returns once a receiver has
+// taken the value (a rendezvous). close() stops further sends; receivers drain what is buffered and then get nullopt.
+// Every blocking call takes an optional std::stop_token and gives up when stop is requested.
+//
+// select() waits on several channels at once. Each channel keeps a list of the selects parked on it and wakes them
+// when a value arrives or the channel closes, so a consumer of ticks, control messages and timers sleeps on one
+// condition variable and wakes once per event instead of polling each queue.
+namespace channels {
+
+namespace detail {
+
+// One per blocked select() call; channels signal it, the select sleeps on it
+struct SelectWaiter {
+  std::mutex mutex;
+  std::condition_variable_any condition;
+  bool signalled{false};
+
+  void notify() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      signalled = true;
+    }
+    condition.notify_one();
+  }
+};
+
+struct SelectAccess;
+
+}  // namespace detail
+
+template <typename T>
+class Channel {
+ private:
+  friend struct detail::SelectAccess;
+
+  mutable std::mutex mutex_;
+  std::condition_variable_any notEmpty_;  // receivers
+  std::condition_variable_any notFull_;   // senders: free slot, or pickup of an unbuffered value
+  std::deque<T> items_;
+  const std::size_t capacity_;
+  std::uint64_t received_{0};  // values taken so far; an unbuffered sender waits for it to pass its position
+  bool closed_{false};
+  std::vector<detail::SelectWaiter*> selectors_;
+
+  // Called with mutex_ held: the selector list must not change underneath
+  void notifyReceivers() {
+    notEmpty_.notify_one();
+    for (detail::SelectWaiter* waiter : selectors_) {
+      waiter->notify();
+    }
+  }
+
+  T popLocked() {
+    T value = std::move(items_.front());
+    items_.pop_front();
+    ++received_;
+    // Unbuffered senders waiting for pickup share notFull_ with senders waiting for the slot
+    if (capacity_ == 0) {
+      notFull_.notify_all();
+    } else {
+      notFull_.notify_one();
+    }
+    return value;
+  }
+
+  void addSelector(detail::SelectWaiter* waiter) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    selectors_.push_back(waiter);
+  }
+
+  void removeSelector(detail::SelectWaiter* waiter) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    selectors_.erase(std::find(selectors_.begin(), selectors_.end(), waiter));
+  }
+
+ public:
+  explicit Channel(std::size_t capacity = 0) : capacity_(capacity) {}
+
+  Channel(const Channel&) = delete;
+  Channel& operator=(const Channel&) = delete;
+
+  // False if the channel was closed (or, unbuffered, closed before a receiver took the value) or stop was requested.
+  // A value that was not delivered is dropped.
+  bool send(T value, std::stop_token token = {}) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    const std::size_t slots = std::max<std::size_t>(capacity_, 1);
+    if (!notFull_.wait(lock, token, [this, slots] { return closed_ || items_.size() < slots; }) || closed_) {
+      return false;
+    }
+    items_.push_back(std::move(value));
+    const std::uint64_t position = received_ + items_.size() - 1;
+    notifyReceivers();
+    if (capacity_ > 0) {
+      return true;
+    }
+    notFull_.wait(lock, token, [this, position] { return received_ > position || closed_; });
+    if (received_ > position) {
+      return true;
+    }
+    // Nobody took it: it is still the only buffered value, so take it back
+    items_.pop_back();
+    notFull_.notify_all();
+    return false;
+  }
+
+  // Never blocks: fails when the buffer is full or closed. Unbuffered channels have no buffer, so it always fails.
+  bool trySend(T value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (closed_ || items_.size() >= capacity_) {
+      return false;
+    }
+    items_.push_back(std::move(value));
+    notifyReceivers();
+    return true;
+  }
+
+  // nullopt once the channel is closed and drained, or when stop is requested while nothing is buffered
+  std::optional<T> receive(std::stop_token token = {}) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!notEmpty_.wait(lock, token, [this] { return !items_.empty() || closed_; }) || items_.empty()) {
+      return std::nullopt;
+    }
+    return popLocked();
+  }
+
+  std::optional<T> tryReceive() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (items_.empty()) {
+      return std::nullopt;
+    }
+    return popLocked();
+  }
+
+  void close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    notEmpty_.notify_all();
+    notFull_.notify_all();
+    for (detail::SelectWaiter* waiter : selectors_) {
+      waiter->notify();
+    }
+  }
+
+  bool closed() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return closed_;
+  }
+
+  // Closed with nothing left to receive: select() skips such channels
+  bool drained() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return closed_ && items_.empty();
+  }
+
+  std::size_t size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return items_.size();
+  }
+
+  std::size_t capacity() const { return capacity_; }
+};
+
+// A select() arm: call `handler(T&&)` with a value received from `channel`
+template <typename T, typename Handler>
+struct ReceiveCase {
+  Channel<T>& channel;
+  Handler handler;
+};
+
+template <typename T, typename Handler>
+ReceiveCase<T, std::decay_t<Handler>> onReceive(Channel<T>& channel, Handler&& handler) {
+  return {channel, std::forward<Handler>(handler)};
+}
+
+namespace detail {
+
+struct SelectAccess {
+  template <typename T>
+  static void add(Channel<T>& channel, SelectWaiter* waiter) {
+    channel.addSelector(waiter);
+  }
+
+  template <typename T>
+  static void remove(Channel<T>& channel, SelectWaiter* waiter) {
+    channel.removeSelector(waiter);
+  }
+};
+
+// Keeps a select's waiter registered on every arm's channel for as long as it lives, so a handler or receive that
+// throws cannot leave a channel pointing at the destroyed waiter
+template <typename... Cases>
+class SelectRegistration {
+ public:
+  SelectRegistration(SelectWaiter& waiter, std::tuple<Cases&...> cases) : waiter_(waiter), cases_(cases) {
+    std::apply([this](auto&... arm) { (SelectAccess::add(arm.channel, &waiter_), ...); }, cases_);
+  }
+  ~SelectRegistration() {
+    std::apply([this](auto&... arm) { (SelectAccess::remove(arm.channel, &waiter_), ...); }, cases_);
+  }
+  SelectRegistration(const SelectRegistration&) = delete;
+  SelectRegistration& operator=(const SelectRegistration&) = delete;
+
+ private:
+  SelectWaiter& waiter_;
+  std::tuple<Cases&...> cases_;
+};
+
+enum class Attempt { Fired, Empty, Drained };
+
+template <typename T, typename Handler>
+Attempt attempt(ReceiveCase<T, Handler>& arm) {
+  if (std::optional<T> value = arm.channel.tryReceive()) {
+    arm.handler(std::move(*value));
+    return Attempt::Fired;
+  }
+  return arm.channel.drained() ? Attempt::Drained : Attempt::Empty;
+}
+
+// Rotates the first arm tried on each call so a busy channel cannot starve the ones listed after it
+inline std::size_t nextSelectStart() {
+  thread_local std::size_t counter = 0;
+  return counter++;
+}
+
+}  // namespace detail
+
+// Waits until one of the arms has a value and runs exactly that arm's handler (on the calling thread, with no channel
+// lock held). Returns the index of the arm that fired, or nullopt when stop was requested or every channel is closed
+// and drained. When several arms are ready the one tried first wins; the starting arm rotates between calls.
+template <typename... Cases>
+std::optional<std::size_t> select(std::stop_token token, Cases... arms) {
+  static_assert(sizeof...(Cases) > 0, "select needs at least one arm");
+  constexpr std::size_t kArms = sizeof...(Cases);
+  auto cases = std::forward_as_tuple(arms...);
+  const std::size_t start = detail::nextSelectStart();
+
+  // One pass over the arms: Fired (with `fired` set), Drained if every channel is done, Empty otherwise
+  std::size_t fired = 0;
+  auto tryAll = [&] {
+    std::size_t drained = 0;
+    for (std::size_t step = 0; step < kArms; ++step) {
+      const std::size_t idx = (start + step) % kArms;
+      detail::Attempt outcome = detail::Attempt::Empty;
+      [&]<std::size_t... I>(std::index_sequence<I...>) {
+        ((I == idx ? (outcome = detail::attempt(std::get<I>(cases))) : outcome), ...);
+      }(std::index_sequence_for<Cases...>{});
+      if (outcome == detail::Attempt::Fired) {
+        fired = idx;
+        return detail::Attempt::Fired;
+      }
+      drained += outcome == detail::Attempt::Drained ? 1 : 0;
+    }
+    return drained == kArms ? detail::Attempt::Drained : detail::Attempt::Empty;
+  };
+
+  // Fast path: something is already buffered
+  if (token.stop_requested()) {
+    return std::nullopt;
+  }
+  if (const auto outcome = tryAll(); outcome != detail::Attempt::Empty) {
+    return outcome == detail::Attempt::Fired ? std::optional<std::size_t>(fired) : std::nullopt;
+  }
+
+  // Park on every channel, then re-check before sleeping: a send between the fast path and registration would
+  // otherwise go unnoticed. Each wakeup clears the flag before looking again, for the same reason.
+  detail::SelectWaiter waiter;
+  const detail::SelectRegistration<Cases...> registration(waiter, cases);
+  std::optional<std::size_t> result;
+  while (true) {
+    {
+      std::lock_guard<std::mutex> lock(waiter.mutex);
+      waiter.signalled = false;
+    }
+    if (const auto outcome = tryAll(); outcome != detail::Attempt::Empty) {
+      if (outcome == detail::Attempt::Fired) {
+        result = fired;
+      }
+      break;
+    }
+    std::unique_lock<std::mutex> lock(waiter.mutex);
+    if (!waiter.condition.wait(lock, token, [&waiter] { return waiter.signalled; })) {
+      break;
+    }
+  }
+  return result;
+}
+
+// Timer as a channel: delivers the current time every `period` on a one-slot channel, dropping ticks while the
+// previous one is still unread (so a slow reader sees the latest tick, not a backlog). Stops on destruction.
+class Ticker {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+ private:
+  Channel<Clock::time_point> channel_{1};
+  std::jthread thread_;  // declared last: stops before the channel goes away
+
+ public:
+  explicit Ticker(Clock::duration period)
+      : thread_([this, period](std::stop_token token) {
+          std::mutex mutex;
+          std::condition_variable_any sleeper;
+          auto next = Clock::now() + period;
+          std::unique_lock<std::mutex> lock(mutex);
+          while (!sleeper.wait_until(lock, token, next, [] { return false; })) {
+            if (token.stop_requested()) {
+              break;
+            }
+            channel_.trySend(Clock::now());
+            next += period;
+          }
+          channel_.close();
+        }) {}
+
+  Channel<Clock::time_point>& channel() { return channel_; }
+};
+
+}  // namespace channels
+
+#endif  // CHANNEL_H
@@ -0,0 +1,226 @@
+#ifndef CONTENTION_COUNTERS_H
+#define CONTENTION_COUNTERS_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+// Compile-time-optional contention counters for the lock-free containers.
+//
+// Build with -DLOCKFREE_CONTENTION_COUNTERS=1 to enable. Each thread counts into its own cache-line-aligned block
+// (plain load + store on relaxed atomics, no RMW, no sharing), so the counters barely disturb what they measure.
+// snapshot() sums all live threads plus whatever exited threads left behind. When disabled, record() is an empty
+// inline function behind `if constexpr` and nothing, not even the thread_local, is emitted.
+#ifndef LOCKFREE_CONTENTION_COUNTERS
+#define LOCKFREE_CONTENTION_COUNTERS 0
+#endif
+
+namespace contention {
+
+inline constexpr bool kEnabled = LOCKFREE_CONTENTION_COUNTERS != 0;
+
+enum class Event : std::size_t {
+  StackPushCas,
+  StackPushCasFailed,
+  StackPopCas,
+  StackPopCasFailed,
+  FreeListCas,  // NodePoolReclamation's free list
+  FreeListCasFailed,
+  QueueEnqueueCas,
+  QueueEnqueueCasFailed,
+  QueueDequeueCas,
+  QueueDequeueCasFailed,
+  QueueTailHelpCas,  // CAS on tail_ on behalf of another thread's enqueue
+  NodesRetired,
+  RetireListLength,  // summed over retires: average length = RetireListLength / NodesRetired
+  ReclamationScans,
+  ReclamationScanLength,  // entries inspected over all scans
+  PoolQueueLocks,
+  PoolQueueLocksContended,
+  Count
+};
+
+inline constexpr std::size_t kEventCount = static_cast<std::size_t>(Event::Count);
+
+inline constexpr std::array<std::string_view, kEventCount> kEventNames{
+    "stack.push.cas",
+    "stack.push.cas_failed",
+    "stack.pop.cas",
+    "stack.pop.cas_failed",
+    "freelist.cas",
+    "freelist.cas_failed",
+    "queue.enqueue.cas",
+    "queue.enqueue.cas_failed",
+    "queue.dequeue.cas",
+    "queue.dequeue.cas_failed",
+    "queue.tail_help.cas",
+    "reclaim.retired",
+    "reclaim.retire_list_length",
+    "reclaim.scans",
+    "reclaim.scan_length",
+    "pool.queue.locks",
+    "pool.queue.locks_contended",
+};
+
+struct Snapshot {
+  std::array<std::uint64_t, kEventCount> values{};
+
+  std::uint64_t operator[](Event event) const { return values[static_cast<std::size_t>(event)]; }
+
+  Snapshot operator-(const Snapshot& earlier) const {
+    Snapshot delta;
+    for (std::size_t idx = 0; idx < kEventCount; ++idx) {
+      delta.values[idx] = values[idx] - earlier.values[idx];
+    }
+    return delta;
+  }
+
+  // Failed / attempted, 0 when nothing was attempted
+  double failureRate(Event attempts, Event failures) const {
+    const auto tried = (*this)[attempts];
+    return tried == 0 ? 0.0 : static_cast<double>((*this)[failures]) / static_cast<double>(tried);
+  }
+
+  // Non-zero counters, one per line
+  void print(std::ostream& out, std::string_view indent = "  ") const {
+    for (std::size_t idx = 0; idx < kEventCount; ++idx) {
+      if (values[idx] != 0) {
+        out << indent << kEventNames[idx] << ": " << values[idx] << '\n';
+      }
+    }
+  }
+};
+
+namespace detail {
+
+struct alignas(64) ThreadCounters {
+  std::array<std::atomic<std::uint64_t>, kEventCount> values{};
+};
+
+class Registry {
+ private:
+  std::mutex mutex_;
+  std::vector<const ThreadCounters*> live_;
+  Snapshot exited_;
+
+ public:
+  static Registry& instance() {
+    static Registry registry;
+    return registry;
+  }
+
+  void add(const ThreadCounters* counters) {
+    std::lock_guard lock(mutex_);
+    live_.push_back(counters);
+  }
+
+  void remove(const ThreadCounters* counters) {
+    std::lock_guard lock(mutex_);
+    for (std::size_t idx = 0; idx < kEventCount; ++idx) {
+      exited_.values[idx] += counters->values[idx].load(std::memory_order_relaxed);
+    }
+    std::erase(live_, counters);
+  }
+
+  Snapshot sum() {
+    std::lock_guard lock(mutex_);
+    Snapshot total = exited_;
+    for (const auto* counters : live_) {
+      for (std::size_t idx = 0; idx < kEventCount; ++idx) {
+        total.values[idx] += counters->values[idx].load(std::memory_order_relaxed);
+      }
+    }
+    return total;
+  }
+};
+
+// Registers on first use in a thread, folds its totals into the registry when the thread exits
+class ThreadSlot {
+ private:
+  ThreadCounters counters_;
+
+ public:
+  ThreadSlot() { Registry::instance().add(&counters_); }
+  ~ThreadSlot() { Registry::instance().remove(&counters_); }
+  ThreadSlot(const ThreadSlot&) = delete;
+  ThreadSlot& operator=(const ThreadSlot&) = delete;
+
+  ThreadCounters& counters() { return counters_; }
+};
+
+inline ThreadCounters& local() {
+  thread_local ThreadSlot slot;
+  return slot.counters();
+}
+
+}  // namespace detail
+
+inline void record([[maybe_unused]] Event event, [[maybe_unused]] std::uint64_t amount = 1) {
+  if constexpr (kEnabled) {
+    auto& value = detail::local().values[static_cast<std::size_t>(event)];
+    value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+  }
+}
+
+// Counts one CAS attempt and, if `succeeded` is false, one failure; returns `succeeded` so calls can wrap a CAS
+inline bool recordCas([[maybe_unused]] Event attempt, [[maybe_unused]] Event failure, bool succeeded) {
+  if constexpr (kEnabled) {
+    record(attempt);
+    if (!succeeded) {
+      record(failure);
+    }
+  }
+  return succeeded;
+}
+
+// Locks `mutex`, counting the acquisition and whether it had to wait
+template <typename Mutex>
+std::unique_lock<Mutex> lock(Mutex& mutex, [[maybe_unused]] Event acquired, [[maybe_unused]] Event contended) {
+  if constexpr (kEnabled) {
+    record(acquired);
+    std::unique_lock<Mutex> guard(mutex, std::try_to_lock);
+    if (!guard.owns_lock()) {
+      record(contended);
+      guard.lock();
+    }
+    return guard;
+  } else {
+    return std::unique_lock<Mutex>(mutex);
+  }
+}
+
+// Length of a retire list, tracked only when counting: every retire records the length it produced. Disabled, it is an
+// empty member (use with [[no_unique_address]]).
+template <bool Enabled = kEnabled>
+class RetireListLength {
+ private:
+  std::atomic<std::size_t> length_{0};
+
+ public:
+  void retired() { record(Event::RetireListLength, length_.fetch_add(1, std::memory_order_relaxed) + 1); }
+  void reused(std::size_t count = 1) { length_.fetch_sub(count, std::memory_order_relaxed); }
+};
+
+template <>
+class RetireListLength<false> {
+ public:
+  void retired() {}
+  void reused(std::size_t = 1) {}
+};
+
+inline Snapshot snapshot() {
+  if constexpr (kEnabled) {
+    return detail::Registry::instance().sum();
+  } else {
+    return {};
+  }
+}
+
+}  // namespace contention
+
+#endif  // CONTENTION_COUNTERS_H
@@ -0,0 +1,280 @@
+#ifndef CORRELATION_MATRIX_H
+#define CORRELATION_MATRIX_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <latch>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "DynamicThreadPool.h"
+
+// Rolling Pearson correlation across symbols over the last `window` return samples.
+//
+// Instead of rebuilding from history (O(S^2 * W)), the engine keeps sufficient statistics (sum, sum of squares and
+// the cross-product matrix) and updates them per sample. Samples are sparse: a symbol that did not tick contributes a
+// zero return, so a commit only touches the rows/columns of symbols present in the new and the evicted sample
+// (O(k^2) for k ticked symbols). Matrices are row-major with rows padded to a cache line and 64-byte aligned so the
+// inner loops vectorise; full refreshes are tiled and can be spread across a thread pool.
+//
+// Dirty-row refreshes are exact once the window is full; during warm-up every moment shifts, so use a full refresh:
+// refreshAll fans it out to a pool and blocks, startRefresh/refreshStep spread it over calls one row band at a time.
+// Single writer: addReturn/commitSample/refresh* must be called from one thread, one return per symbol per sample.
+class CorrelationMatrix {
+ public:
+  static constexpr std::size_t kTile = 64;
+
+ private:
+  static constexpr std::size_t kLaneDoubles = 64 / sizeof(double);
+
+  struct AlignedDeleter {
+    void operator()(double* ptr) const { ::operator delete[](ptr, std::align_val_t{64}); }
+  };
+  using AlignedArray = std::unique_ptr<double[], AlignedDeleter>;
+
+  static AlignedArray makeAligned(std::size_t count) {
+    auto* raw = static_cast<double*>(::operator new[](count * sizeof(double), std::align_val_t{64}));
+    std::fill_n(raw, count, 0.0);
+    return AlignedArray(raw);
+  }
+
+  struct Entry {
+    std::uint32_t symbolId;
+    double value;
+  };
+
+  std::size_t symbols_;
+  std::size_t stride_;  // row length rounded up to a cache line
+  std::size_t window_;
+
+  AlignedArray sum_;
+  AlignedArray sumSq_;
+  AlignedArray cross_;        // symbols_ x stride_, sum of r_i * r_j over the window
+  AlignedArray correlation_;  // symbols_ x stride_
+  AlignedArray mean_;         // refreshed per pass
+  AlignedArray invStd_;       // 0 for symbols with no variance
+
+  // Ring of sparse samples; inner vectors keep their capacity so steady state does not allocate
+  std::vector<std::vector<Entry>> samples_;
+  std::size_t head_{0};
+  std::size_t count_{0};
+  std::vector<Entry> pending_;
+
+  std::vector<std::uint8_t> dirty_;
+  std::vector<std::uint32_t> dirtyList_;
+  std::uint64_t commits_{0};
+  std::size_t nextBand_{0};  // next row band of the full refresh in progress
+  bool refreshing_{false};
+
+  void markDirty(std::uint32_t id) {
+    if (!dirty_[id]) {
+      dirty_[id] = 1;
+      dirtyList_.push_back(id);
+    }
+  }
+
+  void accumulate(const std::vector<Entry>& sample, double sign) {
+    for (const Entry& a : sample) {
+      sum_[a.symbolId] += sign * a.value;
+      sumSq_[a.symbolId] += sign * a.value * a.value;
+      double* row = cross_.get() + a.symbolId * stride_;
+      const double scaled = sign * a.value;
+      for (const Entry& b : sample) {
+        row[b.symbolId] += scaled * b.value;
+      }
+      markDirty(a.symbolId);
+    }
+  }
+
+  // Cancellation drift from add/subtract builds up over long runs; rebuild exactly once per window
+  void rebuildFromWindow() {
+    std::fill_n(sum_.get(), symbols_, 0.0);
+    std::fill_n(sumSq_.get(), symbols_, 0.0);
+    std::fill_n(cross_.get(), symbols_ * stride_, 0.0);
+    for (std::size_t idx = 0; idx < count_; ++idx) {
+      accumulate(samples_[idx], 1.0);
+    }
+  }
+
+  void refreshMoments() {
+    const double n = static_cast<double>(std::max<std::size_t>(count_, 1));
+    for (std::size_t id = 0; id < symbols_; ++id) {
+      const double mean = sum_[id] / n;
+      const double variance = sumSq_[id] / n - mean * mean;
+      mean_[id] = mean;
+      invStd_[id] = variance > 1e-18 ? 1.0 / std::sqrt(variance) : 0.0;
+    }
+  }
+
+  // corr(i, j) for j in [begin, end): a pure streaming loop over contiguous arrays
+  void refreshRowSpan(std::size_t row, std::size_t begin, std::size_t end) {
+    const double invN = 1.0 / static_cast<double>(std::max<std::size_t>(count_, 1));
+    const double* __restrict crossRow = cross_.get() + row * stride_;
+    const double* __restrict mean = mean_.get();
+    const double* __restrict invStd = invStd_.get();
+    double* __restrict out = correlation_.get() + row * stride_;
+    const double meanI = mean[row];
+    const double invStdI = invStd[row];
+
+    for (std::size_t col = begin; col < end; ++col) {
+      out[col] = (crossRow[col] * invN - meanI * mean[col]) * invStdI * invStd[col];
+    }
+  }
+
+  void refreshTile(std::size_t rowBegin, std::size_t rowEnd, std::size_t colBegin, std::size_t colEnd) {
+    for (std::size_t row = rowBegin; row < rowEnd; ++row) {
+      refreshRowSpan(row, colBegin, colEnd);
+    }
+  }
+
+  void refreshBand(std::size_t band) {
+    const std::size_t rowBegin = band * kTile;
+    const std::size_t rowEnd = std::min(rowBegin + kTile, symbols_);
+    for (std::size_t colBegin = 0; colBegin < symbols_; colBegin += kTile) {
+      refreshTile(rowBegin, rowEnd, colBegin, std::min(colBegin + kTile, symbols_));
+    }
+  }
+
+  void clearDirty() {
+    for (const std::uint32_t row : dirtyList_) {
+      dirty_[row] = 0;
+    }
+    dirtyList_.clear();
+  }
+
+ public:
+  CorrelationMatrix(std::size_t symbols, std::size_t window)
+      : symbols_(symbols),
+        stride_((symbols + kLaneDoubles - 1) / kLaneDoubles * kLaneDoubles),
+        window_(window),
+        sum_(makeAligned(stride_)),
+        sumSq_(makeAligned(stride_)),
+        cross_(makeAligned(symbols_ * stride_)),
+        correlation_(makeAligned(symbols_ * stride_)),
+        mean_(makeAligned(stride_)),
+        invStd_(makeAligned(stride_)),
+        samples_(window),
+        dirty_(symbols, 0) {
+    if (symbols_ == 0 || window_ < 2) {
+      throw std::invalid_argument("CorrelationMatrix: need at least one symbol and a window of 2+ samples");
+    }
+    for (auto& sample : samples_) {
+      sample.reserve(std::min<std::size_t>(symbols_, 256));
+    }
+    pending_.reserve(symbols_);
+    dirtyList_.reserve(symbols_);
+  }
+
+  // Stage a return for the sample being built; symbols left out contribute 0
+  void addReturn(std::size_t symbolId, double value) {
+    if (symbolId < symbols_) {
+      pending_.push_back(Entry{static_cast<std::uint32_t>(symbolId), value});
+    }
+  }
+
+  // Slide the window by one sample, updating only the rows touched by the new and the evicted sample
+  void commitSample() {
+    auto& slot = samples_[head_];
+    if (count_ == window_) {
+      accumulate(slot, -1.0);
+    } else {
+      ++count_;
+    }
+
+    slot.swap(pending_);
+    pending_.clear();
+    accumulate(slot, 1.0);
+    head_ = (head_ + 1) % window_;
+
+    if (++commits_ % window_ == 0) {
+      rebuildFromWindow();
+    }
+  }
+
+  // Recompute rows (and mirrored columns) of symbols touched since the last refresh: O(k * S)
+  std::size_t refreshDirtyRows() {
+    refreshMoments();
+    for (const std::uint32_t row : dirtyList_) {
+      refreshRowSpan(row, 0, symbols_);
+      const double* rowData = correlation_.get() + row * stride_;
+      for (std::size_t col = 0; col < symbols_; ++col) {
+        correlation_[col * stride_ + row] = rowData[col];
+      }
+      dirty_[row] = 0;
+    }
+    const std::size_t refreshed = dirtyList_.size();
+    dirtyList_.clear();
+    return refreshed;
+  }
+
+  // Full O(S^2) refresh in kTile x kTile blocks; one pool task per row band, caller blocks until done. Any
+  // BasicDynamicThreadPool works; under EarliestDeadlineFirst the bands get the pool's default NORMAL deadline.
+  template <typename Pool>
+  void refreshAll(Pool& pool) {
+    refreshMoments();
+    const std::size_t bands = (symbols_ + kTile - 1) / kTile;
+    std::latch done(static_cast<std::ptrdiff_t>(bands));
+
+    for (std::size_t band = 0; band < bands; ++band) {
+      pool.submit(
+          [this, band, &done]() {
+            refreshBand(band);
+            done.count_down();
+          },
+          TaskPriority::NORMAL, "correlation-band-" + std::to_string(band));
+    }
+
+    done.wait();
+    clearDirty();
+    refreshing_ = false;
+  }
+
+  // Begin a full refresh on the calling thread, restarting any pass in progress; the moments are taken now, so call
+  // this again after the next commitSample
+  void startRefresh() {
+    refreshMoments();
+    clearDirty();
+    nextBand_ = 0;
+    refreshing_ = true;
+  }
+
+  // Refresh the next kTile-row band of the pass begun by startRefresh: O(kTile * S). True once no pass is pending.
+  bool refreshStep() {
+    if (!refreshing_) {
+      return true;
+    }
+    refreshBand(nextBand_);
+    refreshing_ = ++nextBand_ * kTile < symbols_;
+    return !refreshing_;
+  }
+
+  bool refreshing() const { return refreshing_; }
+
+  // Last refreshed value
+  double correlation(std::size_t i, std::size_t j) const { return correlation_[i * stride_ + j]; }
+
+  // Straight from the sufficient statistics, independent of refreshes
+  double computeCorrelation(std::size_t i, std::size_t j) const {
+    const double n = static_cast<double>(std::max<std::size_t>(count_, 1));
+    const double covariance = cross_[i * stride_ + j] / n - (sum_[i] / n) * (sum_[j] / n);
+    const double varI = sumSq_[i] / n - (sum_[i] / n) * (sum_[i] / n);
+    const double varJ = sumSq_[j] / n - (sum_[j] / n) * (sum_[j] / n);
+    if (varI <= 1e-18 || varJ <= 1e-18) {
+      return 0.0;
+    }
+    return covariance / std::sqrt(varI * varJ);
+  }
+
+  std::size_t symbols() const { return symbols_; }
+
+  std::size_t samples() const { return count_; }
+
+  std::size_t window() const { return window_; }
+};
+
+#endif  // CORRELATION_MATRIX_H
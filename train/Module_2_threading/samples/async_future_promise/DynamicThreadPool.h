@@ -1,15 +1,20 @@
 #ifndef DYNAMIC_THREAD_POOL_H
 #define DYNAMIC_THREAD_POOL_H
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <functional>
+#include <iostream>
 #include <mutex>
-#include <queue>
+#include <string>
 #include <thread>
 #include <type_traits>
+#include <vector>
 
+#include "ContentionCounters.h"
+#include "SchedulingPolicy.h"
 #include "logging.h"
 
 enum class TaskPriority { LOW = 1, NORMAL = 2, HIGH = 3, CRITICAL = 4 };
@@ -25,25 +30,34 @@ struct Task {
   std::function<void()> function;
   TaskPriority priority;
   std::chrono::steady_clock::time_point submitTime;
+  std::chrono::steady_clock::time_point deadline;
   std::string taskId;
 
-  Task(std::function<void()> func, TaskPriority prio, const std::string& id = "")
-      : function(std::move(func)), priority(prio), submitTime(std::chrono::steady_clock::now()), taskId(id) {}
-};
+  Task(std::function<void()> func, TaskPriority prio, std::chrono::steady_clock::time_point due,
+       const std::string& id = "")
+      : function(std::move(func)),
+        priority(prio),
+        submitTime(std::chrono::steady_clock::now()),
+        deadline(due),
+        taskId(id) {}
 
-struct TaskComparator {
-  bool operator()(const Task& a, const Task& b) const {
-    if (a.priority != b.priority) {
-      return static_cast<int>(a.priority) < static_cast<int>(b.priority);
-    }
-    return a.submitTime > b.submitTime;  // Earlier submission has higher priority
+  // Deadline from the class's default budget
+  Task(std::function<void()> func, TaskPriority prio, const std::string& id = "")
+      : Task(std::move(func), prio, {}, id) {
+    deadline = scheduling::defaultDeadline(priorityClass(), submitTime);
   }
+
+  std::size_t priorityClass() const { return static_cast<std::size_t>(get_val(priority)) - 1; }
 };
 
-class DynamicThreadPool {
+// Policy orders the queued tasks (see SchedulingPolicy.h); DynamicThreadPool is the strict-priority pool
+template <typename Policy = scheduling::StrictPriority>
+class BasicDynamicThreadPool {
  private:
+  // Any submitting thread may grow the pool, pool workers included (actors reschedule themselves)
+  std::mutex workersMutex_;
   std::vector<std::thread> workers_;
-  std::priority_queue<Task, std::vector<Task>, TaskComparator> taskQueue_;
+  scheduling::ClassQueues<Task, Policy> taskQueue_;
 
   mutable std::mutex queueMutex_;
   std::condition_variable condition_;
@@ -51,6 +65,9 @@ class DynamicThreadPool {
   std::atomic<bool> shutdown_{false};
   std::atomic<size_t> activeThreads_{0};
   std::atomic<size_t> totalTasksProcessed_{0};
+  std::atomic<size_t> deadlineMisses_{0};  // tasks that finished after their deadline
+  std::array<std::atomic<size_t>, scheduling::kClasses> dispatchedByClass_{};
+  std::array<std::atomic<size_t>, scheduling::kClasses> missesByClass_{};
 
   // Dynamic scaling parameters
   std::atomic<size_t> minThreads_;
@@ -63,13 +80,18 @@ class DynamicThreadPool {
 
   std::chrono::steady_clock::time_point t0;
 
+  // Per-task trace lines; fine-grained submitters such as actor turns switch them off
+  std::atomic<bool> traceTasks_{true};
+
+  // Leaves only once shutdown is requested and the queue is empty, so shutdown() drains every queued task
   void workerThread() {
-    while (!shutdown_.load()) {
+    while (true) {
       Task task([]() {}, TaskPriority::LOW);
       bool hasTask = false;
 
       {
-        std::unique_lock<std::mutex> lock(queueMutex_);
+        auto lock = contention::lock(queueMutex_, contention::Event::PoolQueueLocks,
+                                     contention::Event::PoolQueueLocksContended);
 
         condition_.wait(lock, [this] { return !taskQueue_.empty() || shutdown_.load(); });
 
@@ -78,8 +100,7 @@ class DynamicThreadPool {
         }
 
         if (!taskQueue_.empty()) {
-          task = std::move(const_cast<Task&>(taskQueue_.top()));
-          taskQueue_.pop();
+          task = taskQueue_.take(taskQueue_.next());
           hasTask = true;
         }
       }
@@ -90,9 +111,12 @@ class DynamicThreadPool {
         auto startTime = std::chrono::steady_clock::now();
 
         try {
-          auto submit_offset = std::chrono::duration_cast<std::chrono::microseconds>(task.submitTime - t0).count();
-          logSync(std::cout, " processing task (", std::to_string(get_val(task.priority)), ") : ", task.taskId,
-                  "\t task order by time: ", std::to_string(submit_offset), "\n");
+          if (traceTasks_.load(std::memory_order_relaxed)) {
+            auto submit_offset =
+                std::chrono::duration_cast<std::chrono::microseconds>(task.submitTime - t0).count();
+            logSync(std::cout, " processing task (", std::to_string(get_val(task.priority)), ") : ", task.taskId,
+                    "\t task order by time: ", std::to_string(submit_offset), "\n");
+          }
           task.function();
         } catch (const std::exception& e) {
           std::cout << "Task " << task.taskId << " failed: " << e.what() << std::endl;
@@ -104,6 +128,11 @@ class DynamicThreadPool {
         auto duration = std::chrono::duration<double, std::milli>(endTime - startTime);
 
         updatePerformanceMetrics(duration.count());
+        dispatchedByClass_[task.priorityClass()].fetch_add(1, std::memory_order_relaxed);
+        if (endTime > task.deadline) {
+          deadlineMisses_.fetch_add(1, std::memory_order_relaxed);
+          missesByClass_[task.priorityClass()].fetch_add(1, std::memory_order_relaxed);
+        }
 
         totalTasksProcessed_.fetch_add(1);
         activeThreads_.fetch_sub(1);
@@ -131,9 +160,13 @@ class DynamicThreadPool {
       queueHighWaterMark_.store(queueSize);
     }
 
-    // Scale up if queue is growing and we have capacity
+    // Scale up if queue is growing and we have capacity; the check is repeated under the lock so concurrent
+    // submitters cannot both add the last allowed thread
     if (queueSize > current * 2 && current < maxThreads_.load()) {
-      addWorkerThread();
+      std::lock_guard<std::mutex> lock(workersMutex_);
+      if (!shutdown_.load() && queueSize > currentThreads_.load() * 2 && currentThreads_.load() < maxThreads_.load()) {
+        addWorkerThread();
+      }
     }
 
     // Scale down if threads are mostly idle (simplified logic)
@@ -143,18 +176,38 @@ class DynamicThreadPool {
     }
   }
 
+  // Caller holds workersMutex_
   void addWorkerThread() {
-    workers_.emplace_back(&DynamicThreadPool::workerThread, this);
+    workers_.emplace_back(&BasicDynamicThreadPool::workerThread, this);
     currentThreads_.fetch_add(1);
     std::cout << "Scaled up to " << currentThreads_.load() << " threads" << std::endl;
   }
 
+  void enqueue(Task task) {
+    {
+      const auto lock = contention::lock(queueMutex_, contention::Event::PoolQueueLocks,
+                                         contention::Event::PoolQueueLocksContended);
+      const std::size_t priorityClass = task.priorityClass();
+      const auto deadline = task.deadline;
+      taskQueue_.push(priorityClass, deadline, std::move(task));
+    }
+
+    condition_.notify_one();
+
+    // Trigger scaling evaluation
+    scaleThreadPool();
+  }
+
  public:
-  DynamicThreadPool(size_t minThreads = 2, size_t maxThreads = std::thread::hardware_concurrency() * 2)
-      : minThreads_(minThreads), maxThreads_(maxThreads) {
+  BasicDynamicThreadPool(size_t minThreads = 2, size_t maxThreads = std::thread::hardware_concurrency() * 2,
+                         Policy policy = Policy{})
+      : taskQueue_(std::move(policy)), minThreads_(minThreads), maxThreads_(maxThreads) {
     // Start with minimum threads
-    for (size_t i = 0; i < minThreads; ++i) {
-      addWorkerThread();
+    {
+      std::lock_guard<std::mutex> lock(workersMutex_);
+      for (size_t i = 0; i < minThreads; ++i) {
+        addWorkerThread();
+      }
     }
 
     std::cout << "Dynamic thread pool initialized with " << minThreads << " threads (max: " << maxThreads << ")"
@@ -162,21 +215,29 @@ class DynamicThreadPool {
     this->t0 = std::chrono::steady_clock::now();
   }
 
-  ~DynamicThreadPool() { shutdown(); }
+  ~BasicDynamicThreadPool() { shutdown(); }
 
   template <typename Func>
   void submit(Func&& func, TaskPriority priority = TaskPriority::NORMAL, const std::string& taskId = "") {
-    {
-      std::lock_guard<std::mutex> lock(queueMutex_);
-      taskQueue_.emplace(std::forward<Func>(func), priority, taskId);
-    }
+    enqueue(Task(std::forward<Func>(func), priority, taskId));
+  }
 
-    condition_.notify_one();
+  // The deadline orders the task under EarliestDeadlineFirst; every policy counts it as missed if it finishes later
+  template <typename Func>
+  void submitWithDeadline(Func&& func, TaskPriority priority, std::chrono::steady_clock::time_point deadline,
+                          const std::string& taskId = "") {
+    enqueue(Task(std::forward<Func>(func), priority, deadline, taskId));
+  }
 
-    // Trigger scaling evaluation
-    scaleThreadPool();
+  // For tasks that run as long as the pool (ingest loops and the like): no deadline, so they never count as misses.
+  // Under EarliestDeadlineFirst they queue behind every deadline-bearing task, so submit them while the pool is idle.
+  template <typename Func>
+  void submitService(Func&& func, TaskPriority priority, const std::string& taskId = "") {
+    enqueue(Task(std::forward<Func>(func), priority, std::chrono::steady_clock::time_point::max(), taskId));
   }
 
+  void setTaskTracing(bool enabled) { traceTasks_.store(enabled, std::memory_order_relaxed); }
+
   size_t getQueueSize() const {
     std::lock_guard<std::mutex> lock(queueMutex_);
     return taskQueue_.size();
@@ -189,24 +250,45 @@ class DynamicThreadPool {
     size_t totalTasksProcessed;
     double averageTaskTime;
     size_t queueHighWaterMark;
+    size_t deadlineMisses;
+    std::array<size_t, scheduling::kClasses> dispatchedByClass;  // indexed LOW..CRITICAL
+    std::array<size_t, scheduling::kClasses> missesByClass;
   };
 
   PoolStats getStats() const {
-    return PoolStats{currentThreads_.load(),      activeThreads_.load(),   getQueueSize(),
-                     totalTasksProcessed_.load(), averageTaskTime_.load(), queueHighWaterMark_.load()};
+    PoolStats stats{currentThreads_.load(),      activeThreads_.load(),   getQueueSize(),
+                    totalTasksProcessed_.load(), averageTaskTime_.load(), queueHighWaterMark_.load(),
+                    deadlineMisses_.load(),      {},                      {}};
+    for (std::size_t cls = 0; cls < scheduling::kClasses; ++cls) {
+      stats.dispatchedByClass[cls] = dispatchedByClass_[cls].load(std::memory_order_relaxed);
+      stats.missesByClass[cls] = missesByClass_[cls].load(std::memory_order_relaxed);
+    }
+    return stats;
   }
 
+  // Runs every queued task, then joins the workers; only the first call does anything
   void shutdown() {
-    shutdown_.store(true);
+    {
+      // Under the queue lock, so a worker between checking the wait predicate and sleeping cannot miss the wakeup
+      std::lock_guard<std::mutex> lock(queueMutex_);
+      if (shutdown_.exchange(true)) {
+        return;
+      }
+    }
     condition_.notify_all();
 
-    for (auto& worker : workers_) {
+    // Join outside the lock: a worker still draining the queue may submit, and submitting can take it
+    std::vector<std::thread> workers;
+    {
+      std::lock_guard<std::mutex> lock(workersMutex_);
+      workers.swap(workers_);
+    }
+    for (auto& worker : workers) {
       if (worker.joinable()) {
         worker.join();
       }
     }
 
-    workers_.clear();
     std::cout << "Thread pool shutdown completed" << std::endl;
   }
 
@@ -219,7 +301,21 @@ class DynamicThreadPool {
               << std::endl;
     std::cout << "Average task time: " << stats.averageTaskTime << " ms" << std::endl;
     std::cout << "Queue high water mark: " << stats.queueHighWaterMark << std::endl;
+    std::cout << "Scheduling policy: " << Policy::kName << " | \t Deadline misses: " << stats.deadlineMisses
+              << std::endl;
+    // Share of dispatches per class shows what the policy actually gave each class, misses what it cost
+    static constexpr const char* kClassNames[] = {"LOW", "NORMAL", "HIGH", "CRITICAL"};
+    std::cout << "Per class (dispatched / share / missed):";
+    for (std::size_t cls = 0; cls < scheduling::kClasses; ++cls) {
+      const size_t dispatched = stats.dispatchedByClass[cls];
+      const double share =
+          stats.totalTasksProcessed == 0 ? 0.0 : 100.0 * dispatched / static_cast<double>(stats.totalTasksProcessed);
+      std::cout << " " << kClassNames[cls] << " " << dispatched << " / " << share << "% / " << stats.missesByClass[cls];
+    }
+    std::cout << std::endl;
   }
 };
 
+using DynamicThreadPool = BasicDynamicThreadPool<>;
+
 #endif // DYNAMIC_THREAD_POOL_H
\ No newline at end of file
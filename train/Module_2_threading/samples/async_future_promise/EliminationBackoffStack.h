@@ -0,0 +1,217 @@
+#ifndef ELIMINATION_BACKOFF_STACK_H
+#define ELIMINATION_BACKOFF_STACK_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+#include "LockFreeStack.h"
+
+namespace lockfree {
+
+// LockFreeStack with an elimination-backoff layer (Hendler, Shavit & Yerushalmi).
+//
+// Every operation first tries one CAS on the shared head. If it loses the race, instead of retrying on the same
+// contended cache line it backs off into a randomly chosen slot of an elimination array: a push parks its node there
+// for a short while, and a pop that visits the slot takes the node directly. A push and a pop that meet this way
+// cancel out without touching the head at all; otherwise both go back to the head.
+//
+// Slots are tagged words like the head, so a push withdraws its offer by CAS and can never withdraw a node
+// that was taken and recycled in between. The number of slots in use adapts: offers that time out shrink the range
+// (too few partners, spread is wasted), offers that find their slot busy grow it (too many threads per slot).
+template <typename T, template <typename> class Reclamation = NodePoolReclamation, std::size_t Slots = 16>
+class EliminationBackoffStack {
+ private:
+  struct Node {
+    std::atomic<Node*> next{nullptr};
+    std::optional<T> value;
+  };
+
+  using Head = detail::TaggedHead<Node>;
+
+  struct alignas(64) Slot {
+    Head offer;
+  };
+
+  static constexpr int kOfferSpins = 128;
+  static constexpr int kTakeSpins = 16;
+
+  Reclamation<Node> reclamation_;
+  alignas(64) Head head_;
+  alignas(64) std::atomic<std::size_t> size_{0};
+  std::atomic<std::size_t> activeSlots_{1};
+  std::array<Slot, Slots> slots_;
+
+  std::atomic<std::uint64_t> eliminated_{0};
+
+  static std::size_t randomIndex(std::size_t range) {
+    thread_local std::uint32_t state = static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(&state)) | 1u;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state % range;
+  }
+
+  void shrinkRange() {
+    std::size_t current = activeSlots_.load(std::memory_order_relaxed);
+    if (current > 1) {
+      activeSlots_.compare_exchange_weak(current, current - 1, std::memory_order_relaxed);
+    }
+  }
+
+  void growRange() {
+    std::size_t current = activeSlots_.load(std::memory_order_relaxed);
+    if (current < Slots) {
+      activeSlots_.compare_exchange_weak(current, current + 1, std::memory_order_relaxed);
+    }
+  }
+
+  Slot& pickSlot() { return slots_[randomIndex(activeSlots_.load(std::memory_order_relaxed))]; }
+
+  bool tryPushOnce(Node* node) {
+    std::uint64_t current = head_.load(std::memory_order_relaxed);
+    node->next.store(Head::pointer(current), std::memory_order_relaxed);
+    return contention::recordCas(
+        contention::Event::StackPushCas, contention::Event::StackPushCasFailed,
+        head_.compareExchange(current, node, std::memory_order_release, std::memory_order_relaxed));
+  }
+
+  enum class PopOutcome { Popped, Empty, Contended };
+
+  PopOutcome tryPopOnce(Node*& popped) {
+    std::uint64_t current = head_.load(std::memory_order_acquire);
+    Node* node = Head::pointer(current);
+    if (!node) {
+      return PopOutcome::Empty;
+    }
+    if (contention::recordCas(contention::Event::StackPopCas, contention::Event::StackPopCasFailed,
+                              head_.compareExchange(current, node->next.load(std::memory_order_relaxed),
+                                                    std::memory_order_acquire, std::memory_order_relaxed))) {
+      popped = node;
+      return PopOutcome::Popped;
+    }
+    return PopOutcome::Contended;
+  }
+
+  // Push side: park the node in a slot and wait for a pop to take it; true if it was taken
+  bool offer(Node* node) {
+    Slot& slot = pickSlot();
+    std::uint64_t empty = slot.offer.load(std::memory_order_relaxed);
+    if (Head::pointer(empty) != nullptr ||
+        !slot.offer.compareExchange(empty, node, std::memory_order_release, std::memory_order_relaxed)) {
+      growRange();
+      return false;
+    }
+    const std::uint64_t parked = Head::successor(empty, node);
+
+    for (int spin = 0; spin < kOfferSpins; ++spin) {
+      if (slot.offer.load(std::memory_order_acquire) != parked) {
+        eliminated_.fetch_add(1, std::memory_order_relaxed);
+        return true;  // taken: the pop now owns the node
+      }
+    }
+
+    // compareExchange is weak: only a changed word means a pop got there first
+    std::uint64_t expected = parked;
+    while (!slot.offer.compareExchange(expected, nullptr, std::memory_order_acquire, std::memory_order_acquire)) {
+      if (expected != parked) {
+        eliminated_.fetch_add(1, std::memory_order_relaxed);
+        return true;  // taken just before the withdrawal
+      }
+    }
+    shrinkRange();
+    return false;  // withdrawn, nobody came
+  }
+
+  // Pop side: take a parked node from a slot, if one shows up shortly
+  Node* take() {
+    Slot& slot = pickSlot();
+    for (int spin = 0; spin < kTakeSpins; ++spin) {
+      std::uint64_t current = slot.offer.load(std::memory_order_acquire);
+      if (Node* node = Head::pointer(current)) {
+        if (slot.offer.compareExchange(current, nullptr, std::memory_order_acquire, std::memory_order_relaxed)) {
+          return node;
+        }
+      }
+    }
+    return nullptr;
+  }
+
+  std::optional<T> consume(Node* node) {
+    std::optional<T> result(std::move(node->value));
+    node->value.reset();
+    reclamation_.retire(node);
+    return result;
+  }
+
+ public:
+  EliminationBackoffStack() = default;
+  EliminationBackoffStack(const EliminationBackoffStack&) = delete;
+  EliminationBackoffStack& operator=(const EliminationBackoffStack&) = delete;
+
+  // Offers are always withdrawn or taken before their push returns, so only the head can still hold nodes
+  ~EliminationBackoffStack() {
+    Node* node = Head::pointer(head_.load());
+    while (node) {
+      Node* next = node->next.load(std::memory_order_relaxed);
+      reclamation_.destroy(node);
+      node = next;
+    }
+  }
+
+  void push(T value) { emplace(std::move(value)); }
+
+  template <typename... Args>
+  void emplace(Args&&... args) {
+    Node* node = reclamation_.acquire();
+    node->value.emplace(std::forward<Args>(args)...);
+    size_.fetch_add(1, std::memory_order_relaxed);
+    while (!tryPushOnce(node) && !offer(node)) {
+    }
+  }
+
+  [[nodiscard]] std::optional<T> pop() {
+    [[maybe_unused]] auto guard = reclamation_.protect();
+    while (true) {
+      Node* node = nullptr;
+      switch (tryPopOnce(node)) {
+        case PopOutcome::Popped:
+          size_.fetch_sub(1, std::memory_order_relaxed);
+          return consume(node);
+        case PopOutcome::Empty:
+          return std::nullopt;
+        case PopOutcome::Contended:
+          if ((node = take()) != nullptr) {
+            size_.fetch_sub(1, std::memory_order_relaxed);
+            return consume(node);
+          }
+          break;
+      }
+    }
+  }
+
+  [[nodiscard]] bool tryPop(T& result) {
+    auto value = pop();
+    if (!value) {
+      return false;
+    }
+    result = std::move(*value);
+    return true;
+  }
+
+  // Parked offers are in-flight pushes, not yet visible here
+  [[nodiscard]] bool empty() const { return Head::pointer(head_.load()) == nullptr; }
+
+  [[nodiscard]] std::size_t size() const { return size_.load(std::memory_order_relaxed); }
+
+  [[nodiscard]] std::uint64_t eliminated() const { return eliminated_.load(std::memory_order_relaxed); }
+
+  [[nodiscard]] std::size_t activeSlots() const { return activeSlots_.load(std::memory_order_relaxed); }
+};
+
+}  // namespace lockfree
+
+#endif  // ELIMINATION_BACKOFF_STACK_H
@@ -0,0 +1,320 @@
+#ifndef EPOCH_RECLAMATION_H
+#define EPOCH_RECLAMATION_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "ContentionCounters.h"
+
+namespace lockfree {
+
+// Epoch-based reclamation (Fraser): one process-wide domain shared by every container that uses it.
+//
+// A thread pins itself before touching shared nodes, announcing the global epoch it saw. Unlinked nodes are retired
+// into the retiring thread's bag for the current epoch. The global epoch only moves from E to E+1 once every pinned
+// thread has announced E, so once it reaches E+2 nobody can still hold a reference obtained in E and that bag is
+// freed. Three bags per thread (E-2, E-1, E) are enough; each thread tries to advance the epoch every
+// kAdvanceThreshold retires. When those attempts succeed, unreclaimed memory stays around threads x 3 x
+// kAdvanceThreshold nodes. An attempt fails while some pinned thread still announces the previous epoch, and every
+// retire until the next success lands in the current bag, so a pinned thread that is preempted or stalled lets the
+// bags grow for as long as it stays pinned (an indefinitely stalled one stops all reclamation; that is EBR's
+// trade-off against hazard pointers). pending() shows what is actually outstanding.
+//
+// Threads register on their first pin/retire and release their slot at exit. Nodes they retired but could not free
+// yet go to a domain-wide orphan list; whichever thread next advances the epoch frees the orphan bags that are two
+// epochs old, and an exiting thread tries to advance twice itself so its own orphans do not wait for the next retire.
+class EpochDomain {
+ public:
+  static constexpr std::size_t kMaxThreads = 256;
+  static constexpr std::size_t kAdvanceThreshold = 64;
+
+ private:
+  struct Retired {
+    void* object;
+    void (*deleter)(void*);
+  };
+
+  struct Bag {
+    std::vector<Retired> nodes;
+    std::uint64_t epoch{0};
+  };
+
+  struct alignas(64) ThreadRecord {
+    std::atomic<std::uint64_t> announced{0};  // epoch << 1 | pinned
+    std::atomic<bool> inUse{false};
+    std::atomic<std::size_t> pending{0};  // written by the owner only, read by pending()
+
+    // Owner-only state
+    unsigned pinDepth{0};
+    std::size_t retiresSinceAdvance{0};
+    std::array<Bag, 3> bags;
+  };
+
+  // Releases the thread's record when the thread exits
+  class ThreadHandle {
+   private:
+    EpochDomain& domain_;
+    ThreadRecord& record_;
+
+   public:
+    explicit ThreadHandle(EpochDomain& domain) : domain_(domain), record_(domain.acquireRecord()) {}
+    ~ThreadHandle() { domain_.releaseRecord(record_); }
+    ThreadHandle(const ThreadHandle&) = delete;
+    ThreadHandle& operator=(const ThreadHandle&) = delete;
+
+    ThreadRecord& record() { return record_; }
+  };
+
+  alignas(64) std::atomic<std::uint64_t> globalEpoch_{2};  // starts at 2 so `epoch + 2 <= global` never wraps
+  alignas(64) std::atomic<std::size_t> recordHighWater_{0};
+  std::atomic<std::uint64_t> freed_{0};
+  std::array<ThreadRecord, kMaxThreads> records_;
+
+  std::mutex orphansMutex_;
+  std::vector<Bag> orphans_;
+  std::atomic<std::size_t> orphanCount_{0};
+
+  EpochDomain() = default;
+
+  ThreadRecord& acquireRecord() {
+    for (std::size_t idx = 0; idx < kMaxThreads; ++idx) {
+      bool expected = false;
+      if (!records_[idx].inUse.load(std::memory_order_relaxed) &&
+          records_[idx].inUse.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+        std::size_t highWater = recordHighWater_.load(std::memory_order_relaxed);
+        while (highWater < idx + 1 &&
+               !recordHighWater_.compare_exchange_weak(highWater, idx + 1, std::memory_order_release)) {
+        }
+        return records_[idx];
+      }
+    }
+    throw std::runtime_error("EpochDomain: more than kMaxThreads threads registered");
+  }
+
+  void releaseRecord(ThreadRecord& record) {
+    {
+      std::lock_guard lock(orphansMutex_);
+      for (auto& bag : record.bags) {
+        if (!bag.nodes.empty()) {
+          orphanCount_.fetch_add(bag.nodes.size(), std::memory_order_relaxed);
+          orphans_.push_back(std::move(bag));
+          bag = Bag{};
+        }
+      }
+    }
+    record.pending.store(0, std::memory_order_relaxed);
+    record.retiresSinceAdvance = 0;
+    record.announced.store(0, std::memory_order_release);
+    record.inUse.store(false, std::memory_order_release);
+
+    // The newest orphaned bag is from the current epoch: two advances make it collectable
+    for (int attempt = 0; attempt < 2 && advance(); ++attempt) {
+    }
+  }
+
+  ThreadRecord& local() {
+    thread_local ThreadHandle handle(*this);
+    return handle.record();
+  }
+
+  void freeBag(ThreadRecord& record, Bag& bag) {
+    for (const auto& retired : bag.nodes) {
+      retired.deleter(retired.object);
+    }
+    freed_.fetch_add(bag.nodes.size(), std::memory_order_relaxed);
+    record.pending.store(record.pending.load(std::memory_order_relaxed) - bag.nodes.size(),
+                         std::memory_order_relaxed);
+    bag.nodes.clear();
+  }
+
+  // Frees this thread's bags that are two epochs old
+  void collect(ThreadRecord& record, std::uint64_t epoch) {
+    for (auto& bag : record.bags) {
+      if (!bag.nodes.empty() && bag.epoch + 2 <= epoch) {
+        freeBag(record, bag);
+      }
+    }
+  }
+
+  // Runs after each successful advance; the lock is only ever held to hand over or free orphan bags
+  void collectOrphans(std::uint64_t epoch) {
+    if (orphanCount_.load(std::memory_order_relaxed) == 0) {
+      return;
+    }
+    std::lock_guard lock(orphansMutex_);
+    std::erase_if(orphans_, [&](Bag& bag) {
+      if (bag.epoch + 2 > epoch) {
+        return false;
+      }
+      for (const auto& retired : bag.nodes) {
+        retired.deleter(retired.object);
+      }
+      freed_.fetch_add(bag.nodes.size(), std::memory_order_relaxed);
+      orphanCount_.fetch_sub(bag.nodes.size(), std::memory_order_relaxed);
+      return true;
+    });
+  }
+
+  // tryAdvance() without the contention counters, which releaseRecord() may no longer touch: they live in a
+  // thread_local that can be destroyed before this thread's ThreadHandle
+  bool advance() {
+    std::uint64_t epoch = globalEpoch_.load(std::memory_order_seq_cst);
+    const std::size_t highWater = recordHighWater_.load(std::memory_order_acquire);
+    for (std::size_t idx = 0; idx < highWater; ++idx) {
+      const std::uint64_t announced = records_[idx].announced.load(std::memory_order_seq_cst);
+      if ((announced & 1) != 0 && (announced >> 1) != epoch) {
+        return false;
+      }
+    }
+    if (!globalEpoch_.compare_exchange_strong(epoch, epoch + 1, std::memory_order_seq_cst)) {
+      return false;
+    }
+    collectOrphans(epoch + 1);
+    return true;
+  }
+
+  void unpin(ThreadRecord& record) {
+    if (--record.pinDepth == 0) {
+      record.announced.store(record.announced.load(std::memory_order_relaxed) & ~std::uint64_t{1},
+                             std::memory_order_release);
+    }
+  }
+
+ public:
+  EpochDomain(const EpochDomain&) = delete;
+  EpochDomain& operator=(const EpochDomain&) = delete;
+
+  // Runs after every thread_local handle is gone: whatever is still retired can go
+  ~EpochDomain() {
+    for (auto& record : records_) {
+      for (auto& bag : record.bags) {
+        freeBag(record, bag);
+      }
+    }
+    for (auto& bag : orphans_) {
+      for (const auto& retired : bag.nodes) {
+        retired.deleter(retired.object);
+      }
+    }
+  }
+
+  static EpochDomain& instance() {
+    static EpochDomain domain;
+    return domain;
+  }
+
+  // Pins the calling thread for its lifetime; nests
+  class Guard {
+   private:
+    EpochDomain* domain_;
+    ThreadRecord* record_;
+
+   public:
+    explicit Guard(EpochDomain& domain) : domain_(&domain), record_(&domain.local()) {
+      if (record_->pinDepth++ == 0) {
+        // The announcement must be visible before any shared node is read, hence seq_cst fence
+        const std::uint64_t epoch = domain.globalEpoch_.load(std::memory_order_relaxed);
+        record_->announced.store(epoch << 1 | 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+      }
+    }
+
+    Guard(Guard&& other) noexcept
+        : domain_(std::exchange(other.domain_, nullptr)), record_(std::exchange(other.record_, nullptr)) {}
+    Guard(const Guard&) = delete;
+    Guard& operator=(const Guard&) = delete;
+    Guard& operator=(Guard&&) = delete;
+
+    ~Guard() {
+      if (domain_ != nullptr) {
+        domain_->unpin(*record_);
+      }
+    }
+  };
+
+  [[nodiscard]] Guard pin() { return Guard(*this); }
+
+  // `object` must already be unreachable for threads that pin from now on
+  void retire(void* object, void (*deleter)(void*)) {
+    ThreadRecord& record = local();
+    const std::uint64_t epoch = globalEpoch_.load(std::memory_order_seq_cst);
+    Bag& bag = record.bags[epoch % 3];
+    if (bag.epoch != epoch) {
+      if (!bag.nodes.empty()) {
+        freeBag(record, bag);  // from epoch - 3 or earlier
+      }
+      bag.epoch = epoch;
+    }
+    bag.nodes.push_back(Retired{object, deleter});
+    const std::size_t pending = record.pending.load(std::memory_order_relaxed) + 1;
+    record.pending.store(pending, std::memory_order_relaxed);
+    contention::record(contention::Event::NodesRetired);
+    contention::record(contention::Event::RetireListLength, pending);
+
+    if (++record.retiresSinceAdvance >= kAdvanceThreshold) {
+      record.retiresSinceAdvance = 0;
+      tryAdvance();
+      collect(record, globalEpoch_.load(std::memory_order_acquire));
+    }
+  }
+
+  template <typename T>
+  void retire(T* object) {
+    retire(object, [](void* pointer) { delete static_cast<T*>(pointer); });
+  }
+
+  // Moves the global epoch forward if every pinned thread has caught up with it, then frees old orphan bags
+  bool tryAdvance() {
+    contention::record(contention::Event::ReclamationScans);
+    contention::record(contention::Event::ReclamationScanLength, recordHighWater_.load(std::memory_order_relaxed));
+    return advance();
+  }
+
+  [[nodiscard]] std::uint64_t epoch() const { return globalEpoch_.load(std::memory_order_relaxed); }
+
+  // Retired but not yet freed, over all threads (approximate while they run)
+  [[nodiscard]] std::size_t pending() const {
+    std::size_t total = orphanCount_.load(std::memory_order_relaxed);
+    const std::size_t highWater = recordHighWater_.load(std::memory_order_acquire);
+    for (std::size_t idx = 0; idx < highWater; ++idx) {
+      total += records_[idx].pending.load(std::memory_order_relaxed);
+    }
+    return total;
+  }
+
+  [[nodiscard]] std::uint64_t freed() const { return freed_.load(std::memory_order_relaxed); }
+};
+
+// Reclamation policy (see LockFreeStack.h) backed by the shared EpochDomain: pops run pinned, retired nodes are
+// deleted two epochs later. Unlike NodePoolReclamation this returns memory to the allocator while the container is
+// alive, and unlike DeferredReclamation its footprint stays bounded.
+template <typename Node>
+class EpochReclamation {
+ private:
+  EpochDomain& domain_{EpochDomain::instance()};
+
+ public:
+  using Guard = EpochDomain::Guard;
+
+  EpochReclamation() = default;
+  EpochReclamation(const EpochReclamation&) = delete;
+  EpochReclamation& operator=(const EpochReclamation&) = delete;
+
+  Guard protect() { return domain_.pin(); }
+
+  Node* acquire() { return new Node(); }
+
+  void retire(Node* node) { domain_.retire(node); }
+
+  void destroy(Node* node) { delete node; }
+};
+
+}  // namespace lockfree
+
+#endif  // EPOCH_RECLAMATION_H
@@ -0,0 +1,257 @@
+#ifndef EXECUTION_GATEWAY_H
+#define EXECUTION_GATEWAY_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <queue>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "LockFreeQueue.h"
+#include "logging.h"
+
+struct ExecutionOrder {
+  std::uint64_t orderId{0};
+  std::string symbol;
+  std::uint8_t action{0};
+  double confidence{0.0};
+  std::string reason;
+  std::chrono::steady_clock::time_point submitTime{};
+};
+
+struct ExecutionReport {
+  enum class Status { Filled, Rejected };
+
+  std::uint64_t orderId;
+  std::string symbol;
+  std::uint8_t action;
+  double confidence;
+  std::string reason;
+  Status status;
+  std::size_t venue;
+  std::size_t batchSize;
+  std::chrono::microseconds latency;  // submit -> completion callback
+};
+
+// Asynchronous execution gateway.
+//
+// submit() is non-blocking: it pushes the order onto the gateway's own outbound LockFreeQueue and returns. A single
+// gateway thread drains the queue, groups orders per venue into batches, and pipelines the batches against the venue
+// (up to `maxInFlightPerVenue` outstanding requests instead of one round trip at a time). Venue acknowledgements
+// complete orders through their callbacks on the gateway thread, so callbacks must stay short. No caller thread ever
+// sleeps on execution latency.
+//
+// The venue is a local stand-in: each batch is acknowledged `venueLatency` after it is sent.
+class ExecutionGateway {
+ public:
+  using Callback = std::function<void(const ExecutionReport&)>;
+  using Clock = std::chrono::steady_clock;
+
+  struct Options {
+    std::size_t venues{2};
+    std::size_t maxBatchSize{32};
+    std::size_t maxInFlightPerVenue{8};
+    std::chrono::microseconds venueLatency{10'000};
+  };
+
+  struct Stats {
+    std::uint64_t submitted;
+    std::uint64_t completed;
+    std::uint64_t batchesSent;
+    std::size_t inFlightBatches;
+    double averageBatchSize;
+    double averageLatencyMicros;
+  };
+
+ private:
+  struct PendingOrder {
+    ExecutionOrder order;
+    Callback callback;
+  };
+
+  struct InFlightBatch {
+    Clock::time_point ackTime;
+    std::size_t venue;
+    std::vector<PendingOrder> orders;
+
+    bool operator>(const InFlightBatch& other) const { return ackTime > other.ackTime; }
+  };
+
+  struct VenueState {
+    std::vector<PendingOrder> waiting;  // accumulated but not yet sent
+    std::size_t inFlight{0};
+  };
+
+  Options options_;
+  LockFreeQueue<PendingOrder> outbound_;
+
+  std::mutex wakeMutex_;
+  std::condition_variable wakeCondition_;
+
+  // Gateway-thread state
+  std::vector<VenueState> venues_;
+  std::priority_queue<InFlightBatch, std::vector<InFlightBatch>, std::greater<>> inFlight_;
+
+  std::atomic<std::uint64_t> nextOrderId_{1};
+  std::atomic<std::uint64_t> submitted_{0};
+  std::atomic<std::uint64_t> completed_{0};
+  std::atomic<std::uint64_t> batchesSent_{0};
+  std::atomic<std::uint64_t> ordersSent_{0};
+  std::atomic<std::size_t> inFlightBatches_{0};
+  std::atomic<std::uint64_t> totalLatencyMicros_{0};
+
+  std::jthread gatewayThread_;
+
+  std::size_t venueFor(const std::string& symbol) const { return std::hash<std::string>{}(symbol) % venues_.size(); }
+
+  void drainOutbound() {
+    PendingOrder pending;
+    while (outbound_.dequeue(pending)) {
+      venues_[venueFor(pending.order.symbol)].waiting.push_back(std::move(pending));
+    }
+  }
+
+  void sendBatches(Clock::time_point now) {
+    for (std::size_t venue = 0; venue < venues_.size(); ++venue) {
+      VenueState& state = venues_[venue];
+      while (!state.waiting.empty() && state.inFlight < options_.maxInFlightPerVenue) {
+        const std::size_t take = std::min(options_.maxBatchSize, state.waiting.size());
+        InFlightBatch batch{now + options_.venueLatency, venue, {}};
+        batch.orders.reserve(take);
+        std::move(state.waiting.begin(), state.waiting.begin() + take, std::back_inserter(batch.orders));
+        state.waiting.erase(state.waiting.begin(), state.waiting.begin() + take);
+
+        inFlight_.push(std::move(batch));
+        ++state.inFlight;
+        batchesSent_.fetch_add(1, std::memory_order_relaxed);
+        ordersSent_.fetch_add(take, std::memory_order_relaxed);
+        inFlightBatches_.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  void completeAcknowledged(Clock::time_point now) {
+    while (!inFlight_.empty() && inFlight_.top().ackTime <= now) {
+      InFlightBatch batch = std::move(const_cast<InFlightBatch&>(inFlight_.top()));
+      inFlight_.pop();
+      --venues_[batch.venue].inFlight;
+      inFlightBatches_.fetch_sub(1, std::memory_order_relaxed);
+
+      const auto completedAt = Clock::now();
+      for (auto& pending : batch.orders) {
+        const auto latency =
+            std::chrono::duration_cast<std::chrono::microseconds>(completedAt - pending.order.submitTime);
+        totalLatencyMicros_.fetch_add(static_cast<std::uint64_t>(latency.count()), std::memory_order_relaxed);
+
+        if (pending.callback) {
+          ExecutionReport report{pending.order.orderId,
+                                 std::move(pending.order.symbol),
+                                 pending.order.action,
+                                 pending.order.confidence,
+                                 std::move(pending.order.reason),
+                                 ExecutionReport::Status::Filled,
+                                 batch.venue,
+                                 batch.orders.size(),
+                                 latency};
+          // A failing callback must not take the gateway down, but it must not go unnoticed either
+          try {
+            pending.callback(report);
+          } catch (const std::exception& e) {
+            logging::logSync(std::cerr, "Execution callback for order ", report.orderId, " failed: ", e.what(), "\n");
+          } catch (...) {
+            logging::logSync(std::cerr, "Execution callback for order ", report.orderId,
+                             " failed with unknown exception\n");
+          }
+        }
+        completed_.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  bool hasWaitingOrders() const {
+    return std::any_of(venues_.begin(), venues_.end(), [](const VenueState& v) { return !v.waiting.empty(); });
+  }
+
+  void run(std::stop_token stopToken) {
+    while (true) {
+      const bool stopping = stopToken.stop_requested();
+      drainOutbound();
+      const auto now = Clock::now();
+      completeAcknowledged(now);
+      sendBatches(now);
+
+      if (stopping && outbound_.empty() && inFlight_.empty() && !hasWaitingOrders()) {
+        break;
+      }
+
+      // Sleep until the next venue ack, or until a new order arrives
+      const auto deadline = inFlight_.empty() ? now + std::chrono::milliseconds(50) : inFlight_.top().ackTime;
+      std::unique_lock<std::mutex> lock(wakeMutex_);
+      // Once the stop has been seen, only new orders or acks end the wait, otherwise draining would spin
+      wakeCondition_.wait_until(lock, deadline,
+                                [&] { return !outbound_.empty() || (!stopping && stopToken.stop_requested()); });
+    }
+  }
+
+ public:
+  explicit ExecutionGateway(Options options) : options_(options), venues_(std::max<std::size_t>(options.venues, 1)) {
+    gatewayThread_ = std::jthread([this](std::stop_token token) { run(token); });
+  }
+
+  ExecutionGateway() : ExecutionGateway(Options{}) {}
+
+  ExecutionGateway(const ExecutionGateway&) = delete;
+  ExecutionGateway& operator=(const ExecutionGateway&) = delete;
+
+  // Drains every queued and in-flight order before returning
+  ~ExecutionGateway() {
+    {
+      // Same pairing as submit(): the gateway either sees the stop in its predicate or is already waiting
+      std::lock_guard<std::mutex> lock(wakeMutex_);
+      gatewayThread_.request_stop();
+    }
+    wakeCondition_.notify_one();
+  }
+
+  std::uint64_t submit(ExecutionOrder order, Callback callback) {
+    order.orderId = nextOrderId_.fetch_add(1, std::memory_order_relaxed);
+    order.submitTime = Clock::now();
+    const std::uint64_t orderId = order.orderId;
+
+    outbound_.enqueue(PendingOrder{std::move(order), std::move(callback)});
+    submitted_.fetch_add(1, std::memory_order_relaxed);
+    {
+      // Pairs with the predicate check in run() so a wakeup cannot be lost
+      std::lock_guard<std::mutex> lock(wakeMutex_);
+    }
+    wakeCondition_.notify_one();
+    return orderId;
+  }
+
+  Stats getStats() const {
+    const auto completed = completed_.load(std::memory_order_relaxed);
+    const auto batches = batchesSent_.load(std::memory_order_relaxed);
+    const auto latency = totalLatencyMicros_.load(std::memory_order_relaxed);
+    return Stats{submitted_.load(std::memory_order_relaxed),
+                 completed,
+                 batches,
+                 inFlightBatches_.load(std::memory_order_relaxed),
+                 batches == 0 ? 0.0
+                              : static_cast<double>(ordersSent_.load(std::memory_order_relaxed)) /
+                                    static_cast<double>(batches),
+                 completed == 0 ? 0.0 : static_cast<double>(latency) / static_cast<double>(completed)};
+  }
+};
+
+#endif  // EXECUTION_GATEWAY_H
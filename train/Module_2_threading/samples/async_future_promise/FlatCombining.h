@@ -0,0 +1,232 @@
+#ifndef FLAT_COMBINING_H
+#define FLAT_COMBINING_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace combining {
+
+namespace detail {
+
+// Small dense per-thread index, recycled when a thread exits, so combiners only sweep slots of threads that exist
+class ThreadIndex {
+ private:
+  std::size_t index_;
+
+  static std::mutex& mutex() {
+    static std::mutex registryMutex;
+    return registryMutex;
+  }
+
+  static std::vector<bool>& used() {
+    static std::vector<bool> registry;
+    return registry;
+  }
+
+ public:
+  ThreadIndex() {
+    std::lock_guard lock(mutex());
+    auto& registry = used();
+    index_ = 0;
+    while (index_ < registry.size() && registry[index_]) {
+      ++index_;
+    }
+    if (index_ == registry.size()) {
+      registry.push_back(true);
+    } else {
+      registry[index_] = true;
+    }
+  }
+
+  ~ThreadIndex() {
+    std::lock_guard lock(mutex());
+    used()[index_] = false;
+  }
+
+  ThreadIndex(const ThreadIndex&) = delete;
+  ThreadIndex& operator=(const ThreadIndex&) = delete;
+
+  static std::size_t current() {
+    thread_local const ThreadIndex self;
+    return self.index_;
+  }
+};
+
+}  // namespace detail
+
+// Flat combining (Hendler, Incze, Shavit & Tzafrir): a sequential structure behind one lock, where the lock holder
+// does everybody's work.
+//
+// A thread publishes its operation in a publication slot and then either grabs the lock and becomes the combiner, or
+// spins on its own slot until a combiner has run the operation for it. The combiner sweeps all slots and executes
+// every pending request back to back, so the structure stays in one core's cache and the lock changes hands once per
+// batch instead of once per operation. Under low contention it degenerates to "lock, do my op, unlock".
+//
+// Slots are claimed per operation (a CAS on a mostly thread-private line), starting at the thread's dense index, so
+// any number of short-lived threads can use the combiner; more than Slots concurrent callers just probe for a free
+// slot. The combiner only sweeps up to the highest slot ever claimed.
+template <typename Structure, std::size_t Slots = 64>
+class FlatCombiner {
+ private:
+  struct alignas(64) Slot {
+    std::atomic<bool> claimed{false};
+    std::atomic<bool> pending{false};
+    void (*invoke)(Structure&, void*){nullptr};
+    void* request{nullptr};
+  };
+
+  static constexpr int kSpinsBeforeYield = 64;
+  static constexpr int kCombinePasses = 3;  // further sweeps pick up requests published during the previous one
+
+  alignas(64) std::atomic<bool> locked_{false};
+  std::atomic<std::size_t> slotHighWater_{0};
+  Structure structure_;
+  std::array<Slot, Slots> slots_;
+
+  Slot& claimSlot() {
+    for (std::size_t idx = detail::ThreadIndex::current();; ++idx) {
+      Slot& slot = slots_[idx % Slots];
+      bool expected = false;
+      if (!slot.claimed.load(std::memory_order_relaxed) &&
+          slot.claimed.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+        std::size_t highWater = slotHighWater_.load(std::memory_order_relaxed);
+        while (highWater <= idx % Slots &&
+               !slotHighWater_.compare_exchange_weak(highWater, idx % Slots + 1, std::memory_order_release)) {
+        }
+        return slot;
+      }
+    }
+  }
+
+  bool tryLock() {
+    return !locked_.load(std::memory_order_relaxed) && !locked_.exchange(true, std::memory_order_acquire);
+  }
+
+  void combine() {
+    const std::size_t highWater = slotHighWater_.load(std::memory_order_acquire);
+    for (int pass = 0; pass < kCombinePasses; ++pass) {
+      bool served = false;
+      for (std::size_t idx = 0; idx < highWater; ++idx) {
+        Slot& slot = slots_[idx];
+        if (slot.pending.load(std::memory_order_acquire)) {
+          slot.invoke(structure_, slot.request);
+          slot.pending.store(false, std::memory_order_release);
+          served = true;
+        }
+      }
+      if (!served) {
+        break;
+      }
+    }
+  }
+
+ public:
+  FlatCombiner() = default;
+
+  template <typename... Args>
+  explicit FlatCombiner(std::in_place_t, Args&&... args) : structure_(std::forward<Args>(args)...) {}
+
+  FlatCombiner(const FlatCombiner&) = delete;
+  FlatCombiner& operator=(const FlatCombiner&) = delete;
+
+  // Runs `operation(structure)` under the combiner lock (possibly on another thread) and returns its result;
+  // exceptions thrown by the operation are rethrown here
+  template <typename Operation>
+  std::invoke_result_t<Operation&, Structure&> apply(Operation operation) {
+    using Result = std::invoke_result_t<Operation&, Structure&>;
+    struct Request {
+      Operation* operation;
+      std::conditional_t<std::is_void_v<Result>, bool, std::optional<Result>> result{};
+      std::exception_ptr error;
+    } request{&operation, {}, {}};
+
+    Slot& slot = claimSlot();
+    slot.invoke = [](Structure& structure, void* erased) {
+      auto& pendingRequest = *static_cast<Request*>(erased);
+      try {
+        if constexpr (std::is_void_v<Result>) {
+          (*pendingRequest.operation)(structure);
+        } else {
+          pendingRequest.result.emplace((*pendingRequest.operation)(structure));
+        }
+      } catch (...) {
+        pendingRequest.error = std::current_exception();
+      }
+    };
+    slot.request = &request;
+    slot.pending.store(true, std::memory_order_release);
+
+    for (int spins = 0; slot.pending.load(std::memory_order_acquire); ++spins) {
+      if (tryLock()) {
+        combine();  // includes our own request
+        locked_.store(false, std::memory_order_release);
+      } else if (spins >= kSpinsBeforeYield) {
+        std::this_thread::yield();
+      }
+    }
+    slot.claimed.store(false, std::memory_order_release);
+
+    if (request.error) {
+      std::rethrow_exception(request.error);
+    }
+    if constexpr (!std::is_void_v<Result>) {
+      return std::move(*request.result);
+    }
+  }
+};
+
+// LIFO stack on a flat-combined std::vector: same interface as lockfree::LockFreeStack
+template <typename T>
+class FlatCombiningStack {
+ private:
+  FlatCombiner<std::vector<T>> combiner_;
+  std::atomic<std::size_t> size_{0};  // written by the combiner only, so empty()/size() need no combining
+
+ public:
+  void push(T value) { emplace(std::move(value)); }
+
+  template <typename... Args>
+  void emplace(Args&&... args) {
+    combiner_.apply([&](std::vector<T>& items) {
+      items.emplace_back(std::forward<Args>(args)...);
+      size_.store(items.size(), std::memory_order_relaxed);
+    });
+  }
+
+  [[nodiscard]] std::optional<T> pop() {
+    return combiner_.apply([&](std::vector<T>& items) -> std::optional<T> {
+      if (items.empty()) {
+        return std::nullopt;
+      }
+      std::optional<T> top(std::move(items.back()));
+      items.pop_back();
+      size_.store(items.size(), std::memory_order_relaxed);
+      return top;
+    });
+  }
+
+  [[nodiscard]] bool tryPop(T& result) {
+    auto value = pop();
+    if (!value) {
+      return false;
+    }
+    result = std::move(*value);
+    return true;
+  }
+
+  [[nodiscard]] bool empty() const { return size_.load(std::memory_order_relaxed) == 0; }
+
+  [[nodiscard]] std::size_t size() const { return size_.load(std::memory_order_relaxed); }
+};
+
+}  // namespace combining
+
+#endif  // FLAT_COMBINING_H
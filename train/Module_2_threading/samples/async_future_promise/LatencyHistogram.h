@@ -0,0 +1,98 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace metrics {
+
+// Lock-free log-linear histogram of durations in nanoseconds, for percentiles that an average hides.
+//
+// Every power of two is split into 8 linear sub-buckets, so a reported percentile is at most 12.5% above the true
+// value, across the full 64-bit range, in 496 counters. record() is one relaxed fetch_add, plus a CAS loop only when
+// it raises the maximum. Readers walk the counters while writers keep recording: a snapshot is not atomic, but each
+// counter is, which is all a monitor needs. Counts accumulate from construction (no sliding window).
+class LatencyHistogram {
+ private:
+  static constexpr int kSubBucketBits = 3;
+  static constexpr std::uint64_t kSubBuckets = 1u << kSubBucketBits;
+  static constexpr std::size_t kBuckets = (64 - kSubBucketBits + 1) * kSubBuckets;
+
+  std::array<std::atomic<std::uint64_t>, kBuckets> counts_{};
+  std::atomic<std::uint64_t> total_{0};
+  std::atomic<std::uint64_t> max_{0};
+
+  static std::size_t bucketOf(std::uint64_t nanos) {
+    if (nanos < kSubBuckets) {
+      return static_cast<std::size_t>(nanos);
+    }
+    const int shift = std::bit_width(nanos) - 1 - kSubBucketBits;
+    return static_cast<std::size_t>((shift + 1) * kSubBuckets + ((nanos >> shift) & (kSubBuckets - 1)));
+  }
+
+  // Largest value that lands in `bucket`
+  static std::uint64_t upperBound(std::size_t bucket) {
+    if (bucket < kSubBuckets) {
+      return bucket;
+    }
+    const auto shift = static_cast<int>(bucket / kSubBuckets - 1);
+    const std::uint64_t sub = bucket % kSubBuckets;
+    return ((kSubBuckets + sub + 1) << shift) - 1;
+  }
+
+ public:
+  struct Snapshot {
+    std::uint64_t count{0};
+    std::chrono::nanoseconds p50{0};
+    std::chrono::nanoseconds p99{0};
+    std::chrono::nanoseconds max{0};
+  };
+
+  void record(std::chrono::nanoseconds duration) {
+    const auto nanos = static_cast<std::uint64_t>(std::max<std::chrono::nanoseconds::rep>(duration.count(), 0));
+    counts_[bucketOf(nanos)].fetch_add(1, std::memory_order_relaxed);
+    total_.fetch_add(1, std::memory_order_relaxed);
+    std::uint64_t seen = max_.load(std::memory_order_relaxed);
+    while (nanos > seen && !max_.compare_exchange_weak(seen, nanos, std::memory_order_relaxed)) {
+    }
+  }
+
+  std::uint64_t count() const { return total_.load(std::memory_order_relaxed); }
+
+  std::chrono::nanoseconds max() const {
+    return std::chrono::nanoseconds(static_cast<std::chrono::nanoseconds::rep>(max_.load(std::memory_order_relaxed)));
+  }
+
+  // Smallest bucket bound with at least `quantile` of the samples at or below it, capped at the recorded maximum
+  std::chrono::nanoseconds percentile(double quantile) const {
+    std::uint64_t total = 0;
+    std::array<std::uint64_t, kBuckets> counts;
+    for (std::size_t idx = 0; idx < kBuckets; ++idx) {
+      counts[idx] = counts_[idx].load(std::memory_order_relaxed);
+      total += counts[idx];
+    }
+    if (total == 0) {
+      return std::chrono::nanoseconds(0);
+    }
+    const auto rank = static_cast<std::uint64_t>(quantile * static_cast<double>(total - 1)) + 1;
+    std::uint64_t seen = 0;
+    for (std::size_t idx = 0; idx < kBuckets; ++idx) {
+      seen += counts[idx];
+      if (seen >= rank) {
+        return std::min(std::chrono::nanoseconds(static_cast<std::chrono::nanoseconds::rep>(upperBound(idx))), max());
+      }
+    }
+    return max();
+  }
+
+  Snapshot snapshot() const { return Snapshot{count(), percentile(0.50), percentile(0.99), max()}; }
+};
+
+}  // namespace metrics
+
+#endif  // LATENCY_HISTOGRAM_H
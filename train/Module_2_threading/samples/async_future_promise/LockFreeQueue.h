@@ -1,73 +1,60 @@
 #ifndef LOCKFREE_QUEUE_H
 #define LOCKFREE_QUEUE_H
 
-#include <array>
 #include <atomic>
-#include <chrono>
-#include <memory>
+#include <cstddef>
 #include <type_traits>
+#include <utility>
 
-template <typename T>
+#include "ContentionCounters.h"
+#include "EpochReclamation.h"
+#include "LockFreeStack.h"
+
+// Michael-Scott queue. Dequeued nodes are handed to the reclamation policy (LockFreeStack.h interface); both
+// operations run under its guard because they dereference head_/tail_ nodes another thread may have unlinked.
+// Pointers here are untagged, so a policy that recycles nodes (NodePoolReclamation) would reintroduce ABA.
+template <typename T, template <typename> class Reclamation = lockfree::EpochReclamation>
 class LockFreeQueue {
  private:
   struct Node {
     std::atomic<T*> data{nullptr};
     std::atomic<Node*> next{nullptr};
-
-    Node() = default;
-
-    explicit Node(T item) { data.store(new T(std::move(item)), std::memory_order_relaxed); }
   };
 
+  static_assert(!std::is_same_v<Reclamation<Node>, lockfree::NodePoolReclamation<Node>>,
+                "LockFreeQueue needs a policy that does not reuse nodes while other threads may hold them");
+
+  Reclamation<Node> reclamation_;
   std::atomic<Node*> head_;
   std::atomic<Node*> tail_;
   std::atomic<size_t> size_{0};
 
-  // Memory reclamation using hazard pointers (simplified)
-  static constexpr size_t MAX_HAZARD_POINTERS = 16;
-  thread_local static std::array<std::atomic<Node*>, MAX_HAZARD_POINTERS> hazardPointers;
-  inline static std::atomic<size_t> hazardPointerIndex{0};
-
-  Node* acquireHazardPointer(Node* node) {
-    size_t index = hazardPointerIndex.fetch_add(1, std::memory_order_relaxed) % MAX_HAZARD_POINTERS;
-    hazardPointers[index].store(node, std::memory_order_release);
-    return node;
-  }
-
-  void releaseHazardPointer(Node* node) {
-    for (auto& hp : hazardPointers) {
-      if (hp.load(std::memory_order_acquire) == node) {
-        hp.store(nullptr, std::memory_order_release);
-        break;
-      }
-    }
-  }
-
-  bool isHazardous(Node* node) {
-    for (const auto& hp : hazardPointers) {
-      if (hp.load(std::memory_order_acquire) == node) {
-        return true;
-      }
-    }
-    return false;
-  }
-
  public:
   LockFreeQueue() {
-    Node* dummy = new Node();
+    Node* dummy = reclamation_.acquire();
     head_.store(dummy, std::memory_order_relaxed);
     tail_.store(dummy, std::memory_order_relaxed);
   }
 
+  LockFreeQueue(const LockFreeQueue&) = delete;
+  LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+
+  // The head is the dummy: its data was already moved out by the dequeue that made it the dummy
   ~LockFreeQueue() {
-    while (Node* node = head_.load(std::memory_order_relaxed)) {
-      head_.store(node->next.load(std::memory_order_relaxed), std::memory_order_relaxed);
-      delete node;
+    Node* node = head_.load(std::memory_order_relaxed);
+    reclamation_.destroy(std::exchange(node, node->next.load(std::memory_order_relaxed)));
+    while (node) {
+      Node* next = node->next.load(std::memory_order_relaxed);
+      delete node->data.load(std::memory_order_relaxed);
+      reclamation_.destroy(node);
+      node = next;
     }
   }
 
   void enqueue(T item) {
-    Node* newNode = new Node(std::move(item));
+    Node* newNode = reclamation_.acquire();
+    newNode->data.store(new T(std::move(item)), std::memory_order_relaxed);
+    [[maybe_unused]] auto guard = reclamation_.protect();
 
     while (true) {
       Node* last = tail_.load(std::memory_order_acquire);
@@ -75,12 +62,15 @@ class LockFreeQueue {
 
       if (last == tail_.load(std::memory_order_acquire)) {
         if (next == nullptr) {
-          if (last->next.compare_exchange_weak(next, newNode, std::memory_order_release, std::memory_order_relaxed)) {
+          if (contention::recordCas(contention::Event::QueueEnqueueCas, contention::Event::QueueEnqueueCasFailed,
+                                    last->next.compare_exchange_weak(next, newNode, std::memory_order_release,
+                                                                     std::memory_order_relaxed))) {
             tail_.compare_exchange_weak(last, newNode, std::memory_order_release, std::memory_order_relaxed);
             size_.fetch_add(1, std::memory_order_relaxed);
             break;
           }
         } else {
+          contention::record(contention::Event::QueueTailHelpCas);
           tail_.compare_exchange_weak(last, next, std::memory_order_release, std::memory_order_relaxed);
         }
       }
@@ -88,6 +78,7 @@ class LockFreeQueue {
   }
 
   bool dequeue(T& result) {
+    [[maybe_unused]] auto guard = reclamation_.protect();
     while (true) {
       Node* first = head_.load(std::memory_order_acquire);
       Node* last = tail_.load(std::memory_order_acquire);
@@ -98,6 +89,7 @@ class LockFreeQueue {
           if (next == nullptr) {
             return false;
           }
+          contention::record(contention::Event::QueueTailHelpCas);
           tail_.compare_exchange_weak(last, next, std::memory_order_release, std::memory_order_relaxed);
         } else {
           if (!next) {
@@ -109,15 +101,14 @@ class LockFreeQueue {
             continue;
           }
 
-          if (head_.compare_exchange_weak(first, next, std::memory_order_release, std::memory_order_relaxed)) {
-            result = *data;
+          if (contention::recordCas(contention::Event::QueueDequeueCas, contention::Event::QueueDequeueCasFailed,
+                                    head_.compare_exchange_weak(first, next, std::memory_order_release,
+                                                                std::memory_order_relaxed))) {
+            // The winner owns `data`; `next` becomes the new dummy and `first` can go once readers are done
+            result = std::move(*data);
             delete data;
             size_.fetch_sub(1, std::memory_order_relaxed);
-
-            if (!isHazardous(first)) {
-              delete first;
-            }
-
+            reclamation_.retire(first);
             return true;
           }
         }
@@ -130,8 +121,4 @@ class LockFreeQueue {
   size_t size() const { return size_.load(std::memory_order_acquire); }
 };
 
-template <typename T>
-thread_local std::array<std::atomic<typename LockFreeQueue<T>::Node*>, LockFreeQueue<T>::MAX_HAZARD_POINTERS>
-    LockFreeQueue<T>::hazardPointers{};
-
 #endif  // LOCKFREE_QUEUE_H
@@ -0,0 +1,348 @@
+#ifndef LOCK_FREE_SKIP_LIST_H
+#define LOCK_FREE_SKIP_LIST_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "EpochReclamation.h"
+
+namespace lockfree {
+
+// Lock-free ordered map (Herlihy & Shavit's lock-free skip list, Harris-style marked links on every level).
+//
+// A node is in the map iff it is linked and unmarked on level 0; the upper levels are only shortcuts. erase() marks
+// the node's links top-down and the thread that marks level 0 wins. Marked nodes are unlinked ("snipped") by whichever
+// insert/erase passes them; lookups and range scans never write, they just step over marked nodes.
+//
+// Reclamation: every operation runs pinned in the shared EpochDomain. A node may still be getting linked on its upper
+// levels by its inserter while it is erased, so it has two owners, the inserter (until it stops linking) and the
+// winning eraser. The last one to let go sweeps the key's path so the node is unlinked everywhere, then retires it.
+//
+// Values are immutable once inserted (insert() does not overwrite); replace a value with erase() + insert().
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class LockFreeSkipListMap {
+ public:
+  static constexpr int kMaxHeight = 20;  // ~1M keys at p = 1/2 before the top level stops helping
+
+ private:
+  using Link = std::atomic<std::uintptr_t>;  // Node* with the low bit as the "deleted" mark
+
+  static constexpr std::uintptr_t kMark = 1;
+
+  struct alignas(Link) Node {
+    Key key;
+    Value value;
+    int height;
+    std::atomic<int> owners{2};  // inserter + eraser, see above
+
+    template <typename K, typename V>
+    Node(int levels, K&& nodeKey, V&& nodeValue)
+        : key(std::forward<K>(nodeKey)), value(std::forward<V>(nodeValue)), height(levels) {}
+
+    // `height` links live right behind the node, in the same allocation
+    Link* links() { return reinterpret_cast<Link*>(reinterpret_cast<std::byte*>(this) + sizeof(Node)); }
+
+    template <typename K, typename V>
+    static Node* create(int levels, K&& nodeKey, V&& nodeValue) {
+      static_assert(alignof(Node) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+      void* memory = ::operator new(sizeof(Node) + static_cast<std::size_t>(levels) * sizeof(Link));
+      Node* node = new (memory) Node(levels, std::forward<K>(nodeKey), std::forward<V>(nodeValue));
+      for (int level = 0; level < levels; ++level) {
+        new (&node->links()[level]) Link(0);
+      }
+      return node;
+    }
+
+    static void destroy(void* erased) {
+      Node* node = static_cast<Node*>(erased);
+      node->~Node();
+      ::operator delete(node);
+    }
+  };
+
+  static Node* pointer(std::uintptr_t link) { return reinterpret_cast<Node*>(link & ~kMark); }
+  static bool marked(std::uintptr_t link) { return (link & kMark) != 0; }
+  static std::uintptr_t word(Node* node) { return reinterpret_cast<std::uintptr_t>(node); }
+
+  // Per level: the link to CAS (a predecessor's or the head's) and the node it pointed to
+  struct Path {
+    std::array<Link*, kMaxHeight> preds;
+    std::array<Node*, kMaxHeight> succs;
+  };
+
+  std::array<Link, kMaxHeight> head_{};
+  std::atomic<int> height_{1};  // highest level any node has used; searches start there
+  std::atomic<std::size_t> size_{0};
+  [[no_unique_address]] Compare less_;
+  EpochDomain& domain_{EpochDomain::instance()};
+
+  static int randomHeight() {
+    thread_local std::uint64_t state =
+        std::hash<std::thread::id>{}(std::this_thread::get_id()) | 1;  // xorshift64, never zero
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return std::min(1 + std::countr_zero(state), kMaxHeight);
+  }
+
+  // Unlinks `curr` (marked on `level`, successor `succ`) from behind `pred`; false if `pred` changed or got marked
+  static bool snip(Link* pred, int level, Node* curr, std::uintptr_t succ) {
+    std::uintptr_t expected = word(curr);
+    return pred[level].compare_exchange_strong(expected, succ & ~kMark, std::memory_order_acq_rel,
+                                               std::memory_order_relaxed);
+  }
+
+  // Fills `path` for `key`: on each level the last node less than `key` and its successor, snipping every marked node
+  // on the way. With SweepEqual, each level is also swept through the nodes equal to `key`, so that a marked node with
+  // that key is unlinked on every level even if a live one with the same key sits in front of it. Returns the first
+  // node >= key on level 0 if its key is equal.
+  template <bool SweepEqual = false>
+  Node* search(const Key& key, Path& path) {
+  retry:
+    Link* pred = head_.data();
+    Node* stop = nullptr;  // as in lowerBound()
+    for (int level = height_.load(std::memory_order_acquire) - 1; level >= 0; --level) {
+      Node* curr = pointer(pred[level].load(std::memory_order_acquire));
+      while (curr != nullptr) {
+        const std::uintptr_t succ = curr->links()[level].load(std::memory_order_acquire);
+        if (marked(succ)) {
+          if (!snip(pred, level, curr, succ)) {
+            goto retry;
+          }
+          curr = pointer(succ);
+        } else if (curr != stop && less_(curr->key, key)) {
+          pred = curr->links();
+          curr = pointer(succ);
+        } else {
+          break;
+        }
+      }
+      path.preds[level] = &pred[level];
+      path.succs[level] = curr;
+      stop = curr;
+
+      if constexpr (SweepEqual) {
+        Link* sweepPred = pred;
+        while (curr != nullptr && !less_(key, curr->key)) {
+          const std::uintptr_t succ = curr->links()[level].load(std::memory_order_acquire);
+          if (!marked(succ)) {
+            sweepPred = curr->links();
+          } else if (!snip(sweepPred, level, curr, succ)) {
+            goto retry;
+          }
+          curr = pointer(succ);
+        }
+      }
+    }
+    Node* candidate = path.succs[0];
+    return candidate != nullptr && !less_(key, candidate->key) ? candidate : nullptr;
+  }
+
+  // Read-only descent: first unmarked level-0 node not less than `key`, skipping marked nodes without snipping them
+  Node* lowerBound(const Key& key) const {
+    const Link* pred = head_.data();
+    Node* curr = nullptr;
+    Node* stop = nullptr;  // where the level above stopped: known not less than `key`, no need to compare again
+    for (int level = height_.load(std::memory_order_acquire) - 1; level >= 0; --level) {
+      curr = pointer(pred[level].load(std::memory_order_acquire));
+      while (curr != nullptr) {
+        const std::uintptr_t succ = curr->links()[level].load(std::memory_order_acquire);
+        if (!marked(succ) && (curr == stop || !less_(curr->key, key))) {
+          stop = curr;
+          break;
+        }
+        if (!marked(succ)) {
+          pred = curr->links();
+        }
+        curr = pointer(succ);
+      }
+    }
+    return curr;
+  }
+
+  static Node* nextLive(Node* node) {
+    while (node != nullptr) {
+      const std::uintptr_t succ = node->links()[0].load(std::memory_order_acquire);
+      if (!marked(succ)) {
+        return node;
+      }
+      node = pointer(succ);
+    }
+    return nullptr;
+  }
+
+  // Called by the inserter and by the winning eraser; the second one unlinks the node everywhere and retires it
+  void release(Node* node) {
+    if (node->owners.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      Path path;
+      search<true>(node->key, path);
+      domain_.retire(node, &Node::destroy);
+    }
+  }
+
+  void raiseHeight(int height) {
+    int current = height_.load(std::memory_order_relaxed);
+    while (current < height &&
+           !height_.compare_exchange_weak(current, height, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+  }
+
+ public:
+  LockFreeSkipListMap() = default;
+  LockFreeSkipListMap(const LockFreeSkipListMap&) = delete;
+  LockFreeSkipListMap& operator=(const LockFreeSkipListMap&) = delete;
+
+  // Erased nodes are already with the epoch domain; only live ones are still linked
+  ~LockFreeSkipListMap() {
+    Node* node = pointer(head_[0].load(std::memory_order_acquire));
+    while (node != nullptr) {
+      Node* next = pointer(node->links()[0].load(std::memory_order_relaxed));
+      Node::destroy(node);
+      node = next;
+    }
+  }
+
+  // False (and nothing changes) if the key is already present
+  template <typename K, typename V>
+  bool insert(K&& key, V&& value) {
+    const auto guard = domain_.pin();
+    const int height = randomHeight();
+    raiseHeight(height);  // before searching, so the path covers every level the node will use
+    Path path;
+    Node* node = nullptr;
+    while (true) {
+      const Key& probe = node != nullptr ? node->key : key;
+      if (search(probe, path) != nullptr) {
+        if (node != nullptr) {
+          Node::destroy(node);  // never published
+        }
+        return false;
+      }
+      if (node == nullptr) {
+        node = Node::create(height, std::forward<K>(key), std::forward<V>(value));
+      }
+      for (int level = 0; level < height; ++level) {
+        node->links()[level].store(word(path.succs[level]), std::memory_order_relaxed);
+      }
+      std::uintptr_t expected = word(path.succs[0]);
+      if (path.preds[0]->compare_exchange_strong(expected, word(node), std::memory_order_release,
+                                                 std::memory_order_relaxed)) {
+        break;  // linearization point: now in the map
+      }
+    }
+    size_.fetch_add(1, std::memory_order_relaxed);
+
+    // Upper levels; give up as soon as an eraser has marked the level we are about to link
+    for (int level = 1; level < height; ++level) {
+      while (true) {
+        std::uintptr_t expected = word(path.succs[level]);
+        if (path.preds[level]->compare_exchange_strong(expected, word(node), std::memory_order_release,
+                                                       std::memory_order_relaxed)) {
+          break;
+        }
+        search(node->key, path);
+        std::uintptr_t current = node->links()[level].load(std::memory_order_acquire);
+        if (marked(current) ||
+            !node->links()[level].compare_exchange_strong(current, word(path.succs[level]),
+                                                          std::memory_order_release, std::memory_order_relaxed)) {
+          release(node);
+          return true;
+        }
+      }
+    }
+    release(node);
+    return true;
+  }
+
+  bool erase(const Key& key) {
+    const auto guard = domain_.pin();
+    Path path;
+    Node* victim = search(key, path);
+    if (victim == nullptr) {
+      return false;
+    }
+    for (int level = victim->height - 1; level >= 1; --level) {
+      std::uintptr_t succ = victim->links()[level].load(std::memory_order_acquire);
+      while (!marked(succ) && !victim->links()[level].compare_exchange_weak(
+                                  succ, succ | kMark, std::memory_order_acq_rel, std::memory_order_acquire)) {
+      }
+    }
+    std::uintptr_t succ = victim->links()[0].load(std::memory_order_acquire);
+    while (true) {
+      if (marked(succ)) {
+        return false;  // another erase won
+      }
+      if (victim->links()[0].compare_exchange_weak(succ, succ | kMark, std::memory_order_acq_rel,
+                                                   std::memory_order_acquire)) {
+        break;  // linearization point: gone from the map
+      }
+    }
+    size_.fetch_sub(1, std::memory_order_relaxed);
+    search(key, path);  // unlink now rather than leaving it to the next writer
+    release(victim);
+    return true;
+  }
+
+  [[nodiscard]] std::optional<Value> find(const Key& key) const {
+    const auto guard = domain_.pin();
+    Node* node = lowerBound(key);
+    if (node == nullptr || less_(key, node->key)) {
+      return std::nullopt;
+    }
+    return node->value;
+  }
+
+  [[nodiscard]] bool contains(const Key& key) const {
+    const auto guard = domain_.pin();
+    Node* node = lowerBound(key);
+    return node != nullptr && !less_(key, node->key);
+  }
+
+  // Visits [from, to) in key order. Weakly consistent: every key present for the whole scan is visited exactly once,
+  // keys inserted or erased meanwhile may or may not be. `visit(key, value)` runs pinned, keep it short.
+  template <typename Visitor>
+  void forRange(const Key& from, const Key& to, Visitor visit) const {
+    const auto guard = domain_.pin();
+    for (Node* node = lowerBound(from); node != nullptr && less_(node->key, to);
+         node = nextLive(pointer(node->links()[0].load(std::memory_order_acquire)))) {
+      visit(node->key, node->value);
+    }
+  }
+
+  // Copy of [from, to), with forRange()'s consistency
+  [[nodiscard]] std::vector<std::pair<Key, Value>> range(const Key& from, const Key& to) const {
+    std::vector<std::pair<Key, Value>> entries;
+    forRange(from, to, [&](const Key& key, const Value& value) { entries.emplace_back(key, value); });
+    return entries;
+  }
+
+  // Copy of every entry in key order, with forRange()'s consistency
+  [[nodiscard]] std::vector<std::pair<Key, Value>> entries() const {
+    std::vector<std::pair<Key, Value>> all;
+    const auto guard = domain_.pin();
+    for (Node* node = nextLive(pointer(head_[0].load(std::memory_order_acquire))); node != nullptr;
+         node = nextLive(pointer(node->links()[0].load(std::memory_order_acquire)))) {
+      all.emplace_back(node->key, node->value);
+    }
+    return all;
+  }
+
+  // Approximate while writers run
+  [[nodiscard]] std::size_t size() const { return size_.load(std::memory_order_relaxed); }
+
+  [[nodiscard]] bool empty() const { return size() == 0; }
+};
+
+}  // namespace lockfree
+
+#endif  // LOCK_FREE_SKIP_LIST_H
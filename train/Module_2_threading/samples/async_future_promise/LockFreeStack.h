@@ -0,0 +1,248 @@
+#ifndef LOCK_FREE_STACK_H
+#define LOCK_FREE_STACK_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <optional>
+#include <utility>
+
+#include "ContentionCounters.h"
+
+namespace lockfree {
+
+namespace detail {
+
+// Stack head packed into one 64-bit word: node pointer in the low 48 bits (the user-space address range on x86-64 and
+// AArch64) and a 16-bit modification tag in the high bits. Every successful CAS bumps the tag, so a head that was
+// popped and pushed back between a thread's load and its CAS no longer compares equal. This narrows the ABA window
+// rather than closing it: the tag wraps after 65536 updates, so a thread stalled across exactly a multiple of that
+// many CASes can still succeed on a stale head. A single-width CAS is enough, no cmpxchg16b / libatomic needed.
+//
+// With 5-level paging (LA57) the kernel can hand out user addresses above 48 bits when asked for them; such a node
+// would lose its high bits to the tag, so successor() refuses it and aborts rather than corrupt the stack.
+template <typename Node>
+class TaggedHead {
+ private:
+  static_assert(sizeof(void*) == 8, "TaggedHead packs a 48-bit pointer and a 16-bit tag into 64 bits");
+  static constexpr int kTagShift = 48;
+  static constexpr std::uint64_t kPointerMask = (std::uint64_t{1} << kTagShift) - 1;
+
+  std::atomic<std::uint64_t> word_{0};
+
+ public:
+  static Node* pointer(std::uint64_t word) { return reinterpret_cast<Node*>(word & kPointerMask); }
+
+  static std::uint64_t successor(std::uint64_t word, Node* node) {
+    const auto address = reinterpret_cast<std::uintptr_t>(node);
+    if ((address & ~kPointerMask) != 0) [[unlikely]] {
+      std::fputs("TaggedHead: node address does not fit in 48 bits\n", stderr);
+      std::abort();
+    }
+    return ((word >> kTagShift) + 1) << kTagShift | address;
+  }
+
+  std::uint64_t load(std::memory_order order = std::memory_order_acquire) const { return word_.load(order); }
+
+  bool compareExchange(std::uint64_t& expected, Node* desired, std::memory_order success,
+                       std::memory_order failure) {
+    return word_.compare_exchange_weak(expected, successor(expected, desired), success, failure);
+  }
+};
+
+// Which contention counters a head's CAS loop feeds: the stack itself or a reclamation free list
+struct CasEvents {
+  contention::Event attempt;
+  contention::Event failure;
+};
+
+inline constexpr CasEvents kStackPush{contention::Event::StackPushCas, contention::Event::StackPushCasFailed};
+inline constexpr CasEvents kStackPop{contention::Event::StackPopCas, contention::Event::StackPopCasFailed};
+inline constexpr CasEvents kFreeList{contention::Event::FreeListCas, contention::Event::FreeListCasFailed};
+
+// Treiber push/pop on a tagged head. Nodes expose `std::atomic<Node*> next`; popNode() may read `next` of a node
+// another thread has already popped, so node memory must stay valid while a pop is in progress (the reclamation
+// policy's job).
+template <typename Node>
+void pushNode(TaggedHead<Node>& head, Node* node, const CasEvents& events = kStackPush) {
+  std::uint64_t current = head.load(std::memory_order_relaxed);
+  do {
+    node->next.store(TaggedHead<Node>::pointer(current), std::memory_order_relaxed);
+  } while (!contention::recordCas(
+      events.attempt, events.failure,
+      head.compareExchange(current, node, std::memory_order_release, std::memory_order_relaxed)));
+}
+
+template <typename Node>
+Node* popNode(TaggedHead<Node>& head, const CasEvents& events = kStackPop) {
+  std::uint64_t current = head.load(std::memory_order_acquire);
+  while (Node* node = TaggedHead<Node>::pointer(current)) {
+    if (contention::recordCas(events.attempt, events.failure,
+                              head.compareExchange(current, node->next.load(std::memory_order_relaxed),
+                                                   std::memory_order_acquire, std::memory_order_acquire))) {
+      return node;
+    }
+  }
+  return nullptr;
+}
+
+template <typename Node>
+void deleteChain(Node* node) {
+  while (node) {
+    Node* next = node->next.load(std::memory_order_relaxed);
+    delete node;
+    node = next;
+  }
+}
+
+}  // namespace detail
+
+// Reclamation policies. A policy supplies nodes, takes them back after a pop, and decides when their memory may be
+// released:
+//   Node* acquire();          a node whose value is empty
+//   void retire(Node*);       node is unlinked and its value already moved out
+//   Guard protect();          held across the read of a node that another thread may retire
+//   void destroy(Node*);      single-threaded teardown of a node still linked in the structure
+// Policies report retires, list lengths and scans to ContentionCounters.h when counters are compiled in.
+
+// Default: type-stable node pool. Retired nodes go onto a lock-free free list and are reused by later pushes; memory
+// is only returned when the stack is destroyed, so a stale `next` read always hits a live Node and the tag rejects
+// the CAS. Footprint is bounded by the peak size.
+template <typename Node>
+class NodePoolReclamation {
+ private:
+  detail::TaggedHead<Node> freeList_;
+  [[no_unique_address]] contention::RetireListLength<> freeListLength_;
+
+ public:
+  struct Guard {};
+
+  NodePoolReclamation() = default;
+  NodePoolReclamation(const NodePoolReclamation&) = delete;
+  NodePoolReclamation& operator=(const NodePoolReclamation&) = delete;
+
+  ~NodePoolReclamation() { detail::deleteChain(detail::TaggedHead<Node>::pointer(freeList_.load())); }
+
+  Guard protect() { return {}; }
+
+  Node* acquire() {
+    Node* node = detail::popNode(freeList_, detail::kFreeList);
+    if (node == nullptr) {
+      return new Node();
+    }
+    freeListLength_.reused();
+    return node;
+  }
+
+  void retire(Node* node) {
+    contention::record(contention::Event::NodesRetired);
+    detail::pushNode(freeList_, node, detail::kFreeList);
+    freeListLength_.retired();
+  }
+
+  void destroy(Node* node) { delete node; }
+};
+
+// Retired nodes are parked and freed only when the stack is destroyed: always safe, but memory grows with the total
+// number of pops. Useful as a baseline. EpochReclamation (EpochReclamation.h) frees them while the stack is in use.
+template <typename Node>
+class DeferredReclamation {
+ private:
+  detail::TaggedHead<Node> retired_;
+  [[no_unique_address]] contention::RetireListLength<> retiredLength_;
+
+ public:
+  struct Guard {};
+
+  DeferredReclamation() = default;
+  DeferredReclamation(const DeferredReclamation&) = delete;
+  DeferredReclamation& operator=(const DeferredReclamation&) = delete;
+
+  ~DeferredReclamation() { detail::deleteChain(detail::TaggedHead<Node>::pointer(retired_.load())); }
+
+  Guard protect() { return {}; }
+
+  Node* acquire() { return new Node(); }
+
+  void retire(Node* node) {
+    contention::record(contention::Event::NodesRetired);
+    detail::pushNode(retired_, node, detail::kFreeList);
+    retiredLength_.retired();
+  }
+
+  void destroy(Node* node) { delete node; }
+};
+
+// Lock-free LIFO stack (Treiber) with an ABA-safe tagged head and pluggable node reclamation.
+//
+// pop() moves the value out, so T only needs to be move-constructible. There is deliberately no peek(): the top
+// node can be popped, and its value moved from, while another thread is reading it.
+template <typename T, template <typename> class Reclamation = NodePoolReclamation>
+class LockFreeStack {
+ private:
+  struct Node {
+    std::atomic<Node*> next{nullptr};
+    std::optional<T> value;
+  };
+
+  Reclamation<Node> reclamation_;
+  detail::TaggedHead<Node> head_;
+  std::atomic<std::size_t> size_{0};
+
+ public:
+  LockFreeStack() = default;
+  LockFreeStack(const LockFreeStack&) = delete;
+  LockFreeStack& operator=(const LockFreeStack&) = delete;
+
+  ~LockFreeStack() {
+    Node* node = detail::TaggedHead<Node>::pointer(head_.load());
+    while (node) {
+      Node* next = node->next.load(std::memory_order_relaxed);
+      reclamation_.destroy(node);
+      node = next;
+    }
+  }
+
+  void push(T value) { emplace(std::move(value)); }
+
+  template <typename... Args>
+  void emplace(Args&&... args) {
+    Node* node = reclamation_.acquire();
+    node->value.emplace(std::forward<Args>(args)...);
+    detail::pushNode(head_, node);
+    size_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] std::optional<T> pop() {
+    [[maybe_unused]] auto guard = reclamation_.protect();
+    Node* node = detail::popNode(head_);
+    if (!node) {
+      return std::nullopt;
+    }
+    std::optional<T> result(std::move(node->value));
+    node->value.reset();
+    size_.fetch_sub(1, std::memory_order_relaxed);
+    reclamation_.retire(node);
+    return result;
+  }
+
+  [[nodiscard]] bool tryPop(T& result) {
+    auto value = pop();
+    if (!value) {
+      return false;
+    }
+    result = std::move(*value);
+    return true;
+  }
+
+  [[nodiscard]] bool empty() const { return detail::TaggedHead<Node>::pointer(head_.load()) == nullptr; }
+
+  // Approximate under concurrency
+  [[nodiscard]] std::size_t size() const { return size_.load(std::memory_order_relaxed); }
+};
+
+}  // namespace lockfree
+
+#endif  // LOCK_FREE_STACK_H
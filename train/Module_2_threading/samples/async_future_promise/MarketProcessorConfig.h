@@ -0,0 +1,103 @@
+#ifndef MARKET_PROCESSOR_CONFIG_H
+#define MARKET_PROCESSOR_CONFIG_H
+
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+// Tunable parameters of RealTimeMarketProcessor. Immutable once published: a reload builds a new instance.
+struct MarketProcessorConfig {
+  double priceChangeThreshold{0.05};  // 5% price change threshold
+  std::size_t batchSize{100};
+  double emaAlpha{0.1};
+  int maxTickVolume{9500};
+
+  static constexpr std::size_t kMaxBatchSize = 65'536;
+
+ private:
+  // The whole value must be one number: no sign on unsigned fields, no trailing text, no inf/nan
+  template <typename Number>
+  static bool parseNumber(std::string_view text, Number& out) {
+    const auto first = text.find_first_not_of(" \t\r");
+    if (first == std::string_view::npos) {
+      return false;
+    }
+    text = text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+    Number value{};
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (error != std::errc{} || end != text.data() + text.size()) {
+      return false;
+    }
+    if constexpr (std::is_floating_point_v<Number>) {
+      if (!std::isfinite(value)) {
+        return false;
+      }
+    }
+    out = value;
+    return true;
+  }
+
+ public:
+  // `key = value` lines; '#' starts a comment. Keys that are not listed keep their defaults. Ranges:
+  // price_change_threshold and ema_alpha in (0, 1], batch_size in [1, kMaxBatchSize], max_tick_volume > 0.
+  static MarketProcessorConfig parse(std::istream& input) {
+    MarketProcessorConfig config;
+    std::string line;
+    for (int lineNumber = 1; std::getline(input, line); ++lineNumber) {
+      if (const auto comment = line.find('#'); comment != std::string::npos) {
+        line.erase(comment);
+      }
+      const auto equals = line.find('=');
+      std::istringstream keyStream(line.substr(0, equals));
+      std::string key;
+      if (!(keyStream >> key)) {
+        continue;  // blank line
+      }
+      if (std::string extra; keyStream >> extra) {
+        throw std::invalid_argument("MarketProcessorConfig: unexpected '" + extra + "' after '" + key + "' on line " +
+                                    std::to_string(lineNumber));
+      }
+      const std::string_view value =
+          equals == std::string::npos ? std::string_view{} : std::string_view(line).substr(equals + 1);
+
+      bool parsed = false;
+      if (key == "price_change_threshold") {
+        parsed = parseNumber(value, config.priceChangeThreshold) && config.priceChangeThreshold > 0.0 &&
+                 config.priceChangeThreshold <= 1.0;
+      } else if (key == "batch_size") {
+        parsed = parseNumber(value, config.batchSize) && config.batchSize > 0 && config.batchSize <= kMaxBatchSize;
+      } else if (key == "ema_alpha") {
+        parsed = parseNumber(value, config.emaAlpha) && config.emaAlpha > 0.0 && config.emaAlpha <= 1.0;
+      } else if (key == "max_tick_volume") {
+        parsed = parseNumber(value, config.maxTickVolume) && config.maxTickVolume > 0;
+      } else {
+        throw std::invalid_argument("MarketProcessorConfig: unknown key '" + key + "' on line " +
+                                    std::to_string(lineNumber));
+      }
+      if (!parsed) {
+        throw std::invalid_argument("MarketProcessorConfig: invalid value for '" + key + "' on line " +
+                                    std::to_string(lineNumber));
+      }
+    }
+    return config;
+  }
+
+  static MarketProcessorConfig load(const std::filesystem::path& path) {
+    std::ifstream input(path);
+    if (!input) {
+      throw std::runtime_error("MarketProcessorConfig: cannot open " + path.string());
+    }
+    return parse(input);
+  }
+};
+
+#endif  // MARKET_PROCESSOR_CONFIG_H
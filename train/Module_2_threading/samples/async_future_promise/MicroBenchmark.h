@@ -0,0 +1,318 @@
+#ifndef MICRO_BENCHMARK_H
+#define MICRO_BENCHMARK_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Shared measurement harness for the samples' benchmarks.
+//
+// One measurement = warmup runs, then repeated samples until a time budget is spent (within [minSamples,
+// maxSamples]). Bodies that finish faster than `minSampleTime` are batched so each sample is long enough for the
+// clock. Results are per-iteration nanoseconds summarised robustly: median, MAD, a distribution-free 95% confidence
+// interval for the median, and a count of outliers (further than 3 scaled MADs from the median). Speedups are only
+// called significant when the two intervals do not overlap.
+namespace microbench {
+
+// Keeps `value` (and everything it depends on) alive without the cost of a volatile store
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void* sink;
+  sink = &value;
+#endif
+}
+
+// Forces pending writes to memory to be treated as observable
+inline void ClobberMemory() {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : : "memory");
+#else
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+  int warmupRuns{2};
+  int minSamples{5};
+  int maxSamples{200};
+  std::chrono::nanoseconds timeBudget{std::chrono::milliseconds(200)};  // per measurement, after warmup
+  std::chrono::nanoseconds minSampleTime{std::chrono::microseconds(100)};
+};
+
+struct Summary {
+  std::string name;
+  std::size_t samples{0};
+  std::uint64_t iterationsPerSample{1};
+  double medianNanos{0.0};
+  double madNanos{0.0};  // median absolute deviation (unscaled)
+  double meanNanos{0.0};
+  double ciLowNanos{0.0};
+  double ciHighNanos{0.0};
+  double minNanos{0.0};
+  double maxNanos{0.0};
+  std::size_t outliers{0};
+
+  double medianMillis() const { return medianNanos / 1e6; }
+
+  // Half-width of the CI relative to the median; large values mean the numbers are noise
+  double relativeError() const {
+    return medianNanos == 0.0 ? 0.0 : (ciHighNanos - ciLowNanos) / (2.0 * medianNanos);
+  }
+};
+
+inline Summary summarize(std::string name, std::vector<double> perIteration, std::uint64_t iterationsPerSample) {
+  Summary summary;
+  summary.name = std::move(name);
+  summary.samples = perIteration.size();
+  summary.iterationsPerSample = iterationsPerSample;
+  if (perIteration.empty()) {
+    return summary;
+  }
+
+  std::sort(perIteration.begin(), perIteration.end());
+  const std::size_t n = perIteration.size();
+  const auto medianOf = [](const std::vector<double>& sorted) {
+    const std::size_t mid = sorted.size() / 2;
+    return sorted.size() % 2 == 1 ? sorted[mid] : (sorted[mid - 1] + sorted[mid]) / 2.0;
+  };
+
+  summary.medianNanos = medianOf(perIteration);
+  summary.minNanos = perIteration.front();
+  summary.maxNanos = perIteration.back();
+  double total = 0.0;
+  for (const double value : perIteration) {
+    total += value;
+  }
+  summary.meanNanos = total / static_cast<double>(n);
+
+  std::vector<double> deviations;
+  deviations.reserve(n);
+  for (const double value : perIteration) {
+    deviations.push_back(std::abs(value - summary.medianNanos));
+  }
+  std::sort(deviations.begin(), deviations.end());
+  summary.madNanos = medianOf(deviations);
+
+  // Order-statistic CI for the median: ranks n/2 -+ 1.96 * sqrt(n) / 2 (normal approximation to the binomial)
+  const double halfWidth = 1.96 * std::sqrt(static_cast<double>(n)) / 2.0;
+  const auto rank = [n](double r) {
+    return static_cast<std::size_t>(std::clamp(r, 0.0, static_cast<double>(n - 1)));
+  };
+  summary.ciLowNanos = perIteration[rank(std::floor(static_cast<double>(n) / 2.0 - halfWidth))];
+  summary.ciHighNanos = perIteration[rank(std::ceil(static_cast<double>(n) / 2.0 + halfWidth) - 1.0)];
+
+  const double outlierDistance = 3.0 * 1.4826 * summary.madNanos;
+  summary.outliers = static_cast<std::size_t>(std::count_if(perIteration.begin(), perIteration.end(), [&](double v) {
+    return std::abs(v - summary.medianNanos) > outlierDistance;
+  }));
+  return summary;
+}
+
+struct Comparison {
+  double speedup;     // baseline median / candidate median
+  bool significant;   // confidence intervals do not overlap
+};
+
+inline Comparison compare(const Summary& baseline, const Summary& candidate) {
+  const double speedup = candidate.medianNanos == 0.0 ? 0.0 : baseline.medianNanos / candidate.medianNanos;
+  const bool significant =
+      baseline.ciLowNanos > candidate.ciHighNanos || candidate.ciLowNanos > baseline.ciHighNanos;
+  return Comparison{speedup, significant};
+}
+
+// Times `body()` itself. Fast bodies are run several times per sample (auto-calibrated).
+template <typename Body>
+Summary measure(std::string name, Body&& body, const Options& options = {}) {
+  for (int run = 0; run < options.warmupRuns; ++run) {
+    body();
+    ClobberMemory();
+  }
+
+  // Calibrate the batch size so one sample spans at least minSampleTime
+  std::uint64_t iterations = 1;
+  while (true) {
+    const auto start = Clock::now();
+    for (std::uint64_t it = 0; it < iterations; ++it) {
+      body();
+    }
+    ClobberMemory();
+    const auto elapsed = Clock::now() - start;
+    if (elapsed >= options.minSampleTime || iterations >= (std::uint64_t{1} << 30)) {
+      break;
+    }
+    const auto ratio = elapsed.count() <= 0 ? 16 : static_cast<std::uint64_t>(options.minSampleTime / elapsed) + 1;
+    iterations *= std::clamp<std::uint64_t>(ratio, 2, 16);
+  }
+
+  std::vector<double> perIteration;
+  const auto deadline = Clock::now() + options.timeBudget;
+  while (static_cast<int>(perIteration.size()) < options.maxSamples &&
+         (static_cast<int>(perIteration.size()) < options.minSamples || Clock::now() < deadline)) {
+    const auto start = Clock::now();
+    for (std::uint64_t it = 0; it < iterations; ++it) {
+      body();
+    }
+    ClobberMemory();
+    const std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+    perIteration.push_back(elapsed.count() / static_cast<double>(iterations));
+  }
+  return summarize(std::move(name), std::move(perIteration), iterations);
+}
+
+// For bodies that time their own critical section (e.g. excluding thread start-up) and return it as a duration
+template <typename Body>
+Summary measureTimed(std::string name, Body&& body, const Options& options = {}) {
+  for (int run = 0; run < options.warmupRuns; ++run) {
+    DoNotOptimize(body());
+  }
+
+  std::vector<double> perIteration;
+  const auto deadline = Clock::now() + options.timeBudget;
+  while (static_cast<int>(perIteration.size()) < options.maxSamples &&
+         (static_cast<int>(perIteration.size()) < options.minSamples || Clock::now() < deadline)) {
+    const std::chrono::duration<double, std::nano> elapsed = body();
+    perIteration.push_back(elapsed.count());
+  }
+  return summarize(std::move(name), std::move(perIteration), 1);
+}
+
+enum class Format { Table, Csv, Json };
+
+// `--csv` / `--json` on the command line switch the report format
+inline Format formatFromArgs(int argc, char* argv[]) {
+  for (int idx = 1; idx < argc; ++idx) {
+    const std::string_view arg(argv[idx]);
+    if (arg == "--csv") {
+      return Format::Csv;
+    }
+    if (arg == "--json") {
+      return Format::Json;
+    }
+  }
+  return Format::Table;
+}
+
+inline std::string jsonEscape(std::string_view text) {
+  static constexpr char kHex[] = "0123456789abcdef";
+  std::string escaped;
+  for (const char c : text) {
+    const auto byte = static_cast<unsigned char>(c);
+    if (byte < 0x20) {
+      escaped += "\\u00";
+      escaped += kHex[byte >> 4];
+      escaped += kHex[byte & 0xf];
+      continue;
+    }
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+    }
+    escaped += c;
+  }
+  return escaped;
+}
+
+inline std::string csvEscape(std::string_view text) {
+  std::string escaped;
+  for (const char c : text) {
+    escaped += c;
+    if (c == '"') {
+      escaped += '"';
+    }
+  }
+  return escaped;
+}
+
+// Puts back the caller's flags, precision and fill when a writer returns
+class StreamFormatGuard {
+ public:
+  explicit StreamFormatGuard(std::ostream& out)
+      : out_(out), flags_(out.flags()), precision_(out.precision()), fill_(out.fill()) {}
+  ~StreamFormatGuard() {
+    out_.flags(flags_);
+    out_.precision(precision_);
+    out_.fill(fill_);
+  }
+  StreamFormatGuard(const StreamFormatGuard&) = delete;
+  StreamFormatGuard& operator=(const StreamFormatGuard&) = delete;
+
+ private:
+  std::ostream& out_;
+  std::ios_base::fmtflags flags_;
+  std::streamsize precision_;
+  char fill_;
+};
+
+inline void writeTable(std::ostream& out, const std::vector<Summary>& summaries) {
+  const StreamFormatGuard guard(out);
+  out << std::left << std::setw(48) << "Benchmark" << std::right << std::setw(14) << "median(ns)" << std::setw(12)
+      << "MAD(ns)" << std::setw(26) << "95% CI(ns)" << std::setw(9) << "+-%" << std::setw(9) << "samples"
+      << std::setw(10) << "outliers" << std::endl;
+  out << std::string(128, '-') << std::endl;
+  for (const auto& s : summaries) {
+    std::ostringstream ci;
+    ci << std::fixed << std::setprecision(0) << "[" << s.ciLowNanos << ", " << s.ciHighNanos << "]";
+    out << std::left << std::setw(48) << s.name << std::right << std::fixed << std::setprecision(0) << std::setw(14)
+        << s.medianNanos << std::setw(12) << s.madNanos << std::setw(26) << ci.str() << std::setprecision(1)
+        << std::setw(9) << s.relativeError() * 100.0 << std::setw(9) << s.samples << std::setw(10) << s.outliers
+        << std::endl;
+  }
+}
+
+inline void writeCsv(std::ostream& out, const std::vector<Summary>& summaries) {
+  const StreamFormatGuard guard(out);
+  out.precision(12);
+  out << "name,samples,iterations_per_sample,median_ns,mad_ns,mean_ns,ci_low_ns,ci_high_ns,min_ns,max_ns,outliers\n";
+  for (const auto& s : summaries) {
+    out << '"' << csvEscape(s.name) << '"' << ',' << s.samples << ',' << s.iterationsPerSample << ','
+        << s.medianNanos << ',' << s.madNanos << ',' << s.meanNanos << ',' << s.ciLowNanos << ',' << s.ciHighNanos
+        << ',' << s.minNanos << ',' << s.maxNanos << ',' << s.outliers << '\n';
+  }
+}
+
+inline void writeJson(std::ostream& out, const std::vector<Summary>& summaries) {
+  const StreamFormatGuard guard(out);
+  out.precision(12);
+  out << "[\n";
+  for (std::size_t idx = 0; idx < summaries.size(); ++idx) {
+    const auto& s = summaries[idx];
+    out << "  {\"name\": \"" << jsonEscape(s.name) << "\", \"samples\": " << s.samples
+        << ", \"iterations_per_sample\": " << s.iterationsPerSample << ", \"median_ns\": " << s.medianNanos
+        << ", \"mad_ns\": " << s.madNanos << ", \"mean_ns\": " << s.meanNanos << ", \"ci_low_ns\": " << s.ciLowNanos
+        << ", \"ci_high_ns\": " << s.ciHighNanos << ", \"min_ns\": " << s.minNanos << ", \"max_ns\": " << s.maxNanos
+        << ", \"outliers\": " << s.outliers << "}" << (idx + 1 < summaries.size() ? "," : "") << "\n";
+  }
+  out << "]\n";
+}
+
+inline void write(std::ostream& out, const std::vector<Summary>& summaries, Format format) {
+  switch (format) {
+    case Format::Table:
+      writeTable(out, summaries);
+      break;
+    case Format::Csv:
+      writeCsv(out, summaries);
+      break;
+    case Format::Json:
+      writeJson(out, summaries);
+      break;
+  }
+}
+
+}  // namespace microbench
+
+#endif  // MICRO_BENCHMARK_H
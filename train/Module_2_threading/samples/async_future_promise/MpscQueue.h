@@ -0,0 +1,80 @@
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <atomic>
+#include <concepts>
+
+namespace lockfree {
+
+// Hook for IntrusiveMpscQueue: derive the element type from it
+struct MpscNode {
+  std::atomic<MpscNode*> next{nullptr};
+};
+
+// Vyukov's intrusive multi-producer / single-consumer queue.
+//
+// The queue links the caller's nodes and never allocates. push() is wait-free: one exchange on head_ plus one store
+// into the previous node. pop() belongs to a single consumer thread (at a time) and needs no atomic read-modify-write
+// except when it recycles the stub. A producer preempted between its two steps briefly hides everything pushed after
+// it: pop() returns nullptr although empty() is false, and the consumer should simply try again later.
+//
+// A node must not be pushed again until it has been popped; the queue does not own nodes and never frees them.
+template <typename T>
+  requires std::derived_from<T, MpscNode>
+class IntrusiveMpscQueue {
+ private:
+  alignas(64) std::atomic<MpscNode*> head_;  // producers: most recently pushed node
+  alignas(64) MpscNode* tail_;               // consumer: oldest node not yet popped
+  MpscNode stub_;
+
+ public:
+  IntrusiveMpscQueue() : head_(&stub_), tail_(&stub_) {}
+
+  IntrusiveMpscQueue(const IntrusiveMpscQueue&) = delete;
+  IntrusiveMpscQueue& operator=(const IntrusiveMpscQueue&) = delete;
+
+  void push(T* item) { pushNode(item); }
+
+  // Consumer only
+  T* pop() {
+    MpscNode* tail = tail_;
+    MpscNode* next = tail->next.load(std::memory_order_acquire);
+    if (tail == &stub_) {
+      if (next == nullptr) {
+        return nullptr;
+      }
+      tail_ = next;
+      tail = next;
+      next = next->next.load(std::memory_order_acquire);
+    }
+    if (next != nullptr) {
+      tail_ = next;
+      return static_cast<T*>(tail);
+    }
+    // `tail` is the last linked node: unless a push is mid-flight, park the stub behind it so it can be handed out
+    if (tail != head_.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    pushNode(&stub_);
+    next = tail->next.load(std::memory_order_acquire);
+    if (next != nullptr) {
+      tail_ = next;
+      return static_cast<T*>(tail);
+    }
+    return nullptr;
+  }
+
+  // Consumer only; a push in flight counts as non-empty
+  bool empty() const { return tail_ == &stub_ && head_.load(std::memory_order_acquire) == &stub_; }
+
+ private:
+  void pushNode(MpscNode* node) {
+    node->next.store(nullptr, std::memory_order_relaxed);
+    MpscNode* previous = head_.exchange(node, std::memory_order_acq_rel);
+    previous->next.store(node, std::memory_order_release);
+  }
+};
+
+}  // namespace lockfree
+
+#endif  // MPSC_QUEUE_H
@@ -0,0 +1,167 @@
+#ifndef MULTI_QUEUE_H
+#define MULTI_QUEUE_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "SpinLocks.h"
+
+namespace relaxed {
+
+// Relaxed concurrent priority queue (Rihani, Sanders and Dementiev's MultiQueue).
+//
+// Instead of one heap behind one lock, the queue keeps `lanes` independent heaps, each with its own lock and an
+// atomic copy of its top key. push() drops the element into a random lane; pop() looks at the cached tops of
+// `candidates` random lanes and pops from the best of them. Threads rarely meet on the same lock, so push and pop
+// scale with the thread count. The price is ordering: pop() returns an element that is near the top, not
+// necessarily the top. The expected rank error grows with the lane count and shrinks with more candidates; the usual
+// setting is lanes = c * threads with c = 2 and two candidates.
+//
+// KeyOf maps an element to its priority as a std::uint64_t: larger keys pop first, and keys must be non-zero (zero
+// marks an empty lane). Equal keys come out in no particular order.
+template <typename T, typename KeyOf, typename Mutex = locks::TtasSpinLock>
+class MultiQueue {
+ public:
+  static constexpr std::uint64_t kEmptyKey = 0;
+  static constexpr std::size_t kMaxCandidates = 8;
+
+ private:
+  struct Entry {
+    std::uint64_t key;
+    T value;
+
+    bool operator<(const Entry& other) const { return key < other.key; }
+  };
+
+  struct alignas(64) Lane {
+    Mutex mutex;
+    std::priority_queue<Entry> heap;
+    std::atomic<std::uint64_t> topKey{kEmptyKey};  // written under mutex, read without it
+
+    void publishTop() { topKey.store(heap.empty() ? kEmptyKey : heap.top().key, std::memory_order_release); }
+  };
+
+  std::unique_ptr<Lane[]> lanes_;
+  const std::size_t laneCount_;
+  const std::size_t candidates_;
+  std::atomic<std::size_t> size_{0};
+
+  // xorshift64*: per-thread, seeded from the thread's own address so threads start on different lanes
+  static std::size_t randomIndex(std::size_t bound) {
+    thread_local std::uint64_t state = reinterpret_cast<std::uintptr_t>(&state) | 1;
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return static_cast<std::size_t>(((state * 0x2545F4914F6CDD1DULL) >> 32) % bound);
+  }
+
+  // Best cached top among `candidates_` distinct random lanes; falls back to every lane when none of them has a key
+  // >= minKey
+  Lane* pickLane(std::uint64_t minKey) {
+    Lane* best = nullptr;
+    std::uint64_t bestKey = kEmptyKey;
+    if (candidates_ < laneCount_) {
+      std::array<std::size_t, kMaxCandidates> picked{};
+      for (std::size_t pick = 0; pick < candidates_; ++pick) {
+        std::size_t idx = randomIndex(laneCount_);
+        while (std::find(picked.begin(), picked.begin() + pick, idx) != picked.begin() + pick) {
+          idx = randomIndex(laneCount_);
+        }
+        picked[pick] = idx;
+        const std::uint64_t key = lanes_[idx].topKey.load(std::memory_order_acquire);
+        if (key >= minKey && key > bestKey) {
+          best = &lanes_[idx];
+          bestKey = key;
+        }
+      }
+      if (best != nullptr) {
+        return best;
+      }
+    }
+    // Nothing eligible in the sample (or the sample is every lane): look at all of them
+    for (std::size_t idx = 0; idx < laneCount_; ++idx) {
+      const std::uint64_t key = lanes_[idx].topKey.load(std::memory_order_acquire);
+      if (key >= minKey && key > bestKey) {
+        best = &lanes_[idx];
+        bestKey = key;
+      }
+    }
+    return best;
+  }
+
+ public:
+  explicit MultiQueue(std::size_t lanes, std::size_t candidates = 2)
+      : lanes_(std::make_unique<Lane[]>(std::max<std::size_t>(lanes, 1))),
+        laneCount_(std::max<std::size_t>(lanes, 1)),
+        candidates_(std::clamp<std::size_t>(candidates, 1, kMaxCandidates)) {}
+
+  MultiQueue(const MultiQueue&) = delete;
+  MultiQueue& operator=(const MultiQueue&) = delete;
+
+  // Skips lanes whose lock is taken instead of waiting for them, until it has been turned away once per lane
+  void push(T value) {
+    const std::uint64_t key = KeyOf{}(value);
+    for (std::size_t attempt = 0;; ++attempt) {
+      Lane& lane = lanes_[randomIndex(laneCount_)];
+      std::unique_lock<Mutex> lock(lane.mutex, std::defer_lock);
+      if (attempt < laneCount_) {
+        if (!lock.try_lock()) {
+          continue;
+        }
+      } else {
+        lock.lock();
+      }
+      lane.heap.push(Entry{key, std::move(value)});
+      lane.publishTop();
+      size_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+  }
+
+  // Pops a near-top element whose key is at least `minKey`; false when no lane has one
+  bool tryPop(T& value, std::uint64_t minKey = kEmptyKey + 1) {
+    for (std::size_t attempt = 0;; ++attempt) {
+      Lane* lane = pickLane(minKey);
+      if (lane == nullptr) {
+        return false;
+      }
+      std::unique_lock<Mutex> lock(lane->mutex, std::defer_lock);
+      if (attempt < laneCount_) {
+        if (!lock.try_lock()) {
+          continue;
+        }
+      } else {
+        lock.lock();
+      }
+      // The cached top may be stale by now
+      if (lane->heap.empty() || lane->heap.top().key < minKey) {
+        continue;
+      }
+      value = std::move(const_cast<Entry&>(lane->heap.top()).value);
+      lane->heap.pop();
+      lane->publishTop();
+      size_.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+
+  std::size_t size() const { return size_.load(std::memory_order_relaxed); }
+
+  bool empty() const { return size() == 0; }
+
+  std::size_t lanes() const { return laneCount_; }
+
+  std::size_t candidates() const { return candidates_; }
+};
+
+}  // namespace relaxed
+
+#endif  // MULTI_QUEUE_H
@@ -0,0 +1,208 @@
+#ifndef MULTICAST_RING_BUFFER_H
+#define MULTICAST_RING_BUFFER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <stop_token>
+#include <thread>
+#include <utility>
+
+// Disruptor-style single-writer ring: every registered consumer reads the same pre-allocated slot, so fan-out to N
+// consumers costs one write and N reads. Each consumer owns a sequence cursor and may depend on other consumers
+// (dependency barrier), e.g. "indicator runs after price-table". The writer is gated by the slowest consumer.
+//
+// Consumers must be registered before the first publish. halt() is the alert that ends the ring: the writer stops
+// waiting for space and consumers leave run(). A consumer leaving run() halts the ring itself, since the writer would
+// otherwise wait forever for that consumer's cursor once it is a full lap ahead.
+template <typename T, std::size_t Capacity>
+class MulticastRingBuffer {
+  static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+ public:
+  using ConsumerId = std::size_t;
+  static constexpr std::size_t kMaxConsumers = 8;
+
+ private:
+  static constexpr std::size_t kMask = Capacity - 1;
+  static constexpr std::int64_t kInitialSequence = -1;
+
+  // One cache line per cursor so consumers never false-share their progress
+  struct alignas(64) Sequence {
+    std::atomic<std::int64_t> value{kInitialSequence};
+  };
+
+  struct ConsumerSlot {
+    Sequence sequence;
+    std::array<ConsumerId, kMaxConsumers> dependencies{};
+    std::size_t dependencyCount{0};
+  };
+
+  std::unique_ptr<T[]> slots_;
+  Sequence cursor_;  // last published sequence
+
+  // Writer-private state, kept on its own line
+  alignas(64) std::int64_t nextSequence_{0};
+  std::int64_t cachedGatingSequence_{kInitialSequence};
+
+  std::array<ConsumerSlot, kMaxConsumers> consumers_;
+  std::atomic<std::size_t> consumerCount_{0};
+  std::atomic<bool> halted_{false};
+
+  std::int64_t minimumConsumerSequence() const {
+    std::int64_t minimum = cursor_.value.load(std::memory_order_relaxed);
+    const std::size_t count = consumerCount_.load(std::memory_order_acquire);
+    for (std::size_t idx = 0; idx < count; ++idx) {
+      const auto seq = consumers_[idx].sequence.value.load(std::memory_order_acquire);
+      if (seq < minimum) {
+        minimum = seq;
+      }
+    }
+    return minimum;
+  }
+
+  // Highest sequence the consumer may read: bounded by the writer cursor and every upstream consumer
+  std::int64_t availableFor(ConsumerId id) const {
+    std::int64_t available = cursor_.value.load(std::memory_order_acquire);
+    const auto& consumer = consumers_[id];
+    for (std::size_t idx = 0; idx < consumer.dependencyCount; ++idx) {
+      const auto seq = consumers_[consumer.dependencies[idx]].sequence.value.load(std::memory_order_acquire);
+      if (seq < available) {
+        available = seq;
+      }
+    }
+    return available;
+  }
+
+ public:
+  MulticastRingBuffer() : slots_(std::make_unique<T[]>(Capacity)) {}
+
+  MulticastRingBuffer(const MulticastRingBuffer&) = delete;
+  MulticastRingBuffer& operator=(const MulticastRingBuffer&) = delete;
+
+  ConsumerId addConsumer(std::initializer_list<ConsumerId> dependsOn = {}) {
+    const std::size_t id = consumerCount_.load(std::memory_order_relaxed);
+    if (id >= kMaxConsumers) {
+      throw std::length_error("MulticastRingBuffer: too many consumers");
+    }
+
+    auto& consumer = consumers_[id];
+    for (ConsumerId dependency : dependsOn) {
+      if (dependency >= id) {
+        throw std::invalid_argument("MulticastRingBuffer: dependencies must be registered first");
+      }
+      consumer.dependencies[consumer.dependencyCount++] = dependency;
+    }
+    consumer.sequence.value.store(cursor_.value.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+    consumerCount_.store(id + 1, std::memory_order_release);
+    return id;
+  }
+
+  // Writer side: claim the next slot (spinning while the slowest consumer is a full lap behind),
+  // fill it in place, then publish it. Empty once the ring is halted while waiting for space.
+  std::optional<std::int64_t> claim() {
+    const std::int64_t sequence = nextSequence_;
+    const std::int64_t wrapPoint = sequence - static_cast<std::int64_t>(Capacity);
+
+    if (wrapPoint > cachedGatingSequence_) {
+      std::int64_t gating = minimumConsumerSequence();
+      while (wrapPoint > gating) {
+        if (halted()) {
+          return std::nullopt;
+        }
+        std::this_thread::yield();
+        gating = minimumConsumerSequence();
+      }
+      cachedGatingSequence_ = gating;
+    }
+
+    ++nextSequence_;
+    return sequence;
+  }
+
+  T& slot(std::int64_t sequence) { return slots_[static_cast<std::size_t>(sequence) & kMask]; }
+
+  void publish(std::int64_t sequence) { cursor_.value.store(sequence, std::memory_order_release); }
+
+  // False if the ring was halted before a slot freed up; the item is dropped
+  bool publish(const T& item) {
+    const auto sequence = claim();
+    if (!sequence) {
+      return false;
+    }
+    slot(*sequence) = item;
+    publish(*sequence);
+    return true;
+  }
+
+  void halt() { halted_.store(true, std::memory_order_release); }
+
+  bool halted() const { return halted_.load(std::memory_order_acquire); }
+
+  // Consumer side: hand every available entry to `handler(const T&, sequence, endOfBatch)` and advance the
+  // consumer's cursor once per batch. Returns the number of entries handled.
+  template <typename Handler>
+  std::size_t poll(ConsumerId id, Handler&& handler) {
+    auto& sequence = consumers_[id].sequence.value;
+    const std::int64_t next = sequence.load(std::memory_order_relaxed) + 1;
+    const std::int64_t available = availableFor(id);
+    if (available < next) {
+      return 0;
+    }
+
+    for (std::int64_t seq = next; seq <= available; ++seq) {
+      handler(static_cast<const T&>(slots_[static_cast<std::size_t>(seq) & kMask]), seq, seq == available);
+    }
+
+    sequence.store(available, std::memory_order_release);
+    return static_cast<std::size_t>(available - next + 1);
+  }
+
+  // Run a consumer until stop is requested or the ring is halted, then halt it: spin briefly, then back off to short
+  // sleeps when idle. `onIdle()` runs each time a poll finds nothing, e.g. to report a quiescent state while no
+  // entries arrive.
+  template <typename Handler, typename IdleHandler>
+  void run(ConsumerId id, std::stop_token stopToken, Handler&& handler, IdleHandler&& onIdle) {
+    int idleSpins = 0;
+    while (!stopToken.stop_requested() && !halted()) {
+      if (poll(id, handler) > 0) {
+        idleSpins = 0;
+        continue;
+      }
+      onIdle();
+      if (++idleSpins < 64) {
+        std::this_thread::yield();
+      } else {
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+      }
+    }
+    halt();
+  }
+
+  template <typename Handler>
+  void run(ConsumerId id, std::stop_token stopToken, Handler&& handler) {
+    run(id, stopToken, std::forward<Handler>(handler), []() {});
+  }
+
+  std::int64_t publishedSequence() const { return cursor_.value.load(std::memory_order_acquire); }
+
+  std::int64_t consumerSequence(ConsumerId id) const {
+    return consumers_[id].sequence.value.load(std::memory_order_acquire);
+  }
+
+  // Entries published but not yet seen by the slowest consumer
+  std::size_t backlog() const {
+    return static_cast<std::size_t>(publishedSequence() - minimumConsumerSequence());
+  }
+
+  static constexpr std::size_t capacity() { return Capacity; }
+};
+
+#endif  // MULTICAST_RING_BUFFER_H
@@ -0,0 +1,189 @@
+#ifndef POSITION_RISK_TABLE_H
+#define POSITION_RISK_TABLE_H
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+
+// Per-symbol position and notional limits that many execution threads can check concurrently.
+//
+// Each symbol owns one cache line. Position (signed shares) and gross notional (whole currency units) are packed into
+// one 64-bit word and updated with a single CAS, so a pre-trade check plus reservation is constant time, never takes a
+// lock and can never observe a position without its matching notional. The symbol -> id map is an insert-only open
+// addressing table probed by the symbol's hash. Each slot also stores the symbol itself (up to kMaxSymbolLength
+// bytes), so two symbols whose hashes collide get separate slots; a lookup that meets a slot whose name is still
+// being written waits for those few bytes to be published.
+class PositionRiskTable {
+ public:
+  static constexpr std::size_t kInvalidId = static_cast<std::size_t>(-1);
+  static constexpr std::size_t kMaxSymbolLength = 22;
+
+  enum class Decision { Accepted, PositionLimit, NotionalLimit, NoPrice };
+
+  struct Limits {
+    std::int32_t maxPosition{10'000};
+    std::uint32_t maxNotional{1'000'000};
+  };
+
+  struct Exposure {
+    std::int32_t position;
+    std::uint32_t notional;
+    double markPrice;
+  };
+
+ private:
+  static constexpr std::uint64_t kEmptyKey = 0;
+
+  struct alignas(64) Slot {
+    std::atomic<std::uint64_t> key{kEmptyKey};  // symbol hash, claimed once by CAS
+    std::atomic<std::uint64_t> state{0};        // [position:int32][notional:uint32]
+    std::atomic<double> markPrice{0.0};
+    std::atomic<std::int32_t> maxPosition{0};    // 0: use the table default
+    std::atomic<std::uint32_t> maxNotional{0};  // 0: use the table default
+    std::atomic<bool> named{false};             // symbol/symbolLength written by the claiming thread
+    std::uint8_t symbolLength{0};
+    char symbol[kMaxSymbolLength];
+  };
+  static_assert(sizeof(Slot) == 64, "one cache line per symbol");
+
+  std::size_t capacity_;
+  std::size_t mask_;
+  Limits defaults_;
+  std::unique_ptr<Slot[]> slots_;
+  std::atomic<std::uint64_t> casRetries_{0};
+
+  static std::uint64_t pack(std::int32_t position, std::uint32_t notional) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(position)) << 32) | notional;
+  }
+
+  static std::int32_t positionOf(std::uint64_t state) { return static_cast<std::int32_t>(state >> 32); }
+
+  static std::uint32_t notionalOf(std::uint64_t state) { return static_cast<std::uint32_t>(state); }
+
+  static std::uint32_t toNotionalUnits(double notional) {
+    return static_cast<std::uint32_t>(std::lround(std::min(notional, 4'294'967'295.0)));
+  }
+
+  static std::uint64_t keyFor(std::string_view symbol) {
+    const std::uint64_t hash = std::hash<std::string_view>{}(symbol);
+    return hash == kEmptyKey ? 1 : hash;
+  }
+
+  // Waits out a concurrent insert that has claimed the slot but not yet written the name
+  static bool holds(const Slot& slot, std::string_view symbol) {
+    while (!slot.named.load(std::memory_order_acquire)) {
+    }
+    return std::string_view(slot.symbol, slot.symbolLength) == symbol;
+  }
+
+ public:
+  PositionRiskTable(std::size_t maxSymbols, Limits defaults)
+      : capacity_(std::bit_ceil(maxSymbols * 2)),
+        mask_(capacity_ - 1),
+        defaults_(defaults),
+        slots_(std::make_unique<Slot[]>(capacity_)) {
+    if (maxSymbols == 0) {
+      throw std::invalid_argument("PositionRiskTable: maxSymbols must be positive");
+    }
+  }
+
+  explicit PositionRiskTable(std::size_t maxSymbols) : PositionRiskTable(maxSymbols, Limits{}) {}
+
+  // Lookup-or-insert; kInvalidId when the table is full or the symbol is longer than kMaxSymbolLength
+  std::size_t symbolId(std::string_view symbol) {
+    if (symbol.size() > kMaxSymbolLength) {
+      return kInvalidId;
+    }
+    const std::uint64_t key = keyFor(symbol);
+    for (std::size_t probe = 0; probe < capacity_; ++probe) {
+      const std::size_t index = (key + probe) & mask_;
+      Slot& slot = slots_[index];
+      std::uint64_t current = slot.key.load(std::memory_order_acquire);
+      if (current == kEmptyKey &&
+          slot.key.compare_exchange_strong(current, key, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        std::memcpy(slot.symbol, symbol.data(), symbol.size());
+        slot.symbolLength = static_cast<std::uint8_t>(symbol.size());
+        slot.named.store(true, std::memory_order_release);
+        return index;
+      }
+      // Same hash is not enough: a colliding symbol keeps probing
+      if (current == key && holds(slot, symbol)) {
+        return index;
+      }
+    }
+    return kInvalidId;
+  }
+
+  void setLimits(std::size_t id, Limits limits) {
+    slots_[id].maxPosition.store(limits.maxPosition, std::memory_order_relaxed);
+    slots_[id].maxNotional.store(limits.maxNotional, std::memory_order_relaxed);
+  }
+
+  // Tick path: latest price used to value positions
+  void markPrice(std::size_t id, double price) { slots_[id].markPrice.store(price, std::memory_order_relaxed); }
+
+  // Pre-trade check and reservation in one CAS. Trades that reduce |position| are always allowed.
+  Decision tryApply(std::size_t id, std::int32_t quantity) {
+    Slot& slot = slots_[id];
+    const double price = slot.markPrice.load(std::memory_order_relaxed);
+    if (price <= 0.0) {
+      return Decision::NoPrice;
+    }
+    const std::int32_t maxPosition = slot.maxPosition.load(std::memory_order_relaxed);
+    const std::uint32_t maxNotional = slot.maxNotional.load(std::memory_order_relaxed);
+    const std::int64_t positionLimit = maxPosition != 0 ? maxPosition : defaults_.maxPosition;
+    const double notionalLimit = maxNotional != 0 ? maxNotional : defaults_.maxNotional;
+
+    std::uint64_t current = slot.state.load(std::memory_order_relaxed);
+    while (true) {
+      const std::int64_t position = positionOf(current);
+      const std::int64_t next = position + quantity;
+      const bool reducing = std::llabs(next) <= std::llabs(position);
+      const double notional = static_cast<double>(std::llabs(next)) * price;
+
+      if (!reducing) {
+        if (std::llabs(next) > positionLimit) {
+          return Decision::PositionLimit;
+        }
+        if (notional > notionalLimit) {
+          return Decision::NotionalLimit;
+        }
+      }
+
+      const auto desired = pack(static_cast<std::int32_t>(next), toNotionalUnits(notional));
+      if (slot.state.compare_exchange_weak(current, desired, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+        return Decision::Accepted;
+      }
+      casRetries_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  // Undo a reservation that was not executed
+  void release(std::size_t id, std::int32_t quantity) {
+    Slot& slot = slots_[id];
+    const double price = slot.markPrice.load(std::memory_order_relaxed);
+    std::uint64_t current = slot.state.load(std::memory_order_relaxed);
+    std::uint64_t desired;
+    do {
+      const std::int64_t next = static_cast<std::int64_t>(positionOf(current)) - quantity;
+      desired = pack(static_cast<std::int32_t>(next), toNotionalUnits(static_cast<double>(std::llabs(next)) * price));
+    } while (!slot.state.compare_exchange_weak(current, desired, std::memory_order_acq_rel, std::memory_order_relaxed));
+  }
+
+  Exposure exposure(std::size_t id) const {
+    const std::uint64_t state = slots_[id].state.load(std::memory_order_acquire);
+    return Exposure{positionOf(state), notionalOf(state), slots_[id].markPrice.load(std::memory_order_relaxed)};
+  }
+
+  std::uint64_t casRetries() const { return casRetries_.load(std::memory_order_relaxed); }
+};
+
+#endif  // POSITION_RISK_TABLE_H
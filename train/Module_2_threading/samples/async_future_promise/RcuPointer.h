@@ -0,0 +1,160 @@
+#ifndef RCU_POINTER_H
+#define RCU_POINTER_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+// Read-mostly value published through an atomic pointer, with quiescent-state based reclamation (QSBR, the
+// userspace flavour of RCU).
+//
+// Readers pay one acquire load per access and never lock or write shared memory. In exchange every thread that
+// dereferences the pointer registers a Reader and calls quiescent() at points where it holds no reference (between
+// ticks, at the end of a batch). A writer swaps in a new value and retires the old one; the old value is deleted once
+// every online reader has passed a quiescent state after the swap, so no reader can still see it.
+//
+// Threads that are not registered must not keep the pointer: copy the fields they need instead.
+template <typename T, std::size_t MaxReaders = 32>
+class RcuPointer {
+ private:
+  static constexpr std::uint64_t kOffline = 0;
+
+  struct alignas(64) ReaderSlot {
+    std::atomic<bool> claimed{false};
+    std::atomic<std::uint64_t> seenEpoch{kOffline};  // last epoch observed at a quiescent point, 0 while offline
+  };
+
+  struct Retired {
+    std::uint64_t epoch;
+    std::unique_ptr<const T> value;
+  };
+
+  std::atomic<const T*> current_;
+  std::atomic<std::uint64_t> epoch_{1};
+  std::array<ReaderSlot, MaxReaders> readers_;
+
+  mutable std::mutex writerMutex_;
+  std::deque<Retired> retired_;  // ordered by epoch
+  std::atomic<std::uint64_t> reclaimed_{0};
+
+  std::size_t reclaimLocked() {
+    std::uint64_t oldestSeen = epoch_.load(std::memory_order_seq_cst);
+    for (const auto& reader : readers_) {
+      const std::uint64_t seen = reader.seenEpoch.load(std::memory_order_seq_cst);
+      if (seen != kOffline && seen < oldestSeen) {
+        oldestSeen = seen;
+      }
+    }
+    std::size_t freed = 0;
+    while (!retired_.empty() && retired_.front().epoch <= oldestSeen) {
+      retired_.pop_front();
+      ++freed;
+    }
+    reclaimed_.fetch_add(freed, std::memory_order_relaxed);
+    return freed;
+  }
+
+ public:
+  // RAII registration of one reader thread; not shareable between threads
+  class Reader {
+   private:
+    RcuPointer* owner_;
+    ReaderSlot* slot_;
+
+   public:
+    Reader(RcuPointer& owner, ReaderSlot& slot) : owner_(&owner), slot_(&slot) { online(); }
+
+    Reader(Reader&& other) noexcept : owner_(other.owner_), slot_(std::exchange(other.slot_, nullptr)) {}
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+    Reader& operator=(Reader&&) = delete;
+
+    ~Reader() {
+      if (slot_ != nullptr) {
+        offline();
+        slot_->claimed.store(false, std::memory_order_release);
+      }
+    }
+
+    // One acquire load; valid until this reader's next quiescent() or offline()
+    const T& operator*() const { return *owner_->current_.load(std::memory_order_acquire); }
+    const T* operator->() const { return owner_->current_.load(std::memory_order_acquire); }
+
+    // Declares that no reference obtained so far is still in use
+    void quiescent() {
+      slot_->seenEpoch.store(owner_->epoch_.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    // For long blocking waits: an offline reader never delays reclamation
+    void offline() { slot_->seenEpoch.store(kOffline, std::memory_order_seq_cst); }
+
+    void online() {
+      slot_->seenEpoch.store(owner_->epoch_.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+      // Either a concurrent writer sees this reader online, or the reader's next load sees that writer's value
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+  };
+
+  explicit RcuPointer(std::unique_ptr<T> initial) : current_(initial.release()) {
+    if (current_.load(std::memory_order_relaxed) == nullptr) {
+      throw std::invalid_argument("RcuPointer: initial value must not be null");
+    }
+  }
+
+  RcuPointer(const RcuPointer&) = delete;
+  RcuPointer& operator=(const RcuPointer&) = delete;
+
+  // Readers must have been destroyed before the pointer itself
+  ~RcuPointer() { delete current_.load(std::memory_order_acquire); }
+
+  Reader registerReader() {
+    for (auto& slot : readers_) {
+      bool expected = false;
+      if (slot.claimed.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+        return Reader(*this, slot);
+      }
+    }
+    throw std::runtime_error("RcuPointer: too many registered readers");
+  }
+
+  // Writer side: swaps the value in, retires the old one and frees whatever is already unreachable
+  void publish(std::unique_ptr<T> next) {
+    if (!next) {
+      throw std::invalid_argument("RcuPointer: published value must not be null");
+    }
+    std::lock_guard<std::mutex> lock(writerMutex_);
+    const T* previous = current_.exchange(next.release(), std::memory_order_seq_cst);
+    const std::uint64_t retiredAt = epoch_.fetch_add(1, std::memory_order_seq_cst) + 1;
+    retired_.push_back(Retired{retiredAt, std::unique_ptr<const T>(previous)});
+    reclaimLocked();
+  }
+
+  // Retry reclamation without publishing (e.g. from a periodic admin task); returns the number freed
+  std::size_t reclaim() {
+    std::lock_guard<std::mutex> lock(writerMutex_);
+    return reclaimLocked();
+  }
+
+  // Snapshot copy for threads that are not registered readers
+  T copy() const {
+    std::lock_guard<std::mutex> lock(writerMutex_);
+    return *current_.load(std::memory_order_acquire);
+  }
+
+  std::uint64_t version() const { return epoch_.load(std::memory_order_acquire); }
+
+  std::size_t pendingReclaim() const {
+    std::lock_guard<std::mutex> lock(writerMutex_);
+    return retired_.size();
+  }
+
+  std::uint64_t reclaimed() const { return reclaimed_.load(std::memory_order_relaxed); }
+};
+
+#endif  // RCU_POINTER_H
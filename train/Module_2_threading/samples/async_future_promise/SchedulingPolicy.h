@@ -0,0 +1,164 @@
+#ifndef SCHEDULING_POLICY_H
+#define SCHEDULING_POLICY_H
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <queue>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Ordering policies for the priority task queues.
+//
+// Tasks belong to one of four priority classes (0 = LOW ... 3 = CRITICAL) and carry an absolute deadline. A policy
+// turns each enqueued task into a rank, and the task with the lowest rank runs next:
+//   StrictPriority         higher class first, FIFO within a class; LOW work starves while urgent work keeps coming
+//   EarliestDeadlineFirst  earliest deadline first, whatever the class
+//   WeightedFair           self-clocked fair queuing across classes: each class gets a share of dispatches in
+//                          proportion to its weight while it has work, so no class starves
+//
+// ClassQueues keeps one heap per class, so "the best task of class >= c" (a consumer that only takes urgent work) is
+// a look at four heads rather than a heap scan. Neither the policies nor ClassQueues synchronise: callers hold their
+// queue lock around every call.
+namespace scheduling {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t kClasses = 4;
+
+// Relative deadline for tasks submitted without one, by class
+constexpr std::array<std::chrono::milliseconds, kClasses> kDefaultBudgets{
+    std::chrono::milliseconds(2000), std::chrono::milliseconds(1000), std::chrono::milliseconds(400),
+    std::chrono::milliseconds(250)};
+
+inline Clock::time_point defaultDeadline(std::size_t priorityClass, Clock::time_point submitted) {
+  return submitted + kDefaultBudgets[priorityClass];
+}
+
+class StrictPriority {
+ public:
+  static constexpr std::string_view kName = "strict";
+
+  std::int64_t rank(std::size_t priorityClass, Clock::time_point /*deadline*/) {
+    return -static_cast<std::int64_t>(priorityClass);
+  }
+
+  void dispatched(std::int64_t /*rank*/) {}
+};
+
+class EarliestDeadlineFirst {
+ public:
+  static constexpr std::string_view kName = "edf";
+
+  std::int64_t rank(std::size_t /*priorityClass*/, Clock::time_point deadline) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+  }
+
+  void dispatched(std::int64_t /*rank*/) {}
+};
+
+// Every task costs one unit of service (run times are not known up front), so a class of weight w is charged 1/w of
+// virtual time per task: its finish tag is max(virtual time, its previous finish tag) + 1/w. The virtual time is the
+// finish tag of the last dispatched task, which makes an idle class rejoin at the current virtual time instead of
+// cashing in credit for the time it had nothing queued.
+class WeightedFair {
+ public:
+  static constexpr std::string_view kName = "wfq";
+
+ private:
+  static constexpr std::int64_t kUnit = std::int64_t{1} << 20;
+
+  std::array<std::int64_t, kClasses> cost_{};
+  std::array<std::int64_t, kClasses> lastFinish_{};
+  std::int64_t virtualTime_{0};
+
+ public:
+  explicit WeightedFair(std::array<std::uint32_t, kClasses> weights = {1, 2, 4, 8}) {
+    for (std::size_t cls = 0; cls < kClasses; ++cls) {
+      cost_[cls] = kUnit / std::max<std::uint32_t>(weights[cls], 1);
+    }
+  }
+
+  std::int64_t rank(std::size_t priorityClass, Clock::time_point /*deadline*/) {
+    lastFinish_[priorityClass] = std::max(virtualTime_, lastFinish_[priorityClass]) + cost_[priorityClass];
+    return lastFinish_[priorityClass];
+  }
+
+  void dispatched(std::int64_t rank) { virtualTime_ = std::max(virtualTime_, rank); }
+};
+
+// One heap per priority class, ordered by the policy's rank and then by arrival
+template <typename T, typename Policy = StrictPriority>
+class ClassQueues {
+ public:
+  static constexpr std::size_t kNone = kClasses;
+
+ private:
+  struct Entry {
+    std::int64_t rank;
+    std::uint64_t sequence;
+    T value;
+  };
+
+  struct RunsLater {
+    bool operator()(const Entry& a, const Entry& b) const {
+      return a.rank != b.rank ? a.rank > b.rank : a.sequence > b.sequence;
+    }
+  };
+
+  std::array<std::priority_queue<Entry, std::vector<Entry>, RunsLater>, kClasses> heaps_;
+  Policy policy_;
+  std::uint64_t sequence_{0};
+  std::size_t size_{0};
+
+ public:
+  explicit ClassQueues(Policy policy = Policy{}) : policy_(std::move(policy)) {}
+
+  void push(std::size_t priorityClass, Clock::time_point deadline, T value) {
+    heaps_[priorityClass].push(Entry{policy_.rank(priorityClass, deadline), sequence_++, std::move(value)});
+    ++size_;
+  }
+
+  // Class whose head runs next among classes >= minClass; kNone when all of them are empty
+  std::size_t next(std::size_t minClass = 0) const {
+    std::size_t best = kNone;
+    for (std::size_t cls = minClass; cls < kClasses; ++cls) {
+      if (!heaps_[cls].empty() && (best == kNone || RunsLater{}(heaps_[best].top(), heaps_[cls].top()))) {
+        best = cls;
+      }
+    }
+    return best;
+  }
+
+  // Most urgent class with queued work; kNone when empty
+  std::size_t highestNonEmpty() const {
+    for (std::size_t cls = kClasses; cls-- > 0;) {
+      if (!heaps_[cls].empty()) {
+        return cls;
+      }
+    }
+    return kNone;
+  }
+
+  // Moves the head of `priorityClass` out; the heap only compares rank and sequence, so the moved-from entry is still
+  // ordered correctly while pop() sifts it out
+  T take(std::size_t priorityClass) {
+    Entry& head = const_cast<Entry&>(heaps_[priorityClass].top());
+    policy_.dispatched(head.rank);
+    T value = std::move(head.value);
+    heaps_[priorityClass].pop();
+    --size_;
+    return value;
+  }
+
+  bool empty() const { return size_ == 0; }
+
+  std::size_t size() const { return size_; }
+};
+
+}  // namespace scheduling
+
+#endif  // SCHEDULING_POLICY_H
@@ -0,0 +1,378 @@
+#ifndef SHARED_MEMORY_TRANSPORT_H
+#define SHARED_MEMORY_TRANSPORT_H
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Cross-process tick transport: a feed process writes ticks into POSIX shared-memory rings, and each
+// RealTimeMarketProcessor process reads the ring for the symbol range it owns.
+namespace shm {
+
+// Fixed-size, trivially copyable wire format. steady_clock is CLOCK_MONOTONIC on Linux, which every process on the
+// host shares, so timestamps can be compared across processes.
+struct TickMessage {
+  static constexpr std::size_t kSymbolBytes = 16;
+
+  char symbol[kSymbolBytes]{};
+  double price{0.0};
+  std::int32_t volume{0};
+  std::int64_t timestampNanos{0};
+
+  void setSymbol(std::string_view value) {
+    const std::size_t length = std::min(value.size(), kSymbolBytes - 1);
+    std::memcpy(symbol, value.data(), length);
+    symbol[length] = '\0';
+  }
+
+  std::string_view symbolView() const { return std::string_view(symbol); }
+};
+
+static_assert(std::is_trivially_copyable_v<TickMessage>);
+
+namespace detail {
+
+inline void futexWait(std::atomic<std::uint32_t>& word, std::uint32_t expected, std::chrono::nanoseconds timeout) {
+  static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t));
+  const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+  timespec relative{static_cast<time_t>(seconds.count()), static_cast<long>((timeout - seconds).count())};
+  // Shared (not FUTEX_PRIVATE) futex: the waker lives in another process. EAGAIN/EINTR/ETIMEDOUT all mean "re-check".
+  ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT, expected, &relative, nullptr, 0);
+}
+
+inline void futexWakeAll(std::atomic<std::uint32_t>& word) {
+  ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE, INT32_MAX, nullptr, nullptr, 0);
+}
+
+}  // namespace detail
+
+// Single-producer / single-consumer ring living in a shared-memory object.
+//
+// head and tail sit on their own cache lines; the reader drains everything that is published and moves tail once per
+// batch. Neither side makes a syscall on the fast path: a side that finds the ring empty (or full) spins briefly, then
+// announces it is sleeping and blocks on a futex word that the other side bumps only when a sleeper is announced.
+// Sleeps are bounded so a stop_token is honoured promptly.
+class ShmTickRing {
+ public:
+  static constexpr auto kSleepSlice = std::chrono::milliseconds(20);
+
+ private:
+  static constexpr std::uint64_t kMagic = 0x5449434b52494e47ULL;  // "TICKRING"
+  static constexpr int kSpinLimit = 256;
+
+  struct Header {
+    std::atomic<std::uint64_t> magic;  // published last by the creator
+    std::uint64_t capacity;
+    alignas(64) std::atomic<std::uint64_t> head;  // next sequence to write (producer-owned)
+    alignas(64) std::atomic<std::uint64_t> tail;  // next sequence to read (consumer-owned)
+    alignas(64) std::atomic<std::uint32_t> dataSignal;
+    std::atomic<std::uint32_t> consumerSleeping;
+    std::atomic<std::uint32_t> closed;
+    alignas(64) std::atomic<std::uint32_t> spaceSignal;
+    std::atomic<std::uint32_t> producerSleeping;
+  };
+
+  static_assert(std::atomic<std::uint64_t>::is_always_lock_free && std::atomic<std::uint32_t>::is_always_lock_free,
+                "shared-memory atomics must be address-free");
+
+  std::string name_;
+  bool owner_{false};
+  std::size_t mappedBytes_{0};
+  Header* header_{nullptr};
+  TickMessage* slots_{nullptr};
+  std::uint64_t mask_{0};
+
+  static std::size_t bytesFor(std::uint64_t capacity) {
+    return sizeof(Header) + static_cast<std::size_t>(capacity) * sizeof(TickMessage);
+  }
+
+  void map(int fd, std::size_t bytes) {
+    void* address = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    const int error = errno;
+    ::close(fd);
+    if (address == MAP_FAILED) {
+      throw std::system_error(error, std::generic_category(), "ShmTickRing: mmap " + name_);
+    }
+    mappedBytes_ = bytes;
+    header_ = static_cast<Header*>(address);
+    slots_ = reinterpret_cast<TickMessage*>(static_cast<char*>(address) + sizeof(Header));
+  }
+
+  ShmTickRing(std::string name, bool owner) : name_(std::move(name)), owner_(owner) {}
+
+  void wakeConsumer() {
+    if (header_->consumerSleeping.load(std::memory_order_seq_cst) != 0) {
+      header_->dataSignal.fetch_add(1, std::memory_order_seq_cst);
+      detail::futexWakeAll(header_->dataSignal);
+    }
+  }
+
+  void wakeProducer() {
+    if (header_->producerSleeping.load(std::memory_order_seq_cst) != 0) {
+      header_->spaceSignal.fetch_add(1, std::memory_order_seq_cst);
+      detail::futexWakeAll(header_->spaceSignal);
+    }
+  }
+
+ public:
+  // Creates (or recreates) the shared-memory object; the creator unlinks it on destruction
+  static ShmTickRing create(const std::string& name, std::uint64_t capacity) {
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+      throw std::invalid_argument("ShmTickRing: capacity must be a power of two");
+    }
+    ShmTickRing ring(name, true);
+    ::shm_unlink(name.c_str());
+    const int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+      throw std::system_error(errno, std::generic_category(), "ShmTickRing: shm_open " + name);
+    }
+    if (::ftruncate(fd, static_cast<off_t>(bytesFor(capacity))) != 0) {
+      const int error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(), "ShmTickRing: ftruncate " + name);
+    }
+    ring.map(fd, bytesFor(capacity));
+
+    Header* header = new (ring.header_) Header{};
+    header->capacity = capacity;
+    ring.mask_ = capacity - 1;
+    header->magic.store(kMagic, std::memory_order_release);
+    return ring;
+  }
+
+  // Attaches to a ring created by another process, waiting up to `timeout` for it to appear
+  static ShmTickRing open(const std::string& name, std::chrono::milliseconds timeout = std::chrono::seconds(5)) {
+    ShmTickRing ring(name, false);
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (true) {
+      const int fd = ::shm_open(name.c_str(), O_RDWR, 0600);
+      struct stat info {};
+      if (fd >= 0 && ::fstat(fd, &info) == 0 && static_cast<std::size_t>(info.st_size) > sizeof(Header)) {
+        ring.map(fd, static_cast<std::size_t>(info.st_size));
+        if (ring.header_->magic.load(std::memory_order_acquire) == kMagic) {
+          ring.mask_ = ring.header_->capacity - 1;
+          return ring;
+        }
+        ::munmap(ring.header_, ring.mappedBytes_);
+        ring.header_ = nullptr;
+      } else if (fd >= 0) {
+        ::close(fd);
+      }
+      if (std::chrono::steady_clock::now() >= deadline) {
+        throw std::runtime_error("ShmTickRing: timed out waiting for " + name);
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  }
+
+  ShmTickRing(ShmTickRing&& other) noexcept
+      : name_(std::move(other.name_)),
+        owner_(std::exchange(other.owner_, false)),
+        mappedBytes_(std::exchange(other.mappedBytes_, 0)),
+        header_(std::exchange(other.header_, nullptr)),
+        slots_(std::exchange(other.slots_, nullptr)),
+        mask_(other.mask_) {}
+
+  ShmTickRing& operator=(ShmTickRing&&) = delete;
+  ShmTickRing(const ShmTickRing&) = delete;
+  ShmTickRing& operator=(const ShmTickRing&) = delete;
+
+  ~ShmTickRing() {
+    if (header_ != nullptr) {
+      ::munmap(header_, mappedBytes_);
+    }
+    if (owner_) {
+      ::shm_unlink(name_.c_str());
+    }
+  }
+
+  const std::string& name() const { return name_; }
+
+  std::uint64_t capacity() const { return header_->capacity; }
+
+  std::uint64_t size() const {
+    return header_->head.load(std::memory_order_acquire) - header_->tail.load(std::memory_order_acquire);
+  }
+
+  // Producer side -----------------------------------------------------------------------------------------------
+
+  bool tryPush(const TickMessage& message) {
+    const std::uint64_t head = header_->head.load(std::memory_order_relaxed);
+    if (head - header_->tail.load(std::memory_order_acquire) >= header_->capacity) {
+      return false;
+    }
+    slots_[head & mask_] = message;
+    header_->head.store(head + 1, std::memory_order_seq_cst);
+    wakeConsumer();
+    return true;
+  }
+
+  // Blocks while the ring is full (back-pressure on the feed); false only if stop was requested
+  bool push(const TickMessage& message, std::stop_token stopToken = {}) {
+    for (int spin = 0; !tryPush(message); ++spin) {
+      if (stopToken.stop_requested()) {
+        return false;
+      }
+      if (spin < kSpinLimit) {
+        std::this_thread::yield();
+        continue;
+      }
+      const std::uint32_t signal = header_->spaceSignal.load(std::memory_order_seq_cst);
+      header_->producerSleeping.store(1, std::memory_order_seq_cst);
+      const std::uint64_t head = header_->head.load(std::memory_order_relaxed);
+      if (head - header_->tail.load(std::memory_order_seq_cst) >= header_->capacity) {
+        detail::futexWait(header_->spaceSignal, signal, kSleepSlice);
+      }
+      header_->producerSleeping.store(0, std::memory_order_relaxed);
+    }
+    return true;
+  }
+
+  // No more ticks will be written; readers drain what is left and then see end-of-stream
+  void close() {
+    header_->closed.store(1, std::memory_order_seq_cst);
+    header_->dataSignal.fetch_add(1, std::memory_order_seq_cst);
+    detail::futexWakeAll(header_->dataSignal);
+  }
+
+  // Consumer side -----------------------------------------------------------------------------------------------
+
+  // Hands every published tick to `handler` and releases the slots in one step; returns the number consumed
+  template <typename Handler>
+  std::size_t drain(Handler&& handler) {
+    const std::uint64_t tail = header_->tail.load(std::memory_order_relaxed);
+    const std::uint64_t head = header_->head.load(std::memory_order_acquire);
+    for (std::uint64_t seq = tail; seq != head; ++seq) {
+      handler(slots_[seq & mask_]);
+    }
+    if (head != tail) {
+      header_->tail.store(head, std::memory_order_seq_cst);
+      wakeProducer();
+    }
+    return static_cast<std::size_t>(head - tail);
+  }
+
+  // Blocking drain; returns 0 once the producer has closed the ring and it is empty, or when stop is requested
+  template <typename Handler>
+  std::size_t waitAndDrain(Handler&& handler, std::stop_token stopToken = {}) {
+    for (int spin = 0;; ++spin) {
+      if (const std::size_t consumed = drain(handler); consumed != 0) {
+        return consumed;
+      }
+      if (stopToken.stop_requested() || header_->closed.load(std::memory_order_acquire) != 0) {
+        return drain(handler);
+      }
+      if (spin < kSpinLimit) {
+        std::this_thread::yield();
+        continue;
+      }
+      const std::uint32_t signal = header_->dataSignal.load(std::memory_order_seq_cst);
+      header_->consumerSleeping.store(1, std::memory_order_seq_cst);
+      if (header_->head.load(std::memory_order_seq_cst) == header_->tail.load(std::memory_order_relaxed)) {
+        detail::futexWait(header_->dataSignal, signal, kSleepSlice);
+      }
+      header_->consumerSleeping.store(0, std::memory_order_relaxed);
+    }
+  }
+};
+
+// Routes a symbol to the processor instance that owns its range. Split points are exclusive upper bounds:
+// with {"H", "P"} symbols < "H" go to partition 0, ["H", "P") to 1 and the rest to 2.
+class SymbolRangeRouter {
+ private:
+  std::vector<std::string> splitPoints_;
+
+ public:
+  explicit SymbolRangeRouter(std::vector<std::string> splitPoints) : splitPoints_(std::move(splitPoints)) {
+    if (!std::is_sorted(splitPoints_.begin(), splitPoints_.end())) {
+      throw std::invalid_argument("SymbolRangeRouter: split points must be sorted");
+    }
+  }
+
+  // Splits A..Z into `partitions` contiguous first-letter ranges
+  static SymbolRangeRouter alphabetical(std::size_t partitions) {
+    std::vector<std::string> splitPoints;
+    for (std::size_t idx = 1; idx < std::max<std::size_t>(partitions, 1); ++idx) {
+      splitPoints.emplace_back(1, static_cast<char>('A' + idx * 26 / partitions));
+    }
+    return SymbolRangeRouter(std::move(splitPoints));
+  }
+
+  std::size_t partitions() const { return splitPoints_.size() + 1; }
+
+  std::size_t partition(std::string_view symbol) const {
+    return static_cast<std::size_t>(
+        std::upper_bound(splitPoints_.begin(), splitPoints_.end(), symbol,
+                         [](std::string_view value, const std::string& split) { return value < split; }) -
+        splitPoints_.begin());
+  }
+};
+
+inline std::string ringName(const std::string& prefix, std::size_t partition) {
+  return prefix + "-" + std::to_string(partition);
+}
+
+// Feed-process side: one ring per partition, ticks routed by symbol range
+class ShmFeedPublisher {
+ private:
+  SymbolRangeRouter router_;
+  std::vector<ShmTickRing> rings_;
+
+ public:
+  ShmFeedPublisher(const std::string& prefix, SymbolRangeRouter router, std::uint64_t ringCapacity = 1 << 16)
+      : router_(std::move(router)) {
+    rings_.reserve(router_.partitions());
+    for (std::size_t idx = 0; idx < router_.partitions(); ++idx) {
+      rings_.push_back(ShmTickRing::create(ringName(prefix, idx), ringCapacity));
+    }
+  }
+
+  ~ShmFeedPublisher() { close(); }
+
+  ShmFeedPublisher(const ShmFeedPublisher&) = delete;
+  ShmFeedPublisher& operator=(const ShmFeedPublisher&) = delete;
+
+  const SymbolRangeRouter& router() const { return router_; }
+
+  bool publish(std::string_view symbol, double price, std::int32_t volume, std::stop_token stopToken = {}) {
+    TickMessage message;
+    message.setSymbol(symbol);
+    message.price = price;
+    message.volume = volume;
+    message.timestampNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                 std::chrono::steady_clock::now().time_since_epoch())
+                                 .count();
+    return rings_[router_.partition(symbol)].push(message, stopToken);
+  }
+
+  void close() {
+    for (auto& ring : rings_) {
+      ring.close();
+    }
+  }
+};
+
+}  // namespace shm
+
+#endif  // SHARED_MEMORY_TRANSPORT_H
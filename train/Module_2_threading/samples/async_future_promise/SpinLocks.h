@@ -0,0 +1,281 @@
+#ifndef SPIN_LOCKS_H
+#define SPIN_LOCKS_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Alternatives to std::mutex for the lock-based containers. All of them are Lockable (lock / try_lock / unlock), so
+// they work with std::lock_guard, std::unique_lock and std::condition_variable_any.
+//
+// The spinning locks yield to the scheduler once they have spun for a while: with more threads than cores a pure
+// spinner can burn a whole time slice waiting for a holder that is not even running.
+namespace locks {
+
+namespace detail {
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
+constexpr int kSpinsBeforeYield = 16;
+
+}  // namespace detail
+
+// Test-and-test-and-set: spins on a plain load (the line stays shared in every waiter's cache) and only attempts the
+// exchange when the lock looks free. Exponential backoff spreads out the stampede after each release.
+class TtasSpinLock {
+ private:
+  static constexpr int kMinBackoff = 4;
+  static constexpr int kMaxBackoff = 1024;
+
+  alignas(64) std::atomic<bool> locked_{false};
+
+ public:
+  static constexpr std::string_view kName = "ttas-backoff";
+
+  void lock() {
+    int backoff = kMinBackoff;
+    while (locked_.exchange(true, std::memory_order_acquire)) {
+      while (locked_.load(std::memory_order_relaxed)) {
+        for (int spin = 0; spin < backoff; ++spin) {
+          detail::cpuRelax();
+        }
+        if (backoff < kMaxBackoff) {
+          backoff *= 2;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    }
+  }
+
+  bool try_lock() {
+    return !locked_.load(std::memory_order_relaxed) && !locked_.exchange(true, std::memory_order_acquire);
+  }
+
+  void unlock() { locked_.store(false, std::memory_order_release); }
+};
+
+// FIFO ticket lock: fetch_add a ticket, wait until it is served. Fair, but every waiter spins on the same `serving_`
+// line, and a preempted next-in-line stalls everyone behind it. Backoff is proportional to the queue position.
+class TicketLock {
+ private:
+  static constexpr std::uint32_t kBackoffPerWaiter = 32;
+  static constexpr std::uint32_t kSpinningWaiters = 2;
+
+  alignas(64) std::atomic<std::uint32_t> nextTicket_{0};
+  alignas(64) std::atomic<std::uint32_t> nowServing_{0};
+
+ public:
+  static constexpr std::string_view kName = "ticket";
+
+  void lock() {
+    const std::uint32_t ticket = nextTicket_.fetch_add(1, std::memory_order_relaxed);
+    int spins = 0;
+    while (true) {
+      const std::uint32_t serving = nowServing_.load(std::memory_order_acquire);
+      if (serving == ticket) {
+        return;
+      }
+      // Far back in the queue (or waiting long), the wait is at least a few critical sections: give the CPU to
+      // whoever is ahead instead of spinning through their time slice
+      const std::uint32_t ahead = ticket - serving;
+      if (ahead > kSpinningWaiters || ++spins >= detail::kSpinsBeforeYield) {
+        std::this_thread::yield();
+        continue;
+      }
+      for (std::uint32_t spin = 0; spin < ahead * kBackoffPerWaiter; ++spin) {
+        detail::cpuRelax();
+      }
+    }
+  }
+
+  bool try_lock() {
+    // Acquire pairs with the previous holder's unlock; the CAS only succeeds if nobody holds or waits for a ticket
+    const std::uint32_t serving = nowServing_.load(std::memory_order_acquire);
+    std::uint32_t expected = serving;
+    return nextTicket_.compare_exchange_strong(expected, serving + 1, std::memory_order_acquire,
+                                               std::memory_order_relaxed);
+  }
+
+  void unlock() {
+    nowServing_.store(nowServing_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+};
+
+// MCS queue lock: waiters form a linked queue and each spins on its own node, so a release touches exactly one
+// other cache line. Queue nodes come from a small per-thread stack; nested MCS locks must be released in reverse
+// acquisition order (what scoped guards and condition-variable waits do).
+class McsLock {
+ private:
+  struct alignas(64) Node {
+    std::atomic<Node*> next{nullptr};
+    std::atomic<bool> waiting{false};
+  };
+
+  static constexpr std::size_t kMaxNesting = 8;
+
+  struct ThreadNodes {
+    std::array<Node, kMaxNesting> nodes;
+    std::size_t depth{0};
+  };
+
+  static ThreadNodes& threadNodes() {
+    thread_local ThreadNodes local;
+    return local;
+  }
+
+  static Node* pushNode() {
+    auto& local = threadNodes();
+    if (local.depth == kMaxNesting) {
+      throw std::runtime_error("McsLock: too many MCS locks held by one thread");
+    }
+    Node* node = &local.nodes[local.depth++];
+    node->next.store(nullptr, std::memory_order_relaxed);
+    return node;
+  }
+
+  static void popNode() { --threadNodes().depth; }
+
+  alignas(64) std::atomic<Node*> tail_{nullptr};
+  Node* holder_{nullptr};  // written by the holder only
+
+ public:
+  static constexpr std::string_view kName = "mcs";
+
+  void lock() {
+    Node* node = pushNode();
+    node->waiting.store(true, std::memory_order_relaxed);
+    if (Node* predecessor = tail_.exchange(node, std::memory_order_acq_rel)) {
+      predecessor->next.store(node, std::memory_order_release);
+      for (int spins = 0; node->waiting.load(std::memory_order_acquire); ++spins) {
+        detail::cpuRelax();
+        if (spins >= detail::kSpinsBeforeYield) {
+          std::this_thread::yield();
+        }
+      }
+    }
+    holder_ = node;
+  }
+
+  bool try_lock() {
+    Node* node = pushNode();
+    Node* expected = nullptr;
+    if (tail_.compare_exchange_strong(expected, node, std::memory_order_acquire, std::memory_order_relaxed)) {
+      holder_ = node;
+      return true;
+    }
+    popNode();
+    return false;
+  }
+
+  void unlock() {
+    Node* node = holder_;
+    Node* successor = node->next.load(std::memory_order_acquire);
+    if (successor == nullptr) {
+      Node* expected = node;
+      if (tail_.compare_exchange_strong(expected, nullptr, std::memory_order_release, std::memory_order_relaxed)) {
+        popNode();
+        return;
+      }
+      // A successor swapped itself into tail_ but has not linked in yet
+      for (int spins = 0; (successor = node->next.load(std::memory_order_acquire)) == nullptr; ++spins) {
+        detail::cpuRelax();
+        if (spins >= detail::kSpinsBeforeYield) {
+          std::this_thread::yield();
+        }
+      }
+    }
+    successor->waiting.store(false, std::memory_order_release);
+    popNode();
+  }
+};
+
+// Spin briefly, then sleep in the kernel (Drepper's three-state futex mutex): 0 = free, 1 = locked, 2 = locked with
+// possible sleepers. Uncontended lock/unlock is one CAS and one exchange; unlock only makes a syscall when someone
+// may be asleep.
+class AdaptiveMutex {
+ private:
+  static constexpr int kSpinAttempts = 100;
+
+  alignas(64) std::atomic<std::uint32_t> state_{0};
+
+  void sleep() {
+#if defined(__linux__)
+    ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&state_), FUTEX_WAIT_PRIVATE, 2u, nullptr, nullptr, 0);
+#else
+    state_.wait(2, std::memory_order_relaxed);
+#endif
+  }
+
+  void wakeOne() {
+#if defined(__linux__)
+    ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&state_), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#else
+    state_.notify_one();
+#endif
+  }
+
+ public:
+  static constexpr std::string_view kName = "adaptive";
+
+  void lock() {
+    for (int attempt = 0; attempt < kSpinAttempts; ++attempt) {
+      std::uint32_t expected = 0;
+      if (state_.compare_exchange_weak(expected, 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+        return;
+      }
+      detail::cpuRelax();
+    }
+    // Marking the lock contended (2) before sleeping makes the eventual unlock wake someone
+    while (state_.exchange(2, std::memory_order_acquire) != 0) {
+      sleep();
+    }
+  }
+
+  bool try_lock() {
+    std::uint32_t expected = 0;
+    return state_.compare_exchange_strong(expected, 1, std::memory_order_acquire, std::memory_order_relaxed);
+  }
+
+  void unlock() {
+    if (state_.exchange(0, std::memory_order_release) == 2) {
+      wakeOne();
+    }
+  }
+};
+
+// Display name of a lock type, for benchmark tables
+template <typename Mutex>
+inline constexpr std::string_view kLockName = Mutex::kName;
+template <>
+inline constexpr std::string_view kLockName<std::mutex> = "std::mutex";
+template <>
+inline constexpr std::string_view kLockName<std::shared_mutex> = "std::shared_mutex";
+
+// Reads take a shared lock when the mutex supports one, an exclusive lock otherwise
+template <typename Mutex>
+using ReadLock = std::conditional_t<requires(Mutex& mutex) { mutex.lock_shared(); }, std::shared_lock<Mutex>,
+                                    std::unique_lock<Mutex>>;
+
+}  // namespace locks
+
+#endif  // SPIN_LOCKS_H
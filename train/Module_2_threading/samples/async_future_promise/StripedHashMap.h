@@ -0,0 +1,257 @@
+#ifndef STRIPED_HASH_MAP_H
+#define STRIPED_HASH_MAP_H
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "SpinLocks.h"
+
+// Concurrent string-keyed hash map for point operations: the drop-in for ThreadSafeMap when nobody needs ordering.
+//
+// Keys hash into Shards independent open-addressing tables, each behind its own lock (lock striping), so writers to
+// different shards never meet and readers of a shard only share its lock word. Each shard probes linearly over a dense
+// array of 64-bit hash fingerprints (eight per cache line) and only touches an entry's key when the fingerprint
+// matches. Erased slots become tombstones; a shard rehashes itself when live entries plus tombstones pass 3/4 of its
+// capacity.
+//
+// Lookups take std::string_view, so callers holding a char buffer or a literal never build a std::string. update()
+// and upsert() modify a value in place under the shard's exclusive lock, which is how read-modify-write sequences stay
+// atomic without a second lookup.
+template <typename Value, std::size_t Shards = 64, typename Mutex = std::shared_mutex>
+class StripedHashMap {
+  static_assert(std::has_single_bit(Shards), "Shards must be a power of two");
+
+ private:
+  static constexpr std::uint64_t kEmpty = 0;
+  static constexpr std::uint64_t kTombstone = 1;  // live fingerprints are >= 2
+  static constexpr std::size_t kInitialCapacity = 16;
+
+  struct Entry {
+    std::string key;
+    Value value;
+  };
+
+  struct alignas(64) Shard {
+    mutable Mutex mutex;
+    std::vector<std::uint64_t> fingerprints = std::vector<std::uint64_t>(kInitialCapacity, kEmpty);
+    std::vector<std::optional<Entry>> entries = std::vector<std::optional<Entry>>(kInitialCapacity);
+    std::size_t live{0};
+    std::size_t used{0};  // live + tombstones
+
+    std::size_t mask() const { return fingerprints.size() - 1; }
+
+    // Slot holding `key`, or npos
+    std::size_t find(std::uint64_t fingerprint, std::string_view key) const {
+      for (std::size_t idx = fingerprint & mask();; idx = (idx + 1) & mask()) {
+        const std::uint64_t current = fingerprints[idx];
+        if (current == kEmpty) {
+          return npos;
+        }
+        if (current == fingerprint && entries[idx]->key == key) {
+          return idx;
+        }
+      }
+    }
+
+    // Free slot for a key known to be absent, growing or purging tombstones first if needed
+    std::size_t claim(std::uint64_t fingerprint) {
+      if ((used + 1) * 4 > fingerprints.size() * 3) {
+        rehash(live * 2 >= fingerprints.size() ? fingerprints.size() * 2 : fingerprints.size());
+      }
+      for (std::size_t idx = fingerprint & mask();; idx = (idx + 1) & mask()) {
+        if (fingerprints[idx] == kEmpty || fingerprints[idx] == kTombstone) {
+          used += fingerprints[idx] == kEmpty ? 1 : 0;
+          ++live;
+          fingerprints[idx] = fingerprint;
+          return idx;
+        }
+      }
+    }
+
+    void rehash(std::size_t capacity) {
+      std::vector<std::uint64_t> oldFingerprints(capacity, kEmpty);
+      std::vector<std::optional<Entry>> oldEntries(capacity);
+      oldFingerprints.swap(fingerprints);
+      oldEntries.swap(entries);
+      for (std::size_t from = 0; from < oldFingerprints.size(); ++from) {
+        if (oldFingerprints[from] < 2) {
+          continue;
+        }
+        std::size_t to = oldFingerprints[from] & mask();
+        while (fingerprints[to] != kEmpty) {
+          to = (to + 1) & mask();
+        }
+        fingerprints[to] = oldFingerprints[from];
+        entries[to] = std::move(oldEntries[from]);
+      }
+      used = live;
+    }
+
+    // If building the entry throws, the claimed slot becomes a tombstone so find() never meets an empty entry
+    template <typename V>
+    void emplace(std::uint64_t fingerprint, std::string_view key, V&& value) {
+      const std::size_t idx = claim(fingerprint);
+      try {
+        entries[idx].emplace(Entry{std::string(key), std::forward<V>(value)});
+      } catch (...) {
+        fingerprints[idx] = kTombstone;
+        --live;
+        throw;
+      }
+    }
+  };
+
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  std::array<Shard, Shards> shards_;
+
+  // Fibonacci-mixed so both ends of the word are usable: the top bits pick the shard, the bottom bits the slot
+  static std::uint64_t fingerprintOf(std::string_view key) {
+    const std::uint64_t mixed = static_cast<std::uint64_t>(std::hash<std::string_view>{}(key)) * 0x9E3779B97F4A7C15ULL;
+    return mixed < 2 ? mixed + 2 : mixed;
+  }
+
+  // A single shard needs no index bits, and shifting a 64-bit word by 64 is undefined
+  static std::size_t shardIndex(std::uint64_t fingerprint) {
+    if constexpr (Shards == 1) {
+      return 0;
+    } else {
+      return static_cast<std::size_t>(fingerprint >> (64 - std::countr_zero(Shards)));
+    }
+  }
+
+  Shard& shardFor(std::uint64_t fingerprint) { return shards_[shardIndex(fingerprint)]; }
+  const Shard& shardFor(std::uint64_t fingerprint) const { return shards_[shardIndex(fingerprint)]; }
+
+ public:
+  StripedHashMap() = default;
+  StripedHashMap(const StripedHashMap&) = delete;
+  StripedHashMap& operator=(const StripedHashMap&) = delete;
+
+  // Returns true if the key was new
+  template <typename V>
+  bool insertOrAssign(std::string_view key, V&& value) {
+    const std::uint64_t fingerprint = fingerprintOf(key);
+    Shard& shard = shardFor(fingerprint);
+    std::unique_lock<Mutex> lock(shard.mutex);
+    if (const std::size_t idx = shard.find(fingerprint, key); idx != npos) {
+      shard.entries[idx]->value = std::forward<V>(value);
+      return false;
+    }
+    shard.emplace(fingerprint, key, std::forward<V>(value));
+    return true;
+  }
+
+  // ThreadSafeMap-compatible spelling
+  void insert(std::string_view key, const Value& value) { insertOrAssign(key, value); }
+
+  bool find(std::string_view key, Value& value) const {
+    const std::uint64_t fingerprint = fingerprintOf(key);
+    const Shard& shard = shardFor(fingerprint);
+    locks::ReadLock<Mutex> lock(shard.mutex);
+    const std::size_t idx = shard.find(fingerprint, key);
+    if (idx == npos) {
+      return false;
+    }
+    value = shard.entries[idx]->value;
+    return true;
+  }
+
+  [[nodiscard]] std::optional<Value> get(std::string_view key) const {
+    const std::uint64_t fingerprint = fingerprintOf(key);
+    const Shard& shard = shardFor(fingerprint);
+    locks::ReadLock<Mutex> lock(shard.mutex);
+    const std::size_t idx = shard.find(fingerprint, key);
+    return idx == npos ? std::nullopt : std::optional<Value>(shard.entries[idx]->value);
+  }
+
+  [[nodiscard]] bool contains(std::string_view key) const {
+    const std::uint64_t fingerprint = fingerprintOf(key);
+    const Shard& shard = shardFor(fingerprint);
+    locks::ReadLock<Mutex> lock(shard.mutex);
+    return shard.find(fingerprint, key) != npos;
+  }
+
+  // Runs `mutate(Value&)` on the key's value under the shard's exclusive lock; false (and no call) if absent
+  template <typename Mutate>
+  bool update(std::string_view key, Mutate&& mutate) {
+    const std::uint64_t fingerprint = fingerprintOf(key);
+    Shard& shard = shardFor(fingerprint);
+    std::unique_lock<Mutex> lock(shard.mutex);
+    const std::size_t idx = shard.find(fingerprint, key);
+    if (idx == npos) {
+      return false;
+    }
+    std::invoke(std::forward<Mutate>(mutate), shard.entries[idx]->value);
+    return true;
+  }
+
+  // Like update() when the key exists; otherwise inserts `initial` without calling `mutate`. Returns true if inserted.
+  template <typename Mutate, typename V>
+  bool upsert(std::string_view key, Mutate&& mutate, V&& initial) {
+    const std::uint64_t fingerprint = fingerprintOf(key);
+    Shard& shard = shardFor(fingerprint);
+    std::unique_lock<Mutex> lock(shard.mutex);
+    if (const std::size_t idx = shard.find(fingerprint, key); idx != npos) {
+      std::invoke(std::forward<Mutate>(mutate), shard.entries[idx]->value);
+      return false;
+    }
+    shard.emplace(fingerprint, key, std::forward<V>(initial));
+    return true;
+  }
+
+  bool erase(std::string_view key) {
+    const std::uint64_t fingerprint = fingerprintOf(key);
+    Shard& shard = shardFor(fingerprint);
+    std::unique_lock<Mutex> lock(shard.mutex);
+    const std::size_t idx = shard.find(fingerprint, key);
+    if (idx == npos) {
+      return false;
+    }
+    shard.fingerprints[idx] = kTombstone;
+    shard.entries[idx].reset();
+    --shard.live;
+    return true;
+  }
+
+  // Visits every entry, one shard at a time under that shard's read lock: consistent per shard, not across shards
+  template <typename Visitor>
+  void forEach(Visitor&& visit) const {
+    for (const Shard& shard : shards_) {
+      locks::ReadLock<Mutex> lock(shard.mutex);
+      for (std::size_t idx = 0; idx < shard.fingerprints.size(); ++idx) {
+        if (shard.fingerprints[idx] >= 2) {
+          visit(std::string_view(shard.entries[idx]->key), shard.entries[idx]->value);
+        }
+      }
+    }
+  }
+
+  // Unordered copy of every entry, with forEach()'s consistency
+  std::vector<std::pair<std::string, Value>> getAllEntries() const {
+    std::vector<std::pair<std::string, Value>> all;
+    forEach([&](std::string_view key, const Value& value) { all.emplace_back(std::string(key), value); });
+    return all;
+  }
+
+  std::size_t size() const {
+    std::size_t total = 0;
+    for (const Shard& shard : shards_) {
+      locks::ReadLock<Mutex> lock(shard.mutex);
+      total += shard.live;
+    }
+    return total;
+  }
+};
+
+#endif  // STRIPED_HASH_MAP_H
@@ -0,0 +1,63 @@
+#ifndef THREAD_SAFE_MAP_H
+#define THREAD_SAFE_MAP_H
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "SpinLocks.h"
+
+// std::map<std::string, T> behind one lock (the baseline for lockfree::LockFreeSkipListMap). Mutex may be any Lockable
+// from SpinLocks.h; readers share the lock only when Mutex supports lock_shared().
+template <typename T, typename Mutex = std::shared_mutex>
+class ThreadSafeMap {
+ private:
+  mutable Mutex mutex_;
+  std::map<std::string, T> data_;
+
+ public:
+  void insert(const std::string& key, const T& value) {
+    std::unique_lock<Mutex> lock(mutex_);
+    data_[key] = value;
+  }
+
+  bool find(const std::string& key, T& value) const {
+    locks::ReadLock<Mutex> lock(mutex_);
+    auto it = data_.find(key);
+    if (it != data_.end()) {
+      value = it->second;
+      return true;
+    }
+    return false;
+  }
+
+  bool erase(const std::string& key) {
+    std::unique_lock<Mutex> lock(mutex_);
+    return data_.erase(key) != 0;
+  }
+
+  size_t size() const {
+    locks::ReadLock<Mutex> lock(mutex_);
+    return data_.size();
+  }
+
+  std::vector<std::pair<std::string, T>> getAllEntries() const {
+    locks::ReadLock<Mutex> lock(mutex_);
+    return std::vector<std::pair<std::string, T>>(data_.begin(), data_.end());
+  }
+
+  // Entries with keys in [from, to), copied under one read lock; empty when to <= from
+  std::vector<std::pair<std::string, T>> getRange(const std::string& from, const std::string& to) const {
+    if (!(from < to)) {
+      return {};  // std::map's [lower_bound(from), lower_bound(to)) would not be a valid range
+    }
+    locks::ReadLock<Mutex> lock(mutex_);
+    return std::vector<std::pair<std::string, T>>(data_.lower_bound(from), data_.lower_bound(to));
+  }
+};
+
+#endif  // THREAD_SAFE_MAP_H
@@ -0,0 +1,276 @@
+#ifndef TOP_MOVERS_BOARD_H
+#define TOP_MOVERS_BOARD_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+struct MoverEntry {
+  std::array<char, 16> symbol{};  // truncated, NUL padded
+  double price{0.0};
+  double percentChange{0.0};  // vs first price seen this session
+  std::int64_t volume{0};     // cumulative
+
+  std::string_view name() const {
+    return {symbol.data(), static_cast<std::size_t>(std::find(symbol.begin(), symbol.end(), '\0') - symbol.begin())};
+  }
+};
+
+// Live "top K movers" by |% change| and by cumulative volume.
+//
+// Symbols are hashed into shards. Each shard gives every symbol a dense id and, per ranking, keeps all of its
+// symbols in an indexed binary heap keyed by (score, id), so a tick re-positions the symbol in O(log n) whether its
+// score rose or fell. Only when the symbol was or now is among the shard's top K is that top-K re-read from the heap
+// (a best-first walk, O(K log K)) and republished. Updates take the shard's mutex, so ticks for different shards never
+// contend. The top-K is published through a seqlock built from relaxed atomic words; readers copy every shard's top-K
+// without locks, retry on a torn read and merge. Cost of a query is O(Shards * K) regardless of how many symbols are
+// tracked.
+template <std::size_t K = 10, std::size_t Shards = 16>
+class TopMoversBoard {
+  static_assert(K > 0 && Shards > 0);
+
+ public:
+  enum class Ranking { PercentChange = 0, Volume = 1 };
+  static constexpr std::size_t kRankings = 2;
+
+ private:
+  static constexpr std::size_t kWordsPerEntry = 5;
+
+  struct SymbolState {
+    MoverEntry entry;
+    double openPrice{0.0};
+    std::array<std::uint32_t, kRankings> heapPos{};  // where its key sits in each ranking's heap
+    std::array<bool, kRankings> inTop{};             // currently one of the shard's top K in that ranking
+  };
+
+  // Best first; the id breaks ties and is what identifies a symbol (`symbol` in MoverEntry is truncated)
+  struct RankKey {
+    double score;
+    std::uint32_t id;
+
+    bool operator<(const RankKey& other) const {
+      return score != other.score ? score > other.score : id < other.id;
+    }
+  };
+
+  struct RankedList {
+    std::array<MoverEntry, K> top{};
+    std::array<std::uint32_t, K> ids{};
+    std::size_t count{0};
+    RankKey last{};  // key of top[K - 1] once the list is full
+  };
+
+  struct alignas(64) Shard {
+    // Writer side
+    std::mutex mutex;
+    std::unordered_map<std::string, std::uint32_t> ids;
+    std::vector<SymbolState> states;  // indexed by id
+    std::array<std::vector<RankKey>, kRankings> heaps;  // indexed binary heaps, best at [0]
+    std::array<RankedList, kRankings> rankings;
+
+    // Reader side: seqlock-published copy of `rankings`
+    std::atomic<std::uint64_t> sequence{0};
+    std::array<std::atomic<std::uint64_t>, kRankings> publishedCount{};
+    std::array<std::array<std::atomic<std::uint64_t>, K * kWordsPerEntry>, kRankings> publishedWords{};
+  };
+
+  std::array<Shard, Shards> shards_;
+
+  static double score(const MoverEntry& entry, Ranking ranking) {
+    return ranking == Ranking::PercentChange ? std::abs(entry.percentChange) : static_cast<double>(entry.volume);
+  }
+
+  static bool better(const MoverEntry& a, const MoverEntry& b, Ranking ranking) {
+    return score(a, ranking) > score(b, ranking);
+  }
+
+  static void heapSwap(Shard& shard, std::size_t r, std::size_t a, std::size_t b) {
+    std::vector<RankKey>& heap = shard.heaps[r];
+    std::swap(heap[a], heap[b]);
+    shard.states[heap[a].id].heapPos[r] = static_cast<std::uint32_t>(a);
+    shard.states[heap[b].id].heapPos[r] = static_cast<std::uint32_t>(b);
+  }
+
+  // Moves the key at `pos` up or down to where it belongs (O(log n))
+  static void heapFix(Shard& shard, std::size_t r, std::size_t pos) {
+    std::vector<RankKey>& heap = shard.heaps[r];
+    while (pos > 0 && heap[pos] < heap[(pos - 1) / 2]) {
+      heapSwap(shard, r, pos, (pos - 1) / 2);
+      pos = (pos - 1) / 2;
+    }
+    while (true) {
+      std::size_t best = pos;
+      for (const std::size_t child : {2 * pos + 1, 2 * pos + 2}) {
+        if (child < heap.size() && heap[child] < heap[best]) {
+          best = child;
+        }
+      }
+      if (best == pos) {
+        return;
+      }
+      heapSwap(shard, r, pos, best);
+      pos = best;
+    }
+  }
+
+  // Re-key symbol `id` in the ranking's heap (O(log n)). The top-K only has to be re-read from the heap (O(K log K))
+  // when the symbol was in it or now beats its last entry; returns whether that happened.
+  static bool updateList(Shard& shard, std::uint32_t id, bool inserted, Ranking ranking) {
+    const std::size_t r = static_cast<std::size_t>(ranking);
+    SymbolState& state = shard.states[id];
+    std::vector<RankKey>& heap = shard.heaps[r];
+    const RankKey key{score(state.entry, ranking), id};
+
+    if (inserted) {
+      state.heapPos[r] = static_cast<std::uint32_t>(heap.size());
+      heap.push_back(key);
+    } else {
+      heap[state.heapPos[r]] = key;
+    }
+    heapFix(shard, r, state.heapPos[r]);
+
+    RankedList& list = shard.rankings[r];
+    if (list.count == K && !state.inTop[r] && list.last < key) {
+      return false;
+    }
+
+    for (std::size_t idx = 0; idx < list.count; ++idx) {
+      shard.states[list.ids[idx]].inTop[r] = false;
+    }
+    list.count = 0;
+    // Best-first walk of the heap: the next best key is always in the frontier of children of keys already taken
+    std::array<std::size_t, 2 * K + 1> frontier;
+    std::size_t frontierSize = 0;
+    const auto worse = [&heap](std::size_t a, std::size_t b) { return heap[b] < heap[a]; };
+    frontier[frontierSize++] = 0;
+    while (frontierSize > 0 && list.count < K) {
+      std::pop_heap(frontier.begin(), frontier.begin() + frontierSize, worse);
+      const std::size_t pos = frontier[--frontierSize];
+      SymbolState& rankedState = shard.states[heap[pos].id];
+      rankedState.inTop[r] = true;
+      list.top[list.count] = rankedState.entry;
+      list.ids[list.count++] = heap[pos].id;
+      list.last = heap[pos];
+      for (const std::size_t child : {2 * pos + 1, 2 * pos + 2}) {
+        if (child < heap.size()) {
+          frontier[frontierSize++] = child;
+          std::push_heap(frontier.begin(), frontier.begin() + frontierSize, worse);
+        }
+      }
+    }
+    return true;
+  }
+
+  static void encode(const MoverEntry& entry, std::atomic<std::uint64_t>* words) {
+    std::uint64_t symbolWords[2];
+    std::memcpy(symbolWords, entry.symbol.data(), sizeof(symbolWords));
+    words[0].store(symbolWords[0], std::memory_order_relaxed);
+    words[1].store(symbolWords[1], std::memory_order_relaxed);
+    words[2].store(std::bit_cast<std::uint64_t>(entry.price), std::memory_order_relaxed);
+    words[3].store(std::bit_cast<std::uint64_t>(entry.percentChange), std::memory_order_relaxed);
+    words[4].store(static_cast<std::uint64_t>(entry.volume), std::memory_order_relaxed);
+  }
+
+  static MoverEntry decode(const std::atomic<std::uint64_t>* words) {
+    MoverEntry entry;
+    const std::uint64_t symbolWords[2] = {words[0].load(std::memory_order_relaxed),
+                                          words[1].load(std::memory_order_relaxed)};
+    std::memcpy(entry.symbol.data(), symbolWords, sizeof(symbolWords));
+    entry.price = std::bit_cast<double>(words[2].load(std::memory_order_relaxed));
+    entry.percentChange = std::bit_cast<double>(words[3].load(std::memory_order_relaxed));
+    entry.volume = static_cast<std::int64_t>(words[4].load(std::memory_order_relaxed));
+    return entry;
+  }
+
+  // Caller holds shard.mutex, so there is exactly one writer per shard
+  static void publish(Shard& shard) {
+    const std::uint64_t seq = shard.sequence.load(std::memory_order_relaxed);
+    shard.sequence.store(seq + 1, std::memory_order_relaxed);  // odd: write in progress
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (std::size_t r = 0; r < kRankings; ++r) {
+      const RankedList& list = shard.rankings[r];
+      shard.publishedCount[r].store(list.count, std::memory_order_relaxed);
+      for (std::size_t idx = 0; idx < list.count; ++idx) {
+        encode(list.top[idx], &shard.publishedWords[r][idx * kWordsPerEntry]);
+      }
+    }
+
+    shard.sequence.store(seq + 2, std::memory_order_release);
+  }
+
+  static std::size_t readShard(const Shard& shard, Ranking ranking, MoverEntry* out) {
+    const std::size_t r = static_cast<std::size_t>(ranking);
+    while (true) {
+      const std::uint64_t before = shard.sequence.load(std::memory_order_acquire);
+      if (before & 1) {
+        std::this_thread::yield();
+        continue;
+      }
+
+      const std::size_t count = std::min<std::size_t>(shard.publishedCount[r].load(std::memory_order_relaxed), K);
+      for (std::size_t idx = 0; idx < count; ++idx) {
+        out[idx] = decode(&shard.publishedWords[r][idx * kWordsPerEntry]);
+      }
+
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (shard.sequence.load(std::memory_order_relaxed) == before) {
+        return count;
+      }
+    }
+  }
+
+ public:
+  void onTick(const std::string& symbol, double price, std::int64_t volume) {
+    Shard& shard = shards_[std::hash<std::string>{}(symbol) % Shards];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto [it, inserted] = shard.ids.try_emplace(symbol, static_cast<std::uint32_t>(shard.states.size()));
+    const std::uint32_t id = it->second;
+    if (inserted) {
+      SymbolState& fresh = shard.states.emplace_back();
+      fresh.openPrice = price;
+      std::memcpy(fresh.entry.symbol.data(), symbol.data(), std::min(symbol.size(), fresh.entry.symbol.size() - 1));
+    }
+
+    SymbolState& state = shard.states[id];
+    state.entry.price = price;
+    state.entry.percentChange = state.openPrice > 0.0 ? (price - state.openPrice) / state.openPrice * 100.0 : 0.0;
+    state.entry.volume += volume;
+
+    const bool percentChanged = updateList(shard, id, inserted, Ranking::PercentChange);
+    const bool volumeChanged = updateList(shard, id, inserted, Ranking::Volume);
+    if (percentChanged || volumeChanged) {
+      publish(shard);
+    }
+  }
+
+  // Lock-free: safe to call from a monitor thread while ticks are flowing
+  std::vector<MoverEntry> top(Ranking ranking, std::size_t n = K) const {
+    std::vector<MoverEntry> merged(Shards * K);
+    std::size_t total = 0;
+    for (const Shard& shard : shards_) {
+      total += readShard(shard, ranking, merged.data() + total);
+    }
+
+    n = std::min(n, total);
+    std::partial_sort(merged.begin(), merged.begin() + n, merged.begin() + total,
+                      [ranking](const MoverEntry& a, const MoverEntry& b) { return better(a, b, ranking); });
+    merged.resize(n);
+    return merged;
+  }
+};
+
+#endif  // TOP_MOVERS_BOARD_H
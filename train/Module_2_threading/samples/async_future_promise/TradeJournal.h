@@ -0,0 +1,499 @@
+#ifndef TRADE_JOURNAL_H
+#define TRADE_JOURNAL_H
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace journal {
+
+// CRC-32 (IEEE, reflected), table built at compile time
+inline constexpr std::array<std::uint32_t, 256> kCrcTable = [] {
+  std::array<std::uint32_t, 256> table{};
+  for (std::uint32_t idx = 0; idx < 256; ++idx) {
+    std::uint32_t crc = idx;
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+    }
+    table[idx] = crc;
+  }
+  return table;
+}();
+
+inline std::uint32_t crc32(const void* data, std::size_t length, std::uint32_t crc = 0) {
+  const auto* bytes = static_cast<const unsigned char*>(data);
+  crc = ~crc;
+  for (std::size_t idx = 0; idx < length; ++idx) {
+    crc = kCrcTable[(crc ^ bytes[idx]) & 0xFF] ^ (crc >> 8);
+  }
+  return ~crc;
+}
+
+enum class RecordType : std::uint8_t { Signal = 1, Execution = 2 };
+
+// On-disk layout: [RecordHeader][reason bytes]. `length` covers the whole record, `crc` everything after itself.
+// A zero length marks the end of a (pre-allocated, zero-filled) segment.
+struct RecordHeader {
+  std::uint32_t length;
+  std::uint32_t crc;
+  std::uint64_t sequence;
+  std::int64_t timestampNanos;
+  double confidence;
+  char symbol[16];
+  RecordType type;
+  std::uint8_t action;
+  std::uint16_t reasonLength;
+  std::uint32_t reserved;
+};
+static_assert(sizeof(RecordHeader) == 56, "RecordHeader layout is part of the file format");
+
+struct Record {
+  RecordType type;
+  std::uint64_t sequence;
+  std::int64_t timestampNanos;
+  std::string symbol;
+  std::uint8_t action;
+  double confidence;
+  std::string reason;
+};
+
+// Throws std::system_error when the kernel reports that the data did not reach the disk
+inline void syncData(int fd) {
+#if defined(__linux__)
+  const int rc = ::fdatasync(fd);
+#else
+  const int rc = ::fsync(fd);
+#endif
+  if (rc != 0) {
+    throw std::system_error(errno, std::generic_category(), "TradeJournal: fdatasync");
+  }
+}
+
+// fsync on a directory makes the entries created in it durable; a new file's data alone does not carry its name
+inline void syncDirectory(const std::filesystem::path& directory) {
+  const int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+  if (fd < 0) {
+    throw std::system_error(errno, std::generic_category(), "TradeJournal: open " + directory.string());
+  }
+  const int rc = ::fsync(fd);
+  const int error = errno;
+  ::close(fd);
+  if (rc != 0) {
+    throw std::system_error(error, std::generic_category(), "TradeJournal: fsync " + directory.string());
+  }
+}
+
+// Like create_directories, but every directory it creates is also recorded durably in its parent
+inline void createDirectoriesDurably(const std::filesystem::path& directory) {
+  auto path = std::filesystem::absolute(directory).lexically_normal();
+  if (!path.has_filename()) {
+    path = path.parent_path();  // trailing separator
+  }
+  auto existing = path;
+  while (!std::filesystem::exists(existing)) {
+    existing = existing.parent_path();
+  }
+  if (!std::filesystem::create_directories(path)) {
+    return;
+  }
+  for (auto created = path; created != existing; created = created.parent_path()) {
+    syncDirectory(created.parent_path());
+  }
+}
+
+inline std::filesystem::path segmentPath(const std::filesystem::path& directory, std::uint32_t index) {
+  char name[32];
+  std::snprintf(name, sizeof(name), "journal-%06u.log", index);
+  return directory / name;
+}
+
+// Replays every segment in order. Stops at the first zero length (end of data) or CRC mismatch (torn tail).
+class TradeJournalReader {
+ public:
+  explicit TradeJournalReader(std::filesystem::path directory) : directory_(std::move(directory)) {}
+
+  // Returns the number of records delivered to `visitor`
+  std::size_t replay(const std::function<void(const Record&)>& visitor) const {
+    std::size_t delivered = 0;
+    for (std::uint32_t index = 1; std::filesystem::exists(segmentPath(directory_, index)); ++index) {
+      delivered += replaySegment(segmentPath(directory_, index), visitor);
+    }
+    return delivered;
+  }
+
+ private:
+  std::filesystem::path directory_;
+
+  static std::size_t replaySegment(const std::filesystem::path& path,
+                                   const std::function<void(const Record&)>& visitor) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw std::system_error(errno, std::generic_category(), "TradeJournalReader: open " + path.string());
+    }
+
+    std::size_t delivered = 0;
+    std::size_t offset = 0;
+    std::vector<char> reason;
+    while (true) {
+      RecordHeader header;
+      if (::pread(fd, &header, sizeof(header), static_cast<off_t>(offset)) != sizeof(header) || header.length == 0 ||
+          header.length < sizeof(header) || header.length - sizeof(header) != header.reasonLength) {
+        break;
+      }
+
+      reason.resize(header.reasonLength);
+      if (header.reasonLength > 0 &&
+          ::pread(fd, reason.data(), reason.size(), static_cast<off_t>(offset + sizeof(header))) !=
+              static_cast<ssize_t>(reason.size())) {
+        break;
+      }
+
+      constexpr std::size_t crcOffset = offsetof(RecordHeader, sequence);
+      std::uint32_t crc = crc32(reinterpret_cast<const char*>(&header) + crcOffset, sizeof(header) - crcOffset);
+      crc = crc32(reason.data(), reason.size(), crc);
+      if (crc != header.crc) {
+        break;
+      }
+
+      const char* symbolEnd = std::find(header.symbol, header.symbol + sizeof(header.symbol), '\0');
+      const auto symbolLength = static_cast<std::size_t>(symbolEnd - header.symbol);
+      visitor(Record{header.type, header.sequence, header.timestampNanos, std::string(header.symbol, symbolLength),
+                     header.action, header.confidence, std::string(reason.data(), reason.size())});
+      ++delivered;
+      offset += header.length;
+    }
+
+    ::close(fd);
+    return delivered;
+  }
+};
+
+struct JournalOptions {
+  std::filesystem::path directory{"trade_journal"};
+  std::size_t segmentBytes{16 * 1024 * 1024};
+  std::size_t commitBytes{64 * 1024};             // flush early once the batch reaches this size
+  std::chrono::microseconds commitWindow{2000};  // otherwise flush at least this often
+  std::size_t maxPendingBytes{4 * 1024 * 1024};  // append() blocks while this much is waiting for the flusher
+};
+
+// Append-only, group-committed journal.
+//
+// append() only encodes the record into an in-memory batch under a short mutex (a few hundred ns), so the caller
+// never waits for the disk. A background flusher writes the batch with one pwrite and one fdatasync when either the
+// time window elapses or the batch reaches the size threshold. Segments are pre-allocated to a fixed size so the
+// steady state never extends the file (no metadata sync). Use waitDurable(seq) when a caller must know its record
+// hit the disk.
+//
+// The pending batch is capped at maxPendingBytes and pre-reserved, so append() never reallocates under the mutex;
+// when the disk falls that far behind, append() waits for the flusher (backpressure) instead of growing without
+// bound. A failed write or fdatasync poisons the journal: the durable sequence stops where it was, waitDurable()
+// and every later append() rethrow the error, and nothing more is written (after a failed fdatasync the kernel may
+// already have dropped the dirty pages, so retrying could report data durable that is not).
+class TradeJournal {
+ public:
+  using Options = JournalOptions;
+
+  struct Stats {
+    std::uint64_t records;
+    std::uint64_t commits;
+    std::uint64_t bytes;
+    std::uint64_t durableSequence;
+    std::uint32_t segments;
+  };
+
+ private:
+  Options options_;
+
+  std::mutex batchMutex_;
+  std::condition_variable flushCondition_;
+  std::condition_variable durableCondition_;
+  std::condition_variable spaceCondition_;  // appenders waiting for the flusher to take the batch
+  std::vector<char> batch_;
+  std::vector<char> writing_;
+  std::uint64_t nextSequence_{1};
+  std::uint64_t batchLastSequence_{0};
+  bool flushRequested_{false};
+  bool stopping_{false};
+  std::exception_ptr failure_;  // first write/sync error; set once, under batchMutex_
+
+  std::atomic<std::uint64_t> durableSequence_{0};
+  std::atomic<std::uint64_t> records_{0};
+  std::atomic<std::uint64_t> commits_{0};
+  std::atomic<std::uint64_t> bytes_{0};
+
+  // Flusher-owned (segmentIndex_ is also read by getStats)
+  int fd_{-1};
+  std::atomic<std::uint32_t> segmentIndex_{0};
+  std::size_t segmentOffset_{0};
+
+  std::thread flusher_;
+
+  void openSegment(std::uint32_t index) {
+    if (fd_ >= 0) {
+      syncData(fd_);
+      ::close(fd_);
+    }
+
+    const auto path = segmentPath(options_.directory, index);
+    fd_ = ::open(path.c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644);
+    if (fd_ < 0) {
+      throw std::system_error(errno, std::generic_category(), "TradeJournal: open " + path.string());
+    }
+
+#if defined(__linux__)
+    const int rc = ::posix_fallocate(fd_, 0, static_cast<off_t>(options_.segmentBytes));
+#else
+    const int rc = ::ftruncate(fd_, static_cast<off_t>(options_.segmentBytes)) == 0 ? 0 : errno;
+#endif
+    if (rc != 0) {
+      throw std::system_error(rc, std::generic_category(), "TradeJournal: preallocate " + path.string());
+    }
+
+    // Make the allocation itself durable once, so later commits only need fdatasync, and the segment's directory
+    // entry with it; otherwise a crash can drop the whole file along with records already reported durable
+    if (::fsync(fd_) != 0) {
+      throw std::system_error(errno, std::generic_category(), "TradeJournal: fsync " + path.string());
+    }
+    syncDirectory(options_.directory);
+    segmentIndex_.store(index, std::memory_order_relaxed);
+    segmentOffset_ = 0;
+  }
+
+  // Writes `data` record by record so no record straddles two segments
+  void writeBatch(const std::vector<char>& data) {
+    std::size_t cursor = 0;
+    while (cursor < data.size()) {
+      std::size_t chunk = 0;
+      while (cursor + chunk < data.size()) {
+        RecordHeader header;
+        std::memcpy(&header, data.data() + cursor + chunk, sizeof(header));
+        if (segmentOffset_ + chunk + header.length > options_.segmentBytes) {
+          break;
+        }
+        chunk += header.length;
+      }
+
+      if (chunk == 0) {
+        openSegment(segmentIndex_.load(std::memory_order_relaxed) + 1);
+        continue;
+      }
+
+      std::size_t written = 0;
+      while (written < chunk) {
+        const auto rc = ::pwrite(fd_, data.data() + cursor + written, chunk - written,
+                                 static_cast<off_t>(segmentOffset_ + written));
+        if (rc < 0) {
+          if (errno == EINTR) {
+            continue;
+          }
+          throw std::system_error(errno, std::generic_category(), "TradeJournal: pwrite");
+        }
+        written += static_cast<std::size_t>(rc);
+      }
+      segmentOffset_ += chunk;
+      cursor += chunk;
+    }
+    syncData(fd_);
+  }
+
+  void flusherLoop() {
+    std::unique_lock<std::mutex> lock(batchMutex_);
+    while (true) {
+      flushCondition_.wait_for(lock, options_.commitWindow, [this] {
+        return stopping_ || flushRequested_ || batch_.size() >= options_.commitBytes;
+      });
+      flushRequested_ = false;
+
+      if (batch_.empty()) {
+        if (stopping_) {
+          break;
+        }
+        continue;
+      }
+
+      writing_.swap(batch_);
+      const std::uint64_t lastSequence = batchLastSequence_;
+      spaceCondition_.notify_all();
+      lock.unlock();
+
+      // An exception must not escape the thread (std::terminate): hand it to the callers instead
+      std::exception_ptr failure;
+      try {
+        writeBatch(writing_);
+        commits_.fetch_add(1, std::memory_order_relaxed);
+        bytes_.fetch_add(writing_.size(), std::memory_order_relaxed);
+      } catch (...) {
+        failure = std::current_exception();
+      }
+      writing_.clear();
+
+      lock.lock();
+      if (failure) {
+        failure_ = failure;
+        batch_.clear();
+        spaceCondition_.notify_all();
+        durableCondition_.notify_all();
+        break;
+      }
+      durableSequence_.store(lastSequence, std::memory_order_release);
+      durableCondition_.notify_all();
+    }
+  }
+
+  std::uint64_t append(RecordType type, std::string_view symbol, std::uint8_t action, double confidence,
+                       std::string_view reason) {
+    RecordHeader header{};
+    const auto reasonLength = static_cast<std::uint16_t>(std::min<std::size_t>(reason.size(), UINT16_MAX));
+    header.length = static_cast<std::uint32_t>(sizeof(RecordHeader) + reasonLength);
+    header.timestampNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                std::chrono::system_clock::now().time_since_epoch())
+                                .count();
+    header.confidence = confidence;
+    std::memcpy(header.symbol, symbol.data(), std::min(symbol.size(), sizeof(header.symbol) - 1));
+    header.type = type;
+    header.action = action;
+    header.reasonLength = reasonLength;
+
+    std::uint64_t sequence;
+    bool wakeFlusher;
+    {
+      std::unique_lock<std::mutex> lock(batchMutex_);
+      if (!failure_ && batch_.size() + header.length > options_.maxPendingBytes) {
+        flushRequested_ = true;
+        flushCondition_.notify_one();
+        spaceCondition_.wait(lock, [&] {
+          return failure_ || batch_.size() + header.length <= options_.maxPendingBytes;
+        });
+      }
+      if (failure_) {
+        std::rethrow_exception(failure_);
+      }
+      sequence = nextSequence_++;
+      header.sequence = sequence;
+
+      constexpr std::size_t crcOffset = offsetof(RecordHeader, sequence);
+      std::uint32_t crc = crc32(reinterpret_cast<const char*>(&header) + crcOffset, sizeof(header) - crcOffset);
+      header.crc = crc32(reason.data(), reasonLength, crc);
+
+      const std::size_t offset = batch_.size();
+      batch_.resize(offset + header.length);
+      std::memcpy(batch_.data() + offset, &header, sizeof(header));
+      std::memcpy(batch_.data() + offset + sizeof(header), reason.data(), reasonLength);
+      batchLastSequence_ = sequence;
+      wakeFlusher = batch_.size() >= options_.commitBytes;
+    }
+
+    records_.fetch_add(1, std::memory_order_relaxed);
+    if (wakeFlusher) {
+      flushCondition_.notify_one();
+    }
+    return sequence;
+  }
+
+ public:
+  explicit TradeJournal(Options options = {}) : options_(std::move(options)) {
+    if (options_.segmentBytes < sizeof(RecordHeader) + UINT16_MAX) {
+      throw std::invalid_argument("TradeJournal: segment too small for a maximum-size record");
+    }
+    if (options_.maxPendingBytes < std::max(options_.commitBytes, sizeof(RecordHeader) + UINT16_MAX)) {
+      throw std::invalid_argument("TradeJournal: maxPendingBytes below the commit size or a maximum-size record");
+    }
+    createDirectoriesDurably(options_.directory);
+
+    // Continue after the last existing segment (and its last sequence); replay reads them all in order
+    std::uint32_t next = 1;
+    while (std::filesystem::exists(segmentPath(options_.directory, next))) {
+      ++next;
+    }
+    if (next > 1) {
+      TradeJournalReader(options_.directory).replay([this](const Record& record) {
+        nextSequence_ = std::max(nextSequence_, record.sequence + 1);
+      });
+      durableSequence_.store(nextSequence_ - 1, std::memory_order_relaxed);
+    }
+    openSegment(next);
+
+    batch_.reserve(options_.maxPendingBytes);
+    writing_.reserve(options_.maxPendingBytes);
+    flusher_ = std::thread(&TradeJournal::flusherLoop, this);
+  }
+
+  TradeJournal(const TradeJournal&) = delete;
+  TradeJournal& operator=(const TradeJournal&) = delete;
+
+  ~TradeJournal() {
+    {
+      std::lock_guard<std::mutex> lock(batchMutex_);
+      stopping_ = true;
+    }
+    flushCondition_.notify_one();
+    if (flusher_.joinable()) {
+      flusher_.join();
+    }
+    if (fd_ >= 0) {
+      ::close(fd_);
+    }
+  }
+
+  std::uint64_t appendSignal(std::string_view symbol, std::uint8_t action, double confidence,
+                             std::string_view reason) {
+    return append(RecordType::Signal, symbol, action, confidence, reason);
+  }
+
+  std::uint64_t appendExecution(std::string_view symbol, std::uint8_t action, double confidence,
+                                std::string_view reason) {
+    return append(RecordType::Execution, symbol, action, confidence, reason);
+  }
+
+  // Block until the record with `sequence` (and everything before it) has been fdatasync'ed. Rethrows the write or
+  // sync error if the journal failed before getting there.
+  void waitDurable(std::uint64_t sequence) {
+    std::unique_lock<std::mutex> lock(batchMutex_);
+    const auto durable = [&] { return durableSequence_.load(std::memory_order_acquire) >= sequence; };
+    if (!durable() && !failure_) {
+      flushRequested_ = true;
+      flushCondition_.notify_one();
+      durableCondition_.wait(lock, [&] { return durable() || failure_; });
+    }
+    if (!durable()) {
+      std::rethrow_exception(failure_);
+    }
+  }
+
+  // The error that stopped the flusher, or null while the journal is healthy
+  std::exception_ptr failure() {
+    std::lock_guard<std::mutex> lock(batchMutex_);
+    return failure_;
+  }
+
+  Stats getStats() const {
+    return Stats{records_.load(std::memory_order_relaxed), commits_.load(std::memory_order_relaxed),
+                 bytes_.load(std::memory_order_relaxed), durableSequence_.load(std::memory_order_relaxed),
+                 segmentIndex_.load(std::memory_order_relaxed)};
+  }
+
+  const std::filesystem::path& directory() const { return options_.directory; }
+};
+
+}  // namespace journal
+
+#endif  // TRADE_JOURNAL_H
@@ -0,0 +1,352 @@
+/*
+Per-symbol state benchmark: actors on DynamicThreadPool vs the same state behind striped mutexes.
+
+🔍 Practice
+* Send fills from 1-8 producer threads into per-symbol position state split into 8 shards
+* Locked: each producer takes the shard's mutex and updates the state itself
+* Actors: each producer only pushes onto the shard actor's MPSC mailbox; one pool worker at a time owns the state
+* Pooled actors: the same, but fills travel in nodes the producer owns; the actor hands each node back to its
+producer's free list (another MPSC queue) after handling it, so nothing is allocated per message
+* Vary kBatchSize: small batches interleave actors fairly, large batches amortise the pool round trip
+
+✅ Success Checklist
+* Both variants end with identical positions and trade counts
+* Producers never block on the actor variants: one exchange plus one allocation per message with envelopes, one
+exchange plus one free-list pop with pooled nodes
+*/
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Actor.h"
+#include "DynamicThreadPool.h"
+#include "MicroBenchmark.h"
+#include "MpscQueue.h"
+
+namespace {
+
+constexpr int kSymbols = 1024;
+constexpr int kShards = 8;
+constexpr int kMessagesPerProducer = 50'000;
+constexpr std::size_t kBatchSize = 64;
+constexpr std::size_t kPoolThreads = 4;
+
+const microbench::Options kOptions{
+    .warmupRuns = 1, .minSamples = 5, .maxSamples = 20, .timeBudget = std::chrono::milliseconds(300)};
+
+struct Fill {
+  int symbol;
+  std::int32_t quantity;
+  double price;
+};
+
+struct Position {
+  std::int64_t quantity{0};
+  double notional{0.0};
+  std::uint64_t trades{0};
+
+  void apply(const Fill& fill) {
+    quantity += fill.quantity;
+    notional += fill.quantity * fill.price;
+    ++trades;
+  }
+};
+
+// A shard's slice of the symbol space; symbol s lives in shard s % kShards at index s / kShards
+using ShardState = std::array<Position, kSymbols / kShards>;
+
+// Deterministic per-producer fill stream, so both variants see the same messages
+template <typename Sink>
+void produce(int producer, Sink&& sink) {
+  std::mt19937 rng(static_cast<unsigned>(producer * 7919 + 17));
+  std::uniform_int_distribution<int> pickSymbol(0, kSymbols - 1);
+  std::uniform_int_distribution<int> pickQuantity(-100, 100);
+  for (int msg = 0; msg < kMessagesPerProducer; ++msg) {
+    sink(Fill{pickSymbol(rng), pickQuantity(rng), 100.0 + (msg % 64) * 0.25});
+  }
+}
+
+struct LockedShards {
+  struct alignas(64) Shard {
+    std::mutex mutex;
+    ShardState state;
+  };
+  std::array<Shard, kShards> shards;
+
+  void send(const Fill& fill) {
+    Shard& shard = shards[fill.symbol % kShards];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.state[fill.symbol / kShards].apply(fill);
+  }
+  void drain() {}
+  const ShardState& state(int shard) const { return shards[shard].state; }
+};
+
+struct ActorShards {
+  std::array<ShardState, kShards> states{};
+  std::vector<std::unique_ptr<Actor<Fill>>> actors;
+
+  explicit ActorShards(DynamicThreadPool& pool) {
+    for (int shard = 0; shard < kShards; ++shard) {
+      actors.push_back(std::make_unique<Actor<Fill>>(
+          pool, [this, shard](Fill& fill) { states[shard][fill.symbol / kShards].apply(fill); },
+          "positions-" + std::to_string(shard), kBatchSize));
+    }
+  }
+
+  void send(const Fill& fill) { actors[fill.symbol % kShards]->send(fill); }
+  void drain() {
+    for (auto& actor : actors) {
+      actor->drain();
+    }
+  }
+  const ShardState& state(int shard) const { return states[shard]; }
+
+  std::uint64_t turns() const {
+    std::uint64_t total = 0;
+    for (const auto& actor : actors) {
+      total += actor->stats().turns;
+    }
+    return total;
+  }
+};
+
+struct FreeFillNodes;
+
+// Caller-owned mailbox node; `home` is the free list of the producer that owns it
+struct FillNode : lockfree::MpscNode {
+  Fill fill;
+  FreeFillNodes* home{nullptr};
+};
+
+// One per producer: the producer is its only consumer, the actors' turns push nodes back
+struct alignas(64) FreeFillNodes {
+  lockfree::IntrusiveMpscQueue<FillNode> queue;
+};
+
+struct PooledActorShards {
+  static constexpr std::size_t kNodesPerProducer = 4096;
+
+  struct ProducerNodes {
+    std::unique_ptr<FillNode[]> nodes{new FillNode[kNodesPerProducer]};
+    FreeFillNodes free;
+  };
+
+  std::array<ShardState, kShards> states{};
+  std::vector<std::unique_ptr<ProducerNodes>> producers;
+  std::vector<std::unique_ptr<Actor<FillNode>>> actors;
+
+  PooledActorShards(DynamicThreadPool& pool, int producerCount) {
+    for (int p = 0; p < producerCount; ++p) {
+      auto& owned = *producers.emplace_back(std::make_unique<ProducerNodes>());
+      for (std::size_t idx = 0; idx < kNodesPerProducer; ++idx) {
+        owned.nodes[idx].home = &owned.free;
+        owned.free.queue.push(&owned.nodes[idx]);
+      }
+    }
+    for (int shard = 0; shard < kShards; ++shard) {
+      actors.push_back(std::make_unique<Actor<FillNode>>(
+          pool, [this, shard](FillNode& node) { states[shard][node.fill.symbol / kShards].apply(node.fill); },
+          [](FillNode* node) { node->home->queue.push(node); }, "positions-" + std::to_string(shard), kBatchSize));
+    }
+  }
+
+  // Waits for a node to come back when all of the producer's nodes are in flight
+  void send(int producer, const Fill& fill) {
+    auto& free = producers[producer]->free.queue;
+    FillNode* node = free.pop();
+    while (node == nullptr) {
+      std::this_thread::yield();
+      node = free.pop();
+    }
+    node->fill = fill;
+    actors[fill.symbol % kShards]->send(node);
+  }
+  void drain() {
+    for (auto& actor : actors) {
+      actor->drain();
+    }
+  }
+  const ShardState& state(int shard) const { return states[shard]; }
+
+  std::uint64_t turns() const {
+    std::uint64_t total = 0;
+    for (const auto& actor : actors) {
+      total += actor->stats().turns;
+    }
+    return total;
+  }
+};
+
+template <typename Shards>
+void sendFrom(Shards& shards, int producer, const Fill& fill) {
+  if constexpr (requires { shards.send(producer, fill); }) {
+    shards.send(producer, fill);
+  } else {
+    shards.send(fill);
+  }
+}
+
+// Time from the first send until every fill has been applied
+template <typename Shards>
+std::chrono::nanoseconds runFills(Shards& shards, int producers) {
+  std::atomic<bool> go{false};
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p) {
+    threads.emplace_back([&, p] {
+      while (!go.load(std::memory_order_acquire)) {
+      }
+      produce(p, [&](const Fill& fill) { sendFrom(shards, p, fill); });
+    });
+  }
+  const auto start = microbench::Clock::now();
+  go.store(true, std::memory_order_release);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  shards.drain();
+  return microbench::Clock::now() - start;
+}
+
+template <typename A, typename B>
+bool sameState(const A& left, const B& right) {
+  for (int shard = 0; shard < kShards; ++shard) {
+    for (std::size_t idx = 0; idx < ShardState{}.size(); ++idx) {
+      const Position& l = left.state(shard)[idx];
+      const Position& r = right.state(shard)[idx];
+      if (l.quantity != r.quantity || l.trades != r.trades) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// DynamicThreadPool announces start-up and shutdown on stdout; keep --csv/--json output parseable
+class QuietStdout {
+ private:
+  std::streambuf* saved_;
+
+ public:
+  explicit QuietStdout(bool quiet) : saved_(quiet ? std::cout.rdbuf(nullptr) : nullptr) {}
+  ~QuietStdout() {
+    if (saved_ != nullptr) {
+      std::cout.rdbuf(saved_);
+    }
+  }
+};
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  const auto format = microbench::formatFromArgs(argc, argv);
+  const bool quiet = format != microbench::Format::Table;
+
+  std::unique_ptr<DynamicThreadPool> pool;
+  {
+    QuietStdout mute(quiet);
+    pool = std::make_unique<DynamicThreadPool>(kPoolThreads, kPoolThreads);
+  }
+  pool->setTaskTracing(false);
+
+  {
+    LockedShards locked;
+    ActorShards actors(*pool);
+    PooledActorShards pooled(*pool, 4);
+    runFills(locked, 4);
+    runFills(actors, 4);
+    runFills(pooled, 4);
+    if (!sameState(locked, actors) || !sameState(locked, pooled)) {
+      std::cerr << "Locked and actor positions disagree" << std::endl;
+      return 1;
+    }
+  }
+
+  struct Row {
+    int producers;
+    microbench::Summary locked;
+    microbench::Summary actors;
+    microbench::Summary pooled;
+    double messagesPerTurn;
+  };
+  std::vector<Row> rows;
+  for (const int producers : {1, 2, 4, 8}) {
+    const std::string suffix = "/" + std::to_string(producers) + "prod";
+    auto locked = microbench::measureTimed(
+        "striped-mutex" + suffix,
+        [&] {
+          auto shards = std::make_unique<LockedShards>();
+          return runFills(*shards, producers);
+        },
+        kOptions);
+    std::uint64_t turns = 0;
+    std::uint64_t runs = 0;
+    auto actors = microbench::measureTimed(
+        "actors" + suffix,
+        [&] {
+          ActorShards shards(*pool);
+          const auto elapsed = runFills(shards, producers);
+          turns += shards.turns();
+          ++runs;
+          return elapsed;
+        },
+        kOptions);
+    auto pooled = microbench::measureTimed(
+        "actors-pooled-nodes" + suffix,
+        [&] {
+          PooledActorShards shards(*pool, producers);
+          return runFills(shards, producers);
+        },
+        kOptions);
+    const double messages = static_cast<double>(kMessagesPerProducer) * producers * runs;
+    rows.push_back(
+        Row{producers, std::move(locked), std::move(actors), std::move(pooled), turns ? messages / turns : 0.0});
+  }
+
+  if (quiet) {
+    std::vector<microbench::Summary> summaries;
+    for (const auto& row : rows) {
+      summaries.push_back(row.locked);
+      summaries.push_back(row.actors);
+      summaries.push_back(row.pooled);
+    }
+    microbench::write(std::cout, summaries, format);
+  } else {
+    std::cout << "=== Per-symbol state: striped mutexes vs actors (" << kMessagesPerProducer << " fills per producer, "
+              << kShards << " shards, " << kPoolThreads << " pool threads) ===" << std::endl;
+    std::cout << std::left << std::setw(6) << "Prod" << std::setw(16) << "mutex ns/fill" << std::setw(16)
+              << "actor ns/fill" << std::setw(10) << "Speedup" << std::setw(8) << "+-%" << std::setw(17)
+              << "pooled ns/fill" << std::setw(10) << "Speedup" << std::setw(12) << "Msgs/turn" << std::endl;
+    std::cout << std::string(95, '-') << std::endl;
+    std::cout << std::fixed;
+    for (const auto& row : rows) {
+      const double fills = static_cast<double>(kMessagesPerProducer) * row.producers;
+      const auto comparison = microbench::compare(row.locked, row.actors);
+      const auto pooledComparison = microbench::compare(row.locked, row.pooled);
+      std::cout << std::left << std::setw(6) << row.producers << std::setprecision(1) << std::setw(16)
+                << row.locked.medianNanos / fills << std::setw(16) << row.actors.medianNanos / fills << std::setw(10)
+                << (std::to_string(comparison.speedup).substr(0, 5) + (comparison.significant ? "*" : ""))
+                << std::setw(8) << row.actors.relativeError() * 100.0 << std::setw(17)
+                << row.pooled.medianNanos / fills << std::setw(10)
+                << (std::to_string(pooledComparison.speedup).substr(0, 5) + (pooledComparison.significant ? "*" : ""))
+                << std::setw(12) << row.messagesPerTurn << std::endl;
+    }
+    std::cout << "\nSpeedup = mutex time / actor time (* = 95% CIs do not overlap); +-% is the envelope actors'"
+              << "\nrelative CI half-width; pooled = caller-owned nodes recycled through per-producer free lists."
+              << "\nMsgs/turn is the envelope actors' average batch per pool task (cap " << kBatchSize
+              << ")." << std::endl;
+  }
+
+  QuietStdout mute(quiet);
+  pool.reset();
+  return 0;
+}
@@ -0,0 +1,162 @@
+/*
+Benchmark for BarAggregator: multi-timeframe (1s/1m/5m) OHLC bars across thousands of symbols.
+
+🔍 Practice
+* Replay synthetic ticks at full rate and measure ns/tick and ticks/sec
+* Compare the symbol-id overload with the string overload the processor uses (one hash map lookup per tick)
+* Vary the symbol count (500, 5000, 20000) and watch when the working set falls out of cache
+* Confirm the hot loop performs zero heap allocations once symbols are registered
+
+✅ Success Checklist
+* Every tick updates all timeframes and bar-close events are delivered to subscribers
+* A tick for a bucket flush() has already closed is counted as late and never produces a second close
+* Allocation count during the replay is 0
+* Throughput stays well above the real-time feed rate
+*/
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BarAggregator.h"
+
+// Count every heap allocation so the benchmark can prove the tick path is allocation-free
+namespace {
+std::atomic<std::uint64_t> gAllocations{0};
+}
+
+void* operator new(std::size_t size) {
+  gAllocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+struct SyntheticTick {
+  std::uint32_t symbolId;
+  double price;
+  std::int32_t volume;
+};
+
+enum class Lookup { ById, ByName };
+
+void runBenchmark(std::size_t symbolCount, std::size_t tickCount, std::chrono::nanoseconds tickSpacing,
+                  Lookup lookup) {
+  using namespace std::chrono_literals;
+
+  BarAggregator aggregator({1s, 1min, 5min}, symbolCount);
+  std::uint64_t barEvents = 0;
+  double checksum = 0.0;
+  aggregator.subscribe([&](const BarCloseEvent& event) {
+    ++barEvents;
+    checksum += event.bar.close;
+  });
+
+  std::vector<std::string> names;
+  names.reserve(symbolCount);
+  for (std::size_t idx = 0; idx < symbolCount; ++idx) {
+    names.push_back("SYM" + std::to_string(idx));
+    aggregator.registerSymbol(names.back());
+  }
+
+  // Pre-generate the tape so RNG cost stays out of the measurement
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<std::uint32_t> symbolDist(0, static_cast<std::uint32_t>(symbolCount - 1));
+  std::normal_distribution<double> moveDist(0.0, 0.05);
+  std::uniform_int_distribution<std::int32_t> volumeDist(100, 10000);
+  std::vector<double> lastPrice(symbolCount, 100.0);
+  std::vector<SyntheticTick> tape;
+  tape.reserve(tickCount);
+  for (std::size_t idx = 0; idx < tickCount; ++idx) {
+    const auto symbol = symbolDist(rng);
+    lastPrice[symbol] += moveDist(rng);
+    tape.push_back(SyntheticTick{symbol, lastPrice[symbol], volumeDist(rng)});
+  }
+
+  const auto feedStart = BarAggregator::Clock::now();
+  const auto allocationsBefore = gAllocations.load(std::memory_order_relaxed);
+  const auto wallStart = std::chrono::steady_clock::now();
+
+  auto feedTime = feedStart;
+  if (lookup == Lookup::ById) {
+    for (const auto& tick : tape) {
+      feedTime += tickSpacing;
+      aggregator.onTick(tick.symbolId, tick.price, tick.volume, feedTime);
+    }
+  } else {
+    for (const auto& tick : tape) {
+      feedTime += tickSpacing;
+      aggregator.onTick(names[tick.symbolId], tick.price, tick.volume, feedTime);
+    }
+  }
+
+  const auto wallEnd = std::chrono::steady_clock::now();
+  const auto allocations = gAllocations.load(std::memory_order_relaxed) - allocationsBefore;
+
+  const double seconds = std::chrono::duration<double>(wallEnd - wallStart).count();
+  const double nsPerTick = seconds * 1e9 / static_cast<double>(tickCount);
+  const double simulatedSeconds = std::chrono::duration<double>(feedTime - feedStart).count();
+
+  std::cout << std::left << std::setw(8) << (lookup == Lookup::ById ? "id" : "string") << std::setw(10)
+            << symbolCount << std::setw(12) << tickCount << std::setw(12) << std::fixed << std::setprecision(1)
+            << simulatedSeconds << std::setw(12) << std::setprecision(2) << nsPerTick << std::setw(16)
+            << std::setprecision(0) << (tickCount / seconds) << std::setw(14) << barEvents << std::setw(12)
+            << allocations << std::endl;
+
+  if (checksum == 0.0) {
+    std::cout << "(no bars closed)" << std::endl;
+  }
+}
+
+// flush() closes a bar on wall-clock time while ticks for that bucket may still be queued: such a tick is late
+bool flushThenLateTickClosesOnce() {
+  using namespace std::chrono_literals;
+
+  BarAggregator aggregator({1s}, 1);
+  std::uint64_t closes = 0;
+  aggregator.subscribe([&](const BarCloseEvent&) { ++closes; });
+
+  const BarAggregator::Clock::time_point bucket{10s};
+  aggregator.onTick("AAPL", 100.0, 10, bucket + 100ms);
+  aggregator.flush(bucket + 1s);
+  const std::uint64_t afterFlush = closes;
+  aggregator.onTick("AAPL", 101.0, 10, bucket + 900ms);  // same, already closed bucket
+  aggregator.flush(bucket + 5s);
+
+  return afterFlush == 1 && closes == 1 && aggregator.lateTicks() == 1 &&
+         aggregator.currentBar(aggregator.symbolId("AAPL"), 0) == nullptr;
+}
+
+int main() {
+  using namespace std::chrono_literals;
+
+  if (!flushThenLateTickClosesOnce()) {
+    std::cerr << "A tick after flush() reopened a closed bar" << std::endl;
+    return 1;
+  }
+
+  std::cout << "=== BarAggregator throughput (1s / 1m / 5m) ===" << std::endl;
+  std::cout << std::left << std::setw(8) << "Path" << std::setw(10) << "Symbols" << std::setw(12) << "Ticks"
+            << std::setw(12) << "SimSec" << std::setw(12) << "ns/tick" << std::setw(16) << "ticks/sec" << std::setw(14)
+            << "BarCloses" << std::setw(12) << "Allocs" << std::endl;
+  std::cout << std::string(96, '-') << std::endl;
+
+  // 2M ticks spread over ~10 simulated minutes
+  for (const std::size_t symbols : {500u, 5000u, 20000u}) {
+    runBenchmark(symbols, 2'000'000, 300us, Lookup::ById);
+    runBenchmark(symbols, 2'000'000, 300us, Lookup::ByName);
+  }
+
+  return 0;
+}
@@ -0,0 +1,172 @@
+/*
+Full-refresh benchmark for CorrelationMatrix: the pool-parallel refreshAll against the band-per-call
+startRefresh/refreshStep pass the processor runs on its price-table consumer.
+
+🔍 Practice
+* Compare one whole pass on the caller with the same pass fanned out to a 4-thread strict-priority pool and to an
+earliest-deadline-first pool like the processor's
+* Divide the serial pass by the band count to get the cost refreshStep adds to a single tick
+* Rerun on a machine with more cores than pool threads: on one core the pool can only add hand-off cost
+
+✅ Success Checklist
+* Every refresh path reproduces computeCorrelation for every pair
+* refreshAll only wins once the pass is large enough to pay for one task and one wake-up per band
+*/
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "CorrelationMatrix.h"
+#include "DynamicThreadPool.h"
+#include "MicroBenchmark.h"
+
+namespace {
+
+constexpr std::size_t kWindow = 120;
+constexpr std::size_t kPoolThreads = 4;
+
+const microbench::Options kOptions{
+    .warmupRuns = 2, .minSamples = 10, .maxSamples = 50, .timeBudget = std::chrono::milliseconds(300)};
+
+using EdfPool = BasicDynamicThreadPool<scheduling::EarliestDeadlineFirst>;
+
+// A full window of sparse samples: about a third of the symbols tick in each one
+void fillWindow(CorrelationMatrix& matrix) {
+  std::mt19937 rng(42);
+  std::normal_distribution<double> returns(0.0, 0.01);
+  std::bernoulli_distribution ticked(1.0 / 3.0);
+  for (std::size_t sample = 0; sample < kWindow; ++sample) {
+    for (std::size_t id = 0; id < matrix.symbols(); ++id) {
+      if (ticked(rng)) {
+        matrix.addReturn(id, returns(rng));
+      }
+    }
+    matrix.commitSample();
+  }
+}
+
+void refreshSerial(CorrelationMatrix& matrix) {
+  matrix.startRefresh();
+  while (!matrix.refreshStep()) {
+  }
+}
+
+// Largest |correlation - computeCorrelation| over every pair
+double maxError(const CorrelationMatrix& matrix) {
+  double worst = 0.0;
+  for (std::size_t i = 0; i < matrix.symbols(); ++i) {
+    for (std::size_t j = 0; j < matrix.symbols(); ++j) {
+      worst = std::max(worst, std::abs(matrix.correlation(i, j) - matrix.computeCorrelation(i, j)));
+    }
+  }
+  return worst;
+}
+
+class QuietStdout {
+ private:
+  std::streambuf* saved_;
+
+ public:
+  explicit QuietStdout(bool quiet) : saved_(quiet ? std::cout.rdbuf(nullptr) : nullptr) {}
+  ~QuietStdout() {
+    if (saved_ != nullptr) {
+      std::cout.rdbuf(saved_);
+    }
+  }
+};
+
+struct Row {
+  std::size_t symbols;
+  microbench::Summary serial;
+  microbench::Summary strict;
+  microbench::Summary edf;
+};
+
+void printTable(const std::vector<Row>& rows) {
+  std::cout << "\n=== CorrelationMatrix full refresh (window " << kWindow << ", " << kPoolThreads
+            << " pool threads, " << std::thread::hardware_concurrency() << " hardware threads) ===" << std::endl;
+  std::cout << std::left << std::setw(9) << "Symbols" << std::setw(7) << "Bands" << std::setw(12) << "pass us"
+            << std::setw(12) << "per step us" << std::setw(12) << "strict us" << std::setw(10) << "vs pass"
+            << std::setw(12) << "edf us" << std::setw(10) << "vs pass" << std::endl;
+  std::cout << std::string(84, '-') << std::endl;
+  std::cout << std::fixed;
+  for (const auto& row : rows) {
+    const std::size_t bands = (row.symbols + CorrelationMatrix::kTile - 1) / CorrelationMatrix::kTile;
+    const auto strict = microbench::compare(row.serial, row.strict);
+    const auto edf = microbench::compare(row.serial, row.edf);
+    std::cout << std::left << std::setw(9) << row.symbols << std::setw(7) << bands << std::setprecision(1)
+              << std::setw(12) << row.serial.medianNanos / 1e3 << std::setw(12)
+              << row.serial.medianNanos / 1e3 / static_cast<double>(bands) << std::setw(12)
+              << row.strict.medianNanos / 1e3 << std::setw(10)
+              << (std::to_string(strict.speedup).substr(0, 5) + (strict.significant ? "*" : "")) << std::setw(12)
+              << row.edf.medianNanos / 1e3 << std::setw(10)
+              << (std::to_string(edf.speedup).substr(0, 5) + (edf.significant ? "*" : "")) << std::endl;
+  }
+  std::cout << "\npass = startRefresh + refreshStep until done, on the caller; per step = what one tick pays for it."
+            << "\nvs pass = pass time / refreshAll time (* = 95% CIs do not overlap)." << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  const auto format = microbench::formatFromArgs(argc, argv);
+  const bool quiet = format != microbench::Format::Table;
+
+  // The pools announce themselves and every scale-up on stdout
+  std::unique_ptr<DynamicThreadPool> strictPool;
+  std::unique_ptr<EdfPool> edfPool;
+  {
+    QuietStdout mute(quiet);
+    strictPool = std::make_unique<DynamicThreadPool>(kPoolThreads, kPoolThreads);
+    edfPool = std::make_unique<EdfPool>(kPoolThreads, kPoolThreads);
+  }
+  strictPool->setTaskTracing(false);
+  edfPool->setTaskTracing(false);
+
+  std::vector<Row> rows;
+  for (const std::size_t symbols : {256u, 1024u, 2048u}) {
+    CorrelationMatrix matrix(symbols, kWindow);
+    fillWindow(matrix);
+
+    const std::string suffix = "/" + std::to_string(symbols) + "sym";
+    auto serial = microbench::measure("refreshStep-pass" + suffix, [&] { refreshSerial(matrix); }, kOptions);
+    const double serialError = maxError(matrix);
+    auto strict =
+        microbench::measure("refreshAll-strict" + suffix, [&] { matrix.refreshAll(*strictPool); }, kOptions);
+    const double strictError = maxError(matrix);
+    auto edf = microbench::measure("refreshAll-edf" + suffix, [&] { matrix.refreshAll(*edfPool); }, kOptions);
+    const double edfError = maxError(matrix);
+
+    if (std::max({serialError, strictError, edfError}) > 1e-9) {
+      std::cerr << "Refresh disagrees with computeCorrelation at " << symbols << " symbols (max error "
+                << std::max({serialError, strictError, edfError}) << ")" << std::endl;
+      return 1;
+    }
+    rows.push_back(Row{symbols, std::move(serial), std::move(strict), std::move(edf)});
+  }
+
+  if (format != microbench::Format::Table) {
+    std::vector<microbench::Summary> summaries;
+    for (const auto& row : rows) {
+      summaries.push_back(row.serial);
+      summaries.push_back(row.strict);
+      summaries.push_back(row.edf);
+    }
+    microbench::write(std::cout, summaries, format);
+  } else {
+    printTable(rows);
+  }
+
+  QuietStdout mute(quiet);
+  strictPool.reset();
+  edfPool.reset();
+  return 0;
+}
@@ -0,0 +1,220 @@
+/*
+Point-lookup benchmark: StripedHashMap vs std::map behind one shared_mutex (ThreadSafeMap).
+
+🔍 Practice
+* Scale reader threads from 1 to 8, alone and next to one writer, and see whether throughput follows the thread count
+* Look up keys straight out of a packed char buffer: the striped map takes the string_view, ThreadSafeMap needs a
+std::string built for every call
+* Rerun with StripedHashMap<double, 1> (one shard, no striping) to separate what striping buys from what hashing buys
+
+✅ Success Checklist
+* Both maps agree on the final contents of a deterministic single-threaded run
+* With a writer running, the striped map's lookup rate barely moves while the single-lock map's drops
+*/
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "MicroBenchmark.h"
+#include "StripedHashMap.h"
+#include "ThreadSafeMap.h"
+
+namespace {
+
+constexpr int kKeySpace = 4096;
+constexpr int kKeyLength = 10;  // "stock%05d"
+constexpr int kLookupsPerThread = 100'000;
+
+const microbench::Options kOptions{
+    .warmupRuns = 1, .minSamples = 5, .maxSamples = 20, .timeBudget = std::chrono::milliseconds(300)};
+
+// All symbols back to back in one buffer, the way they arrive in a feed packet
+const std::string& symbolBuffer() {
+  static const std::string buffer = [] {
+    std::string packed;
+    char symbol[16];
+    for (int idx = 0; idx < kKeySpace; ++idx) {
+      std::snprintf(symbol, sizeof(symbol), "stock%05d", idx);
+      packed.append(symbol, kKeyLength);
+    }
+    return packed;
+  }();
+  return buffer;
+}
+
+std::string_view symbolAt(int idx) { return std::string_view(symbolBuffer()).substr(idx * kKeyLength, kKeyLength); }
+
+// Adapters: ThreadSafeMap only takes std::string keys
+struct LockedMap {
+  ThreadSafeMap<double> map;
+
+  void insert(std::string_view key, double value) { map.insert(std::string(key), value); }
+  void erase(std::string_view key) { map.erase(std::string(key)); }
+  double find(std::string_view key) const {
+    double value = 0.0;
+    return map.find(std::string(key), value) ? value : -1.0;
+  }
+};
+
+struct StripedMap {
+  StripedHashMap<double> map;
+
+  void insert(std::string_view key, double value) { map.insertOrAssign(key, value); }
+  void erase(std::string_view key) { map.erase(key); }
+  double find(std::string_view key) const {
+    double value = 0.0;
+    return map.find(key, value) ? value : -1.0;
+  }
+};
+
+// Three quarters of the keys present; the optional writer inserts and erases random keys until the readers finish.
+// Only the readers are timed.
+template <typename Map>
+std::chrono::nanoseconds runLookups(int readers, bool withWriter) {
+  Map map;
+  for (int idx = 0; idx < kKeySpace; ++idx) {
+    if (idx % 4 != 0) {
+      map.insert(symbolAt(idx), 100.0 + idx);
+    }
+  }
+
+  std::atomic<bool> go{false};
+  std::atomic<bool> done{false};
+  std::thread writer;
+  if (withWriter) {
+    writer = std::thread([&] {
+      std::mt19937 rng(7);
+      std::uniform_int_distribution<int> pickKey(0, kKeySpace - 1);
+      while (!go.load(std::memory_order_acquire)) {
+      }
+      for (int op = 0; !done.load(std::memory_order_relaxed); ++op) {
+        if ((op & 1) == 0) {
+          map.insert(symbolAt(pickKey(rng)), static_cast<double>(op));
+        } else {
+          map.erase(symbolAt(pickKey(rng)));
+        }
+      }
+    });
+  }
+
+  std::vector<std::thread> workers;
+  for (int t = 0; t < readers; ++t) {
+    workers.emplace_back([&, t] {
+      std::mt19937 rng(static_cast<unsigned>(t * 7919 + 17));
+      std::uniform_int_distribution<int> pickKey(0, kKeySpace - 1);
+      while (!go.load(std::memory_order_acquire)) {
+      }
+      for (int op = 0; op < kLookupsPerThread; ++op) {
+        microbench::DoNotOptimize(map.find(symbolAt(pickKey(rng))));
+      }
+    });
+  }
+  const auto start = microbench::Clock::now();
+  go.store(true, std::memory_order_release);
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  const auto elapsed = microbench::Clock::now() - start;
+  done.store(true, std::memory_order_relaxed);
+  if (writer.joinable()) {
+    writer.join();
+  }
+  return elapsed;
+}
+
+// Same deterministic single-threaded sequence on both maps; the contents must match
+bool mapsAgree() {
+  ThreadSafeMap<double> locked;
+  StripedHashMap<double> striped;
+  std::mt19937 rng(42);
+  for (int op = 0; op < 100'000; ++op) {
+    const std::string_view key = symbolAt(static_cast<int>(rng() % kKeySpace));
+    if (op % 3 == 0) {
+      locked.erase(std::string(key));
+      striped.erase(key);
+    } else if (op % 3 == 1) {
+      locked.insert(std::string(key), op);
+      striped.insertOrAssign(key, static_cast<double>(op));
+    } else {
+      striped.update(key, [](double& value) { value += 0.5; });
+      if (double value = 0.0; locked.find(std::string(key), value)) {
+        locked.insert(std::string(key), value + 0.5);
+      }
+    }
+  }
+  if (locked.size() != striped.size()) {
+    return false;
+  }
+  for (const auto& [key, value] : locked.getAllEntries()) {
+    if (striped.get(key) != value) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  const auto format = microbench::formatFromArgs(argc, argv);
+  if (!mapsAgree()) {
+    std::cerr << "ThreadSafeMap and StripedHashMap disagree" << std::endl;
+    return 1;
+  }
+
+  struct Row {
+    int readers;
+    bool withWriter;
+    microbench::Summary locked;
+    microbench::Summary striped;
+  };
+  std::vector<Row> rows;
+  for (const bool withWriter : {false, true}) {
+    for (const int readers : {1, 2, 4, 8}) {
+      const std::string suffix = "/" + std::to_string(readers) + "rd" + (withWriter ? "+1wr" : "");
+      auto locked = microbench::measureTimed(
+          "shared_mutex-map" + suffix, [&] { return runLookups<LockedMap>(readers, withWriter); }, kOptions);
+      auto striped = microbench::measureTimed(
+          "striped-hash" + suffix, [&] { return runLookups<StripedMap>(readers, withWriter); }, kOptions);
+      rows.push_back(Row{readers, withWriter, std::move(locked), std::move(striped)});
+    }
+  }
+
+  if (format != microbench::Format::Table) {
+    std::vector<microbench::Summary> summaries;
+    for (const auto& row : rows) {
+      summaries.push_back(row.locked);
+      summaries.push_back(row.striped);
+    }
+    microbench::write(std::cout, summaries, format);
+    return 0;
+  }
+
+  std::cout << "=== Point lookups: ThreadSafeMap vs StripedHashMap (" << kLookupsPerThread << " lookups per reader, "
+            << kKeySpace << " keys) ===" << std::endl;
+  std::cout << std::left << std::setw(8) << "Readers" << std::setw(8) << "Writer" << std::setw(20)
+            << "shared_mutex Mops/s" << std::setw(18) << "striped Mops/s" << std::setw(10) << "Speedup"
+            << std::setw(8) << "+-%" << std::endl;
+  std::cout << std::string(72, '-') << std::endl;
+  std::cout << std::fixed;
+  for (const auto& row : rows) {
+    const double lookups = static_cast<double>(kLookupsPerThread) * row.readers;
+    const auto comparison = microbench::compare(row.locked, row.striped);
+    std::cout << std::left << std::setw(8) << row.readers << std::setw(8) << (row.withWriter ? "yes" : "no")
+              << std::setprecision(2) << std::setw(20) << lookups * 1e3 / row.locked.medianNanos << std::setw(18)
+              << lookups * 1e3 / row.striped.medianNanos << std::setw(10)
+              << (std::to_string(comparison.speedup).substr(0, 5) + (comparison.significant ? "*" : ""))
+              << std::setprecision(1) << std::setw(8) << row.striped.relativeError() * 100.0 << std::endl;
+  }
+  std::cout << "\nSpeedup = shared_mutex time / striped time (* = 95% CIs do not overlap); +-% is the striped map's"
+            << "\nrelative CI half-width. Only reader time is measured; the writer churns until the readers finish."
+            << std::endl;
+  return 0;
+}
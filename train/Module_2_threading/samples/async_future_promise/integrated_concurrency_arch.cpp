@@ -45,19 +45,34 @@ distributed computing clusters
 */
 #include <chrono>
 #include <cmath>
+#include <cstdlib>
+#include <filesystem>
 #include <iostream>
 #include <mutex>
 #include <optional>
 #include <random>
-#include <shared_mutex>
+#include <stop_token>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <unordered_map>
 #include <variant>
 #include <vector>
 
-#include "AsyncTaskManager.h"
+#include "BarAggregator.h"
+#include "ContentionCounters.h"
+#include "CorrelationMatrix.h"
 #include "DynamicThreadPool.h"
+#include "ExecutionGateway.h"
 #include "LockFreeQueue.h"
+#include "MarketProcessorConfig.h"
+#include "MulticastRingBuffer.h"
+#include "PositionRiskTable.h"
+#include "RcuPointer.h"
+#include "SharedMemoryTransport.h"
+#include "StripedHashMap.h"
+#include "TopMoversBoard.h"
+#include "TradeJournal.h"
 #include "logging.h"
 
 // Market data types
@@ -88,56 +103,250 @@ using MarketData = std::variant<MarketTick, TradeSignal>;
 
 class RealTimeMarketProcessor {
  private:
-  DynamicThreadPool threadPool_;
+  // Tunables, hot-swappable: registered reader threads read them with one acquire load and report quiescent points
+  RcuPointer<MarketProcessorConfig> config_{std::make_unique<MarketProcessorConfig>()};
+
+  // Earliest deadline first: move analyses carry the deadline by which their signal is still worth trading, and the
+  // long-running ingest/signal loops are services with no deadline at all
+  using ProcessorPool = BasicDynamicThreadPool<scheduling::EarliestDeadlineFirst>;
+  static constexpr auto MOVE_ANALYSIS_BUDGET = std::chrono::milliseconds(250);
+  ProcessorPool threadPool_;
   LockFreeQueue<MarketData> dataQueue_;
-  AsyncTaskManager<TradeSignal> signalProcessor_;
-  std::vector <
 
-      // Market data storage
-      std::unordered_map<std::string, MarketTick> latestPrices_;
-  mutable std::shared_mutex pricesMutex_;
+  // Tick fan-out: one write per tick, every consumer reads the same slot
+  static constexpr size_t TICK_RING_CAPACITY = 1 << 14;
+  using TickRing = MulticastRingBuffer<MarketTick, TICK_RING_CAPACITY>;
+  TickRing tickRing_;
+  TickRing::ConsumerId priceTableConsumer_;
+  TickRing::ConsumerId indicatorConsumer_;
+  TickRing::ConsumerId recorderConsumer_;
+  TickRing::ConsumerId riskConsumer_;
+
+  // Market data storage
+  // Written only by the price-table consumer; read by the signal generator (forEach) and the monitor (size). Striping
+  // means a reader holds one shard at a time, so the writer waits only when it needs that shard. Symbols hash onto
+  // 64 shards, so several symbols share each lock.
+  StripedHashMap<MarketTick> latestPrices_;
+
+  // OHLC bars (1s/1m/5m), owned by the price-table consumer thread
+  static constexpr size_t MAX_SYMBOLS = 4096;
+  BarAggregator bars_{{std::chrono::seconds(1), std::chrono::minutes(1), std::chrono::minutes(5)}, MAX_SYMBOLS};
+
+  // Rolling correlation of 1s bar returns for the first CORRELATION_SYMBOLS symbols, same owner thread as bars_
+  static constexpr size_t CORRELATION_SYMBOLS = 256;
+  static constexpr size_t CORRELATION_WINDOW = 120;
+  CorrelationMatrix correlations_{CORRELATION_SYMBOLS, CORRELATION_WINDOW};
+  int64_t correlationBucket_{0};
+  bool correlationPending_{false};
+
+  // Incremental top-N leaderboard, readable lock-free from the monitor thread
+  static constexpr size_t TOP_MOVERS = 5;
+  TopMoversBoard<TOP_MOVERS, 16> movers_;
+
+  // Durable record of every signal and execution (group-committed in the background)
+  journal::TradeJournal journal_;
+
+  // Per-symbol positions and limits; pre-trade checks are a single CAS and never touch latestPrices_
+  static constexpr size_t MAX_RISK_SYMBOLS = 4096;
+  static constexpr int32_t ORDER_QUANTITY = 100;
+  PositionRiskTable risk_{MAX_RISK_SYMBOLS};
+
+  // Orders leave through the gateway; completions arrive on its thread, so no pool worker waits on a venue
+  ExecutionGateway gateway_;
 
   // Analytics components
   std::atomic<size_t> ticksProcessed_{0};
   std::atomic<size_t> signalsGenerated_{0};
   std::atomic<double> averageProcessingLatency_{0.0};
+  std::atomic<size_t> ticksRecorded_{0};
+  std::atomic<size_t> riskAlerts_{0};
+  std::atomic<size_t> barsClosed_{0};
+  std::atomic<size_t> correlationSamples_{0};
+  std::atomic<size_t> riskRejections_{0};
+  std::atomic<size_t> analysesShed_{0};
+  std::atomic<size_t> journalFailures_{0};  // signals dropped or fills left unrecorded because the journal failed
 
-  // Configuration
-  const double PRICE_CHANGE_THRESHOLD = 0.05;  // 5% price change threshold
-  const size_t BATCH_SIZE = 100;
+  // Indicator state is owned by the indicator consumer thread only
+  std::unordered_map<std::string, double> emaPrices_;
+
+  std::atomic<size_t> configReloads_{0};
+  std::jthread configWatcher_;
+
+  // Declared last so consumers stop before the state they touch is destroyed
+  std::vector<std::jthread> tickConsumers_;
 
  public:
-  RealTimeMarketProcessor(size_t minThreads = 4, size_t maxThreads = 16) : threadPool_(minThreads, maxThreads) {
+  // Each processor process needs its own journal directory when several run on one host
+  RealTimeMarketProcessor(size_t minThreads = 4, size_t maxThreads = 16,
+                          std::filesystem::path journalDirectory = "trade_journal")
+      : threadPool_(minThreads, maxThreads),
+        journal_(journal::JournalOptions{.directory = std::move(journalDirectory)}) {
+    // Consumer graph: price-table -> {indicator, risk}; recorder runs independently
+    priceTableConsumer_ = tickRing_.addConsumer();
+    recorderConsumer_ = tickRing_.addConsumer();
+    indicatorConsumer_ = tickRing_.addConsumer({priceTableConsumer_});
+    riskConsumer_ = tickRing_.addConsumer({priceTableConsumer_});
+
+    bars_.subscribe([this](const BarCloseEvent& event) {
+      barsClosed_.fetch_add(1, std::memory_order_relaxed);
+      if (event.timeframeIndex == 0) {
+        updateCorrelations(event);
+      }
+    });
+
+    // One trace line per move analysis would drown the monitor output
+    threadPool_.setTaskTracing(false);
+
     // Start data processing pipeline
+    startTickConsumers();
     startDataProcessor();
     startSignalGenerator();
 
     std::cout << "Real-time market processor initialized" << std::endl;
   }
 
+  // Members are destroyed in reverse order, which would leave the pool (declared near the top) running its services
+  // and move analyses against a journal, gateway and risk table that are already gone. Stop everything that runs on
+  // other threads first: halting the ring ends the tick consumers, the data processor and the signal generator, and
+  // the pool shutdown then waits for them and for the analyses still queued.
+  ~RealTimeMarketProcessor() {
+    tickRing_.halt();
+    tickConsumers_.clear();
+    threadPool_.shutdown();
+  }
+
+  RealTimeMarketProcessor(const RealTimeMarketProcessor&) = delete;
+  RealTimeMarketProcessor& operator=(const RealTimeMarketProcessor&) = delete;
+
   void ingestMarketData(const MarketTick& tick) { dataQueue_.enqueue(MarketData{tick}); }
 
   void ingestSignal(const TradeSignal& signal) { dataQueue_.enqueue(MarketData{signal}); }
 
+  // Admin path: parses the file off the hot path and swaps it in; a bad file leaves the running config untouched
+  bool reloadConfig(const std::filesystem::path& path) {
+    try {
+      config_.publish(std::make_unique<MarketProcessorConfig>(MarketProcessorConfig::load(path)));
+    } catch (const std::exception& e) {
+      logSync(std::cerr, "Config reload failed: ", e.what(), "\n");
+      return false;
+    }
+    configReloads_.fetch_add(1, std::memory_order_relaxed);
+    const auto config = config_.copy();
+    logSync(std::cout, "Config reloaded from ", path.string(), " (threshold: ", config.priceChangeThreshold,
+            ", batch: ", config.batchSize, ", ema alpha: ", config.emaAlpha, ", max volume: ", config.maxTickVolume,
+            ")\n");
+    return true;
+  }
+
+  // Reloads whenever the file's modification time changes; also retries reclamation of retired configs
+  void watchConfig(std::filesystem::path path) {
+    configWatcher_ = std::jthread([this, path = std::move(path)](std::stop_token token) {
+      std::filesystem::file_time_type lastWrite{};
+      while (!token.stop_requested()) {
+        std::error_code error;
+        const auto writeTime = std::filesystem::last_write_time(path, error);
+        if (!error && writeTime != lastWrite) {
+          lastWrite = writeTime;
+          reloadConfig(path);
+        }
+        config_.reclaim();
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+      }
+    });
+  }
+
  private:
+  void startTickConsumers() {
+    // Config readers go quiescent at the end of each batch and on every empty poll, so an idle feed does not hold
+    // back reclamation of retired configs
+    tickConsumers_.emplace_back([this](std::stop_token token) {
+      auto config = config_.registerReader();
+      // A bar otherwise only closes when its own symbol ticks again; sweep for ended buckets at most once a second,
+      // both between batches and while the ring is idle, so quiet symbols still publish their bar closes
+      auto nextBarFlush = BarAggregator::Clock::now() + std::chrono::seconds(1);
+      const auto flushBars = [this, &nextBarFlush]() {
+        const auto now = BarAggregator::Clock::now();
+        if (now >= nextBarFlush) {
+          bars_.flush(now);
+          nextBarFlush = now + std::chrono::seconds(1);
+        }
+      };
+      tickRing_.run(
+          priceTableConsumer_, token,
+          [this, &config, &flushBars](const MarketTick& tick, int64_t, bool endOfBatch) {
+            processMarketTick(tick, *config);
+            if (endOfBatch) {
+              config.quiescent();
+              flushBars();
+            }
+          },
+          [&config, &flushBars]() {
+            config.quiescent();
+            flushBars();
+          });
+      // Bars are owned by this thread: publish the ones whose bucket has ended before the processor goes away
+      bars_.flush(BarAggregator::Clock::now());
+    });
+    tickConsumers_.emplace_back([this](std::stop_token token) {
+      auto config = config_.registerReader();
+      tickRing_.run(
+          indicatorConsumer_, token,
+          [this, &config](const MarketTick& tick, int64_t, bool endOfBatch) {
+            updateIndicators(tick, *config);
+            if (endOfBatch) {
+              config.quiescent();
+            }
+          },
+          [&config]() { config.quiescent(); });
+    });
+    tickConsumers_.emplace_back([this](std::stop_token token) {
+      // Batch the shared counter update instead of touching it per tick
+      tickRing_.run(recorderConsumer_, token,
+                    [this, pending = size_t{0}](const MarketTick&, int64_t, bool endOfBatch) mutable {
+                      ++pending;
+                      if (endOfBatch) {
+                        ticksRecorded_.fetch_add(pending, std::memory_order_relaxed);
+                        pending = 0;
+                      }
+                    });
+    });
+    tickConsumers_.emplace_back([this](std::stop_token token) {
+      auto config = config_.registerReader();
+      tickRing_.run(
+          riskConsumer_, token,
+          [this, &config](const MarketTick& tick, int64_t, bool endOfBatch) {
+            checkTickRisk(tick, *config);
+            if (endOfBatch) {
+              config.quiescent();
+            }
+          },
+          [&config]() { config.quiescent(); });
+    });
+  }
+
   void startDataProcessor() {
     // High-priority data ingestion processor
-    threadPool_.submit([this]() { processDataStream(); }, TaskPriority::CRITICAL, "data-processor");
+    threadPool_.submitService([this]() { processDataStream(); }, TaskPriority::CRITICAL, "data-processor");
   }
 
   void startSignalGenerator() {
     // Medium-priority signal generation
-    threadPool_.submit([this]() { generateTradingSignals(); }, TaskPriority::HIGH, "signal-generator");
+    threadPool_.submitService([this]() { generateTradingSignals(); }, TaskPriority::HIGH, "signal-generator");
   }
 
   void processDataStream() {
+    auto config = config_.registerReader();
     std::vector<MarketData> batch;
-    batch.reserve(BATCH_SIZE);
+    batch.reserve(config->batchSize);
+
+    // The tick consumers halt the ring when they stop; past that point a full ring would never drain
+    while (!tickRing_.halted()) {
+      config.quiescent();
+      const size_t batchSize = config->batchSize;
 
-    while (true) {
       // Collect batch of data
       MarketData data;
-      while (batch.size() < BATCH_SIZE && dataQueue_.dequeue(data)) {
+      while (batch.size() < batchSize && dataQueue_.dequeue(data)) {
         batch.push_back(std::move(data));
       }
 
@@ -160,7 +369,7 @@ class RealTimeMarketProcessor {
             using T = std::decay_t<decltype(item)>;
 
             if constexpr (std::is_same_v<T, MarketTick>) {
-              processMarketTick(item);
+              tickRing_.publish(item);  // dropped only once the ring is halted at shutdown
             } else if constexpr (std::is_same_v<T, TradeSignal>) {
               processTradeSignal(item);
             }
@@ -175,43 +384,121 @@ class RealTimeMarketProcessor {
     ticksProcessed_.fetch_add(batch.size());
   }
 
-  void processMarketTick(const MarketTick& tick) {
+  void processMarketTick(const MarketTick& tick, const MarketProcessorConfig& config) {
+    // Swap in the new tick and keep the old one in a single locked step, so no other update can slip in between
     std::optional<MarketTick> previousTick;
+    latestPrices_.upsert(
+        tick.symbol,
+        [&](MarketTick& latest) {
+          previousTick = latest;
+          latest = tick;
+        },
+        tick);
+
+    bars_.onTick(tick.symbol, tick.price, tick.volume, tick.timestamp);
+    correlations_.refreshStep();
+    movers_.onTick(tick.symbol, tick.price, tick.volume);
+
+    // Check for significant price movements
+    if (previousTick) {
+      double priceChange = std::abs(tick.price - previousTick->price) / previousTick->price;
 
-    {
-      std::shared_lock<std::shared_mutex> readLock(pricesMutex_);
-      auto it = latestPrices_.find(tick.symbol);
-      if (it != latestPrices_.end()) {
-        previousTick = it->second;
+      if (priceChange > config.priceChangeThreshold) {
+        // Analyse on the pool, due MOVE_ANALYSIS_BUDGET after the tick; it runs off the registered readers, so it
+        // gets a copy of the threshold. An analysis that starts past its deadline would only trade on a stale move,
+        // so it is shed instead of delaying the ones behind it. A non-HOLD verdict goes through the same signal path
+        // as the generator's.
+        const auto deadline = tick.timestamp + MOVE_ANALYSIS_BUDGET;
+        threadPool_.submitWithDeadline(
+            [this, tick, priceChange, deadline, threshold = config.priceChangeThreshold]() {
+              if (std::chrono::steady_clock::now() >= deadline) {
+                analysesShed_.fetch_add(1, std::memory_order_relaxed);
+                return;
+              }
+              const TradeSignal signal = analyzeSignificantMove(tick, priceChange, threshold);
+              if (signal.action != TradeSignal::HOLD) {
+                ingestSignal(signal);
+              }
+            },
+            TaskPriority::HIGH, deadline, "move-analysis");
       }
     }
+  }
 
-    // Update latest price (writer lock)
-    {
-      std::unique_lock<std::shared_mutex> writeLock(pricesMutex_);
-      latestPrices_[tick.symbol] = tick;
+  void updateIndicators(const MarketTick& tick, const MarketProcessorConfig& config) {
+    auto [it, inserted] = emaPrices_.try_emplace(tick.symbol, tick.price);
+    if (!inserted) {
+      it->second += config.emaAlpha * (tick.price - it->second);
     }
+  }
 
-    // Check for significant price movements
-    if (previousTick) {
-      double priceChange = std::abs(tick.price - previousTick->price) / previousTick->price;
+  // 1s bars of one bucket form one return sample; a bar from a newer bucket commits the previous sample. Full
+  // refreshes (warm-up, once per window, or a commit landing mid-pass) run one row band per tick in processMarketTick
+  // so a 256-symbol refresh never stalls this consumer for the whole O(S^2) pass.
+  void updateCorrelations(const BarCloseEvent& event) {
+    if (event.symbolId >= CORRELATION_SYMBOLS || event.bar.open <= 0.0) {
+      return;
+    }
+    if (correlationPending_ && event.bar.startNanos < correlationBucket_) {
+      return;  // late bar for a sample that was already committed
+    }
 
-      if (priceChange > PRICE_CHANGE_THRESHOLD) {
-        // Submit async analysis task
-        signalProcessor_.submitTask([this, tick, priceChange]() { return analyzeSignificantMove(tick, priceChange); });
+    if (correlationPending_ && event.bar.startNanos > correlationBucket_) {
+      correlations_.commitSample();
+      const size_t samples = correlationSamples_.fetch_add(1, std::memory_order_relaxed) + 1;
+      if (samples <= CORRELATION_WINDOW || samples % CORRELATION_WINDOW == 0 || correlations_.refreshing()) {
+        correlations_.startRefresh();
+      } else {
+        correlations_.refreshDirtyRows();
       }
+      correlationPending_ = false;
+    }
+
+    correlationBucket_ = event.bar.startNanos;
+    correlationPending_ = true;
+    correlations_.addReturn(event.symbolId, (event.bar.close - event.bar.open) / event.bar.open);
+  }
+
+  void checkTickRisk(const MarketTick& tick, const MarketProcessorConfig& config) {
+    const size_t riskId = risk_.symbolId(tick.symbol);
+    if (riskId != PositionRiskTable::kInvalidId) {
+      risk_.markPrice(riskId, tick.price);
+    }
+    if (tick.volume > config.maxTickVolume) {
+      riskAlerts_.fetch_add(1, std::memory_order_relaxed);
     }
   }
 
   void processTradeSignal(const TradeSignal& signal) {
-    // Process incoming trading signals
-    threadPool_.submit([this, signal]() { executeTradeSignal(signal); }, TaskPriority::HIGH,
-                       "execute-signal-" + signal.symbol);
+    // No order goes out without its journal record: a failed journal stops trading rather than this thread
+    try {
+      journal_.appendSignal(signal.symbol, static_cast<uint8_t>(signal.action), signal.confidence, signal.reason);
+    } catch (const std::exception& e) {
+      journalFailures_.fetch_add(1, std::memory_order_relaxed);
+      logSync(std::cerr, "Journal failed, dropping signal for ", signal.symbol, ": ", e.what(), "\n");
+      return;
+    }
+
+    // Pre-trade check reserves the position up front; HOLD signals carry no quantity
+    if (signal.action != TradeSignal::HOLD) {
+      const size_t riskId = risk_.symbolId(signal.symbol);
+      const int32_t quantity = signal.action == TradeSignal::BUY ? ORDER_QUANTITY : -ORDER_QUANTITY;
+      if (riskId == PositionRiskTable::kInvalidId ||
+          risk_.tryApply(riskId, quantity) != PositionRiskTable::Decision::Accepted) {
+        riskRejections_.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+    }
+
+    // Hand off to the execution gateway; completion is reported asynchronously
+    gateway_.submit(ExecutionOrder{0, signal.symbol, static_cast<uint8_t>(signal.action), signal.confidence,
+                                   signal.reason, {}},
+                    [this](const ExecutionReport& report) { onExecutionReport(report); });
 
     signalsGenerated_.fetch_add(1);
   }
 
-  TradeSignal analyzeSignificantMove(const MarketTick& tick, double priceChange) {
+  TradeSignal analyzeSignificantMove(const MarketTick& tick, double priceChange, double threshold) {
     // Simulate complex market analysis
     std::this_thread::sleep_for(std::chrono::milliseconds(50));
 
@@ -220,7 +507,7 @@ class RealTimeMarketProcessor {
     std::string reason = "Significant price movement detected";
 
     // Simple momentum-based strategy
-    if (priceChange > PRICE_CHANGE_THRESHOLD) {
+    if (priceChange > threshold) {
       action = TradeSignal::BUY;
       confidence = std::min(0.95, priceChange * 10);
       reason = "Strong upward momentum";
@@ -229,28 +516,35 @@ class RealTimeMarketProcessor {
     return TradeSignal{tick.symbol, action, confidence, reason};
   }
 
-  void executeTradeSignal(const TradeSignal& signal) {
-    // Simulate trade execution latency
-    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  // Runs on the gateway thread: keep it short. The fill has happened either way, so a failed journal only costs its
+  // record, which is logged and counted.
+  void onExecutionReport(const ExecutionReport& report) {
+    try {
+      journal_.appendExecution(report.symbol, report.action, report.confidence, report.reason);
+    } catch (const std::exception& e) {
+      journalFailures_.fetch_add(1, std::memory_order_relaxed);
+      logSync(std::cerr, "Journal failed, fill for ", report.symbol, " (order ", report.orderId,
+              ") is not recorded: ", e.what(), "\n");
+    }
 
-    std::cout << "TRADE EXECUTED: " << signal.symbol << " " << (signal.action == TradeSignal::BUY ? "BUY" : "SELL")
-              << " (confidence: " << signal.confidence << ")" << std::endl;
+    const auto action = static_cast<TradeSignal::Action>(report.action);
+    logSync(std::cout, "TRADE EXECUTED: ", report.symbol, " ", (action == TradeSignal::BUY ? "BUY" : "SELL"),
+            " (confidence: ", report.confidence, ", batch: ", report.batchSize, ", latency: ", report.latency.count(),
+            " us)\n");
   }
 
   void generateTradingSignals() {
-    while (true) {
+    while (!tickRing_.halted()) {
       // Periodic signal generation based on market conditions
       std::this_thread::sleep_for(std::chrono::seconds(1));
 
-      std::shared_lock<std::shared_mutex> readLock(pricesMutex_);
-
-      for (const auto& [symbol, tick] : latestPrices_) {
+      latestPrices_.forEach([this](std::string_view, const MarketTick& tick) {
         // Simple pattern-based signal generation
         if (shouldGenerateSignal(tick)) {
           auto signal = generatePatternSignal(tick);
           ingestSignal(signal);
         }
-      }
+      });
     }
   }
 
@@ -279,15 +573,31 @@ class RealTimeMarketProcessor {
     size_t signalsGenerated;
     double averageLatency;
     size_t queueSize;
-    DynamicThreadPool::PoolStats threadPoolStats;
+    ProcessorPool::PoolStats threadPoolStats;
     size_t symbolsTracked;
+    size_t ticksRecorded;
+    size_t riskAlerts;
+    size_t tickRingBacklog;
+    size_t barsClosed;
+    size_t correlationSamples;
+    journal::TradeJournal::Stats journalStats;
+    ExecutionGateway::Stats gatewayStats;
+    size_t riskRejections;
+    uint64_t riskCasRetries;
+    size_t configReloads;
+    size_t configsPendingReclaim;
+    size_t analysesShed;
+    size_t journalFailures;
   };
 
   SystemMetrics getMetrics() const {
-    std::shared_lock<std::shared_mutex> readLock(pricesMutex_);
-
     return SystemMetrics{ticksProcessed_.load(), signalsGenerated_.load(), averageProcessingLatency_.load(),
-                         dataQueue_.size(),      threadPool_.getStats(),   latestPrices_.size()};
+                         dataQueue_.size(),      threadPool_.getStats(),   latestPrices_.size(),
+                         ticksRecorded_.load(),  riskAlerts_.load(),       tickRing_.backlog(),
+                         barsClosed_.load(),     correlationSamples_.load(), journal_.getStats(),
+                         gateway_.getStats(),    riskRejections_.load(),   risk_.casRetries(),
+                         configReloads_.load(),  config_.pendingReclaim(), analysesShed_.load(),
+                         journalFailures_.load()};
   }
 
   void printMetrics() const {
@@ -299,48 +609,147 @@ class RealTimeMarketProcessor {
     std::cout << "Average latency: " << metrics.averageLatency << " μs" << std::endl;
     std::cout << "Queue size: " << metrics.queueSize << std::endl;
     std::cout << "Symbols tracked: " << metrics.symbolsTracked << std::endl;
-
+    std::cout << "Ticks recorded: " << metrics.ticksRecorded << " | \t Risk alerts: " << metrics.riskAlerts
+              << " | \t Tick ring backlog: " << metrics.tickRingBacklog << std::endl;
+    std::cout << "Bars closed: " << metrics.barsClosed << " | \t Correlation samples: " << metrics.correlationSamples
+              << std::endl;
+    std::cout << "Journal records: " << metrics.journalStats.records << " | \t commits: "
+              << metrics.journalStats.commits << " | \t durable seq: " << metrics.journalStats.durableSequence
+              << " | \t failures: " << metrics.journalFailures << std::endl;
+    std::cout << "Orders submitted: " << metrics.gatewayStats.submitted
+              << " | \t completed: " << metrics.gatewayStats.completed
+              << " | \t avg batch: " << metrics.gatewayStats.averageBatchSize
+              << " | \t avg latency: " << metrics.gatewayStats.averageLatencyMicros << " μs" << std::endl;
+    std::cout << "Risk rejections: " << metrics.riskRejections << " | \t risk CAS retries: " << metrics.riskCasRetries
+              << std::endl;
+    std::cout << "Move analyses shed past their deadline: " << metrics.analysesShed << std::endl;
+    std::cout << "Config reloads: " << metrics.configReloads
+              << " | \t retired configs awaiting reclaim: " << metrics.configsPendingReclaim << std::endl;
+    if constexpr (contention::kEnabled) {
+      std::cout << "Contention counters (process-wide):" << std::endl;
+      contention::snapshot().print(std::cout);
+    }
+    printTopMovers();
     threadPool_.printStats();
   }
+
+  void printTopMovers() const {
+    using Ranking = decltype(movers_)::Ranking;
+
+    std::cout << "Top movers (% change):";
+    for (const auto& entry : movers_.top(Ranking::PercentChange)) {
+      std::cout << " " << entry.name() << " " << std::showpos << entry.percentChange << std::noshowpos << "%";
+    }
+    std::cout << std::endl;
+
+    std::cout << "Top movers (volume):";
+    for (const auto& entry : movers_.top(Ranking::Volume)) {
+      std::cout << " " << entry.name() << " " << entry.volume;
+    }
+    std::cout << std::endl;
+  }
 };
 
-int main() {
-  RealTimeMarketProcessor processor(6, 20);
+namespace {
 
-  // Market data simulation
-  std::vector<std::string> symbols = {"AAPL", "GOOGL", "MSFT", "TSLA", "AMZN"};
+const std::vector<std::string> SIMULATED_SYMBOLS = {"AAPL", "GOOGL", "MSFT", "TSLA", "AMZN"};
+const std::string TICK_RING_PREFIX = "/market-ticks";
+
+// Generates 10'000 ticks at a variable rate and hands each one to `emit`
+template <typename Emit>
+void generateMarketData(Emit&& emit) {
   std::random_device rd;
   std::mt19937 gen(rd());
+  std::uniform_real_distribution<> priceDist(100.0, 200.0);
+  std::uniform_int_distribution<> volumeDist(100, 10000);
+  std::uniform_int_distribution<> symbolDist(0, SIMULATED_SYMBOLS.size() - 1);
 
-  // Generate market data
-  std::thread dataGenerator([&]() {
-    std::uniform_real_distribution<> priceDist(100.0, 200.0);
-    std::uniform_int_distribution<> volumeDist(100, 10000);
-    std::uniform_int_distribution<> symbolDist(0, symbols.size() - 1);
+  for (int i = 0; i < 10000; ++i) {
+    const std::string& symbol = SIMULATED_SYMBOLS[symbolDist(gen)];
+    emit(symbol, priceDist(gen), volumeDist(gen));
 
-    for (int i = 0; i < 10000; ++i) {
-      std::string symbol = symbols[symbolDist(gen)];
-      double price = priceDist(gen);
-      int volume = volumeDist(gen);
+    // Variable rate data generation
+    std::this_thread::sleep_for(std::chrono::microseconds(100 + (i % 1000)));
+  }
+}
 
-      processor.ingestMarketData(MarketTick(symbol, price, volume));
+void monitorProcessor(const RealTimeMarketProcessor& processor) {
+  for (int i = 0; i < 30; ++i) {
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+    processor.printMetrics();
+  }
+}
 
-      // Variable rate data generation
-      std::this_thread::sleep_for(std::chrono::microseconds(100 + (i % 1000)));
-    }
+// Feed process: routes every tick to the shared-memory ring of the processor that owns its symbol range
+int runFeed(size_t partitions) {
+  shm::ShmFeedPublisher publisher(TICK_RING_PREFIX, shm::SymbolRangeRouter::alphabetical(partitions));
+  std::cout << "Feed publishing to " << partitions << " partition(s) under " << TICK_RING_PREFIX << std::endl;
+
+  generateMarketData([&](const std::string& symbol, double price, int volume) {
+    publisher.publish(symbol, price, volume);
   });
+  publisher.close();
 
-  // Performance monitoring
-  std::thread monitor([&processor]() {
-    for (int i = 0; i < 30; ++i) {
-      std::this_thread::sleep_for(std::chrono::seconds(2));
-      processor.printMetrics();
-    }
+  std::cout << "Feed completed" << std::endl;
+  return 0;
+}
+
+// Processor process: owns one symbol range and reads its ticks from shared memory
+int runWorker(size_t partition) {
+  RealTimeMarketProcessor processor(6, 20, "trade_journal-" + std::to_string(partition));
+  if (const char* configPath = std::getenv("MARKET_PROCESSOR_CONFIG")) {
+    processor.watchConfig(configPath);
+  }
+  auto ring = shm::ShmTickRing::open(shm::ringName(TICK_RING_PREFIX, partition), std::chrono::seconds(30));
+
+  std::thread monitor([&processor]() { monitorProcessor(processor); });
+
+  while (ring.waitAndDrain([&](const shm::TickMessage& message) {
+    MarketTick tick(std::string(message.symbolView()), message.price, message.volume);
+    tick.timestamp = std::chrono::steady_clock::time_point(std::chrono::nanoseconds(message.timestampNanos));
+    processor.ingestMarketData(tick);
+  }) != 0) {
+  }
+
+  monitor.join();
+  std::cout << "Partition " << partition << " processing completed" << std::endl;
+  return 0;
+}
+
+}  // namespace
+
+// Usage:
+//   M2s43                    single process: in-process feed + processor
+//   M2s43 feed <partitions>  feed process writing to /dev/shm/market-ticks-<n>
+//   M2s43 worker <partition> processor process for one symbol range (start one per partition)
+// Set MARKET_PROCESSOR_CONFIG=<file> to hot-reload tunables (`key = value`, see MarketProcessorConfig.h).
+int main(int argc, char* argv[]) {
+  const std::string mode = argc > 1 ? argv[1] : "";
+  if (mode == "feed") {
+    return runFeed(argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 2);
+  }
+  if (mode == "worker") {
+    return runWorker(argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 0);
+  }
+
+  RealTimeMarketProcessor processor(6, 20);
+  if (const char* configPath = std::getenv("MARKET_PROCESSOR_CONFIG")) {
+    processor.watchConfig(configPath);
+  }
+
+  // Market data simulation
+  std::thread dataGenerator([&]() {
+    generateMarketData([&](const std::string& symbol, double price, int volume) {
+      processor.ingestMarketData(MarketTick(symbol, price, volume));
+    });
   });
 
+  // Performance monitoring
+  std::thread monitor([&processor]() { monitorProcessor(processor); });
+
   dataGenerator.join();
   monitor.join();
 
   std::cout << "Market processing simulation completed" << std::endl;
   return 0;
-}
\ No newline at end of file
+}
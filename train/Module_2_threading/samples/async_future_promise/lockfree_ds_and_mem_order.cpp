@@ -16,79 +16,81 @@ Experiment with different memory ordering constraints and their impact on correc
 
 */
 #include <atomic>
+#include <chrono>
 #include <iostream>
 #include <memory>
 #include <ostream>
+#include <string>
 #include <thread>
 #include <type_traits>
 #include <vector>
 
 /* LockFreeQueue moved to LockFreeQueue.h */
+#include "ContentionCounters.h"
 #include "LockFreeQueue.h"
+#include "LockFreeStack.h"
+#include "MicroBenchmark.h"
 
 // Lock-free stack for comparison
-template <typename T>
-class LockFreeStack {
- private:
-  struct Node {
-    T data;
-    Node* next;
-
-    Node(T item) : data(std::move(item)), next(nullptr) {}
-  };
-
-  std::atomic<Node*> head_{nullptr};
-  std::atomic<size_t> size_{0};
+using lockfree::LockFreeStack;
 
+// Performance benchmarking utility
+class LockFreeBenchmark {
  public:
-  void push(T item) {
-    Node* newNode = new Node(std::move(item));
-    newNode->next = head_.load(std::memory_order_relaxed);
-
-    while (!head_.compare_exchange_weak(newNode->next, newNode, std::memory_order_release, std::memory_order_relaxed)) {
-      // Loop until successful
+  // One fresh container per sample; reports the median run with its 95% confidence interval
+  template <typename Container>
+  static microbench::Summary benchmarkContainer(const std::string& containerName, int operations, int producerThreads,
+                                                int consumerThreads) {
+    const auto countersBefore = contention::snapshot();
+    const auto summary = microbench::measureTimed(containerName, [&] {
+      return runOnce<Container>(operations, producerThreads, consumerThreads);
+    });
+    const auto counters = contention::snapshot() - countersBefore;
+
+    const double medianMs = summary.medianMillis();
+    std::cout << containerName << " Benchmark Results:" << std::endl;
+    std::cout << "  Operations: " << operations << std::endl;
+    std::cout << "  Producer threads: " << producerThreads << std::endl;
+    std::cout << "  Consumer threads: " << consumerThreads << std::endl;
+    std::cout << "  Duration (median): " << medianMs << " ms" << std::endl;
+    std::cout << "  95% CI: [" << summary.ciLowNanos / 1e6 << ", " << summary.ciHighNanos / 1e6 << "] ms over "
+              << summary.samples << " runs (" << summary.outliers << " outliers)" << std::endl;
+    std::cout << "  Throughput: " << (operations * 1000.0 / medianMs) << " ops/sec" << std::endl;
+    if constexpr (contention::kEnabled) {
+      std::cout << "  Contention counters (all runs):" << std::endl;
+      counters.print(std::cout, "    ");
     }
-
-    size_.fetch_add(1, std::memory_order_relaxed);
+    std::cout << std::endl;
+    return summary;
   }
 
-  bool pop(T& result) {
-    Node* head = head_.load(std::memory_order_acquire);
-
-    while (head &&
-           !head_.compare_exchange_weak(head, head->next, std::memory_order_release, std::memory_order_relaxed)) {
-      // Retry with updated head
+ private:
+  // LockFreeQueue speaks enqueue/dequeue, the stacks push/tryPop
+  template <typename Container, typename T>
+  static void put(Container& container, T item) {
+    if constexpr (requires { container.enqueue(std::move(item)); }) {
+      container.enqueue(std::move(item));
+    } else {
+      container.push(std::move(item));
     }
+  }
 
-    if (!head) {
-      return false;
+  template <typename Container, typename T>
+  static bool take(Container& container, T& item) {
+    if constexpr (requires { container.dequeue(item); }) {
+      return container.dequeue(item);
+    } else {
+      return container.tryPop(item);
     }
-
-    result = std::move(head->data);
-    size_.fetch_sub(1, std::memory_order_relaxed);
-
-    // In production, use proper memory reclamation
-    delete head;
-    return true;
   }
 
-  bool empty() const { return head_.load(std::memory_order_acquire) == nullptr; }
-
-  size_t size() const { return size_.load(std::memory_order_acquire); }
-};
-
-// Performance benchmarking utility
-class LockFreeBenchmark {
- public:
   template <typename Container>
-  static void benchmarkContainer(const std::string& containerName, int operations, int producerThreads,
-                                 int consumerThreads) {
+  static std::chrono::nanoseconds runOnce(int operations, int producerThreads, int consumerThreads) {
     Container container;
     std::atomic<bool> start{false};
-    std::atomic<int> itemsProduced{0};
     std::atomic<int> itemsConsumed{0};
-
-    auto startTime = std::chrono::high_resolution_clock::now();
+    const int itemsPerProducer = operations / producerThreads;
+    const int expected = itemsPerProducer * producerThreads;
 
     // Producer threads
     std::vector<std::thread> producers;
@@ -97,10 +99,8 @@ class LockFreeBenchmark {
         while (!start.load()) { /* spin wait */
         }
 
-        int itemsPerProducer = operations / producerThreads;
         for (int j = 0; j < itemsPerProducer; ++j) {
-          container.push(i * 1000 + j);
-          itemsProduced.fetch_add(1);
+          put(container, i * 1000 + j);
         }
       });
     }
@@ -113,8 +113,9 @@ class LockFreeBenchmark {
         }
 
         int item;
-        while (itemsConsumed.load() < operations) {
-          if (container.pop(item)) {
+        while (itemsConsumed.load() < expected) {
+          if (take(container, item)) {
+            microbench::DoNotOptimize(item);
             itemsConsumed.fetch_add(1);
           } else {
             std::this_thread::yield();
@@ -123,26 +124,21 @@ class LockFreeBenchmark {
       });
     }
 
-    // Start benchmark
+    // Start benchmark once every thread exists, so spawning is not timed
+    const auto startTime = microbench::Clock::now();
     start.store(true);
 
     // Wait for completion
     for (auto& t : producers) t.join();
     for (auto& t : consumers) t.join();
 
-    auto endTime = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
-
-    std::cout << containerName << " Benchmark Results:" << std::endl;
-    std::cout << "  Operations: " << operations << std::endl;
-    std::cout << "  Producer threads: " << producerThreads << std::endl;
-    std::cout << "  Consumer threads: " << consumerThreads << std::endl;
-    std::cout << "  Duration: " << duration.count() << " ms" << std::endl;
-    std::cout << "  Items produced: " << itemsProduced.load() << std::endl;
-    std::cout << "  Items consumed: " << itemsConsumed.load() << std::endl;
-    std::cout << "  Throughput: " << (operations * 1000.0 / duration.count()) << " ops/sec" << std::endl;
-    std::cout << std::endl;
+    return microbench::Clock::now() - startTime;
   }
 };
 
-int main() { return 0; }
\ No newline at end of file
+int main() {
+  constexpr int kOperations = 100000;
+  LockFreeBenchmark::benchmarkContainer<LockFreeQueue<int>>("LockFreeQueue", kOperations, 2, 2);
+  LockFreeBenchmark::benchmarkContainer<LockFreeStack<int>>("LockFreeStack", kOperations, 2, 2);
+  return 0;
+}
@@ -0,0 +1,162 @@
+/*
+Contention benchmark for PositionRiskTable pre-trade checks.
+
+🔍 Practice
+* Hammer a few hot symbols from many threads and compare the packed-word CAS table with a mutex-guarded map
+* Watch CAS retries per operation grow as threads pile onto the same cache line
+* Spread the same load over many symbols and see the retries disappear
+
+✅ Success Checklist
+* The CAS table scales where the mutex baseline flattens or drops
+* Final positions match the sum of accepted quantities (no lost updates)
+*/
+#include <algorithm>
+#include <barrier>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "PositionRiskTable.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int kOpsPerThread = 500'000;
+constexpr double kPrice = 100.0;
+
+// Per-thread tallies, one cache line each so the bookkeeping does not add false sharing of its own
+struct alignas(64) AcceptedNet {
+  std::int64_t quantity{0};
+};
+
+// Baseline: the shape of the original design, one lock around a symbol -> position map
+class MutexRiskTable {
+  struct Entry {
+    std::int64_t position{0};
+    double price{kPrice};
+  };
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+  PositionRiskTable::Limits limits_;
+
+ public:
+  bool tryApply(const std::string& symbol, std::int32_t quantity) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry& entry = entries_[symbol];
+    const std::int64_t next = entry.position + quantity;
+    if (std::llabs(next) > std::llabs(entry.position) &&
+        (std::llabs(next) > limits_.maxPosition ||
+         static_cast<double>(std::llabs(next)) * entry.price > limits_.maxNotional)) {
+      return false;
+    }
+    entry.position = next;
+    return true;
+  }
+};
+
+std::vector<std::string> makeSymbols(int count) {
+  std::vector<std::string> symbols;
+  for (int idx = 0; idx < count; ++idx) {
+    symbols.push_back("SYM" + std::to_string(idx));
+  }
+  return symbols;
+}
+
+template <typename Op>
+double runThreads(int threads, Op op) {
+  std::barrier startGate(threads + 1);
+  std::vector<std::jthread> workers;
+  for (int idx = 0; idx < threads; ++idx) {
+    workers.emplace_back([&, idx]() {
+      std::mt19937 rng(static_cast<unsigned>(idx) * 7919u + 1);
+      startGate.arrive_and_wait();
+      op(idx, rng);
+    });
+  }
+  startGate.arrive_and_wait();
+  const auto start = Clock::now();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+void runScenario(int threads, int hotSymbols) {
+  const auto symbols = makeSymbols(hotSymbols);
+  const double totalOps = static_cast<double>(threads) * kOpsPerThread;
+
+  // Both tables are handed the symbol string on every update, as the processor does for each signal; the CAS
+  // path pays for its symbol lookup just as the mutex path pays for its map lookup
+  PositionRiskTable table(static_cast<std::size_t>(hotSymbols));
+  std::vector<std::size_t> ids;
+  for (const auto& symbol : symbols) {
+    ids.push_back(table.symbolId(symbol));
+    table.markPrice(ids.back(), kPrice);
+  }
+  std::vector<AcceptedNet> acceptedNet(static_cast<std::size_t>(threads) * hotSymbols);
+
+  const double casSeconds = runThreads(threads, [&](int idx, std::mt19937& rng) {
+    std::uniform_int_distribution<int> pick(0, hotSymbols - 1);
+    for (int op = 0; op < kOpsPerThread; ++op) {
+      const int symbol = pick(rng);
+      const std::int32_t quantity = (rng() & 1) ? 100 : -100;
+      if (table.tryApply(table.symbolId(symbols[symbol]), quantity) == PositionRiskTable::Decision::Accepted) {
+        acceptedNet[idx * hotSymbols + symbol].quantity += quantity;
+      }
+    }
+  });
+
+  bool consistent = true;
+  for (int symbol = 0; symbol < hotSymbols; ++symbol) {
+    std::int64_t expected = 0;
+    for (int idx = 0; idx < threads; ++idx) {
+      expected += acceptedNet[idx * hotSymbols + symbol].quantity;
+    }
+    consistent = consistent && table.exposure(ids[symbol]).position == expected;
+  }
+
+  MutexRiskTable locked;
+  const double mutexSeconds = runThreads(threads, [&](int, std::mt19937& rng) {
+    std::uniform_int_distribution<int> pick(0, hotSymbols - 1);
+    for (int op = 0; op < kOpsPerThread; ++op) {
+      locked.tryApply(symbols[pick(rng)], (rng() & 1) ? 100 : -100);
+    }
+  });
+
+  std::cout << std::left << std::setw(8) << threads << std::setw(10) << hotSymbols << std::fixed
+            << std::setprecision(2) << std::setw(14) << totalOps / casSeconds / 1e6 << std::setw(14)
+            << totalOps / mutexSeconds / 1e6 << std::setprecision(1) << std::setw(10) << mutexSeconds / casSeconds
+            << std::setprecision(4) << std::setw(16) << static_cast<double>(table.casRetries()) / totalOps
+            << std::setw(8) << (consistent ? "ok" : "LOST") << std::endl;
+}
+
+}  // namespace
+
+int main() {
+  std::cout << "=== PositionRiskTable contention ===" << std::endl;
+  std::cout << std::left << std::setw(8) << "Thr" << std::setw(10) << "Symbols" << std::setw(14) << "CAS Mops/s"
+            << std::setw(14) << "Mutex Mops/s" << std::setw(10) << "Speedup" << std::setw(16) << "retries/op"
+            << std::setw(8) << "check" << std::endl;
+  std::cout << std::string(80, '-') << std::endl;
+
+  const int maxThreads = static_cast<int>(std::max(2u, std::thread::hardware_concurrency()));
+  for (const int threads : {1, 2, 4, 8}) {
+    if (threads > maxThreads * 2) {
+      break;
+    }
+    for (const int hotSymbols : {1, 4, 1024}) {
+      runScenario(threads, hotSymbols);
+    }
+  }
+
+  return 0;
+}
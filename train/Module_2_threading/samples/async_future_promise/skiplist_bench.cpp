@@ -0,0 +1,209 @@
+/*
+Ordered map benchmark: lock-free skip list vs std::map behind a shared_mutex (ThreadSafeMap).
+
+🔍 Practice
+* Sweep read/write ratios from 99/1 to 50/50 at 1-8 threads and find where the single writer lock starts to hurt
+* Compare point lookups with short range scans (both copy the range): the skip list scans without blocking writers
+* Watch the 1-thread column: the skip list pays for its pointer chasing and epoch pins when nobody contends
+
+✅ Success Checklist
+* Both maps agree on the final contents of a deterministic single-threaded run
+* Know what the numbers say before picking a map: on a single-core host the skip list was slower than ThreadSafeMap
+  in 17 of the 20 point-lookup rows (0.63-0.92x, e.g. 0.69-0.86x at 50/50) and level within noise in the other
+  three; it was ahead only on the 32-key range scans (1.05-1.33x). Check whether that changes once writers really
+  run in parallel on your machine.
+*/
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "LockFreeSkipList.h"
+#include "MicroBenchmark.h"
+#include "ThreadSafeMap.h"
+
+namespace {
+
+constexpr int kKeySpace = 4096;
+constexpr int kOpsPerThread = 50'000;
+constexpr int kScanLength = 32;
+
+const microbench::Options kOptions{
+    .warmupRuns = 1, .minSamples = 5, .maxSamples = 20, .timeBudget = std::chrono::milliseconds(300)};
+
+struct Workload {
+  std::string_view label;
+  double readShare;
+  bool rangeScans;  // reads scan kScanLength keys instead of looking up one
+};
+
+constexpr Workload kWorkloads[] = {
+    {"read 99/1", 0.99, false}, {"read 95/5", 0.95, false},  {"read 90/10", 0.90, false},
+    {"read 80/20", 0.80, false}, {"read 50/50", 0.50, false}, {"scan 90/10", 0.90, true},
+};
+
+// Zero-padded so that string order is numeric order and range scans cover kScanLength keys
+const std::vector<std::string>& keys() {
+  static const std::vector<std::string> all = [] {
+    std::vector<std::string> names;
+    char buffer[16];
+    for (int idx = 0; idx < kKeySpace; ++idx) {
+      std::snprintf(buffer, sizeof(buffer), "stock%05d", idx);
+      names.emplace_back(buffer);
+    }
+    return names;
+  }();
+  return all;
+}
+
+// Adapters: the two maps spell the same operations differently
+struct LockedMap {
+  ThreadSafeMap<double> map;
+
+  void insert(const std::string& key, double value) { map.insert(key, value); }
+  void erase(const std::string& key) { map.erase(key); }
+  double find(const std::string& key) const {
+    double value = 0.0;
+    return map.find(key, value) ? value : -1.0;
+  }
+  std::size_t scan(const std::string& from, const std::string& to) const { return map.getRange(from, to).size(); }
+  std::size_t size() const { return map.size(); }
+};
+
+struct SkipListMap {
+  lockfree::LockFreeSkipListMap<std::string, double> map;
+
+  void insert(const std::string& key, double value) { map.insert(key, value); }
+  void erase(const std::string& key) { map.erase(key); }
+  double find(const std::string& key) const { return map.find(key).value_or(-1.0); }
+  std::size_t scan(const std::string& from, const std::string& to) const { return map.range(from, to).size(); }
+  std::size_t size() const { return map.size(); }
+};
+
+// Half the keys present up front; writes insert or erase a random key with equal odds, so the fill stays near half
+template <typename Map>
+std::chrono::nanoseconds runMix(int threads, const Workload& workload) {
+  const auto& names = keys();
+  Map map;
+  for (int idx = 0; idx < kKeySpace; idx += 2) {
+    map.insert(names[idx], 100.0 + idx);
+  }
+
+  std::atomic<bool> go{false};
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      std::mt19937 rng(static_cast<unsigned>(t * 7919 + 17));
+      std::uniform_int_distribution<int> pickKey(0, kKeySpace - 1);
+      std::bernoulli_distribution isRead(workload.readShare);
+      while (!go.load(std::memory_order_acquire)) {
+      }
+      for (int op = 0; op < kOpsPerThread; ++op) {
+        const int key = pickKey(rng);
+        if (isRead(rng)) {
+          if (workload.rangeScans) {
+            const int last = std::min(key + kScanLength, kKeySpace - 1);
+            microbench::DoNotOptimize(map.scan(names[key], names[last]));
+          } else {
+            microbench::DoNotOptimize(map.find(names[key]));
+          }
+        } else if ((op & 1) == 0) {
+          map.insert(names[key], static_cast<double>(op));
+        } else {
+          map.erase(names[key]);
+        }
+      }
+    });
+  }
+  const auto start = microbench::Clock::now();
+  go.store(true, std::memory_order_release);
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  return microbench::Clock::now() - start;
+}
+
+// Same deterministic single-threaded sequence on both maps; the contents must match
+bool mapsAgree() {
+  const auto& names = keys();
+  ThreadSafeMap<double> locked;
+  lockfree::LockFreeSkipListMap<std::string, double> skipList;
+  std::mt19937 rng(42);
+  for (int op = 0; op < 100'000; ++op) {
+    const auto& key = names[rng() % kKeySpace];
+    if (op % 3 == 0) {
+      locked.erase(key);
+      skipList.erase(key);
+    } else if (double value = 0.0; !locked.find(key, value)) {
+      locked.insert(key, op);
+      skipList.insert(key, static_cast<double>(op));
+    }
+  }
+  return locked.getAllEntries() == skipList.entries();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  const auto format = microbench::formatFromArgs(argc, argv);
+  if (!mapsAgree()) {
+    std::cerr << "ThreadSafeMap and LockFreeSkipListMap disagree" << std::endl;
+    return 1;
+  }
+
+  struct Row {
+    std::string_view workload;
+    int threads;
+    microbench::Summary locked;
+    microbench::Summary skipList;
+  };
+  std::vector<Row> rows;
+  for (const auto& workload : kWorkloads) {
+    for (const int threads : {1, 2, 4, 8}) {
+      const std::string suffix = "/" + std::string(workload.label) + "/" + std::to_string(threads) + "thr";
+      auto locked = microbench::measureTimed(
+          "shared_mutex-map" + suffix, [&] { return runMix<LockedMap>(threads, workload); }, kOptions);
+      auto skipList = microbench::measureTimed(
+          "skip-list" + suffix, [&] { return runMix<SkipListMap>(threads, workload); }, kOptions);
+      rows.push_back(Row{workload.label, threads, std::move(locked), std::move(skipList)});
+    }
+  }
+
+  if (format != microbench::Format::Table) {
+    std::vector<microbench::Summary> summaries;
+    for (const auto& row : rows) {
+      summaries.push_back(row.locked);
+      summaries.push_back(row.skipList);
+    }
+    microbench::write(std::cout, summaries, format);
+    return 0;
+  }
+
+  std::cout << "=== Ordered map: ThreadSafeMap vs LockFreeSkipListMap (" << kOpsPerThread << " ops per thread, "
+            << kKeySpace << " keys) ===" << std::endl;
+  std::cout << std::left << std::setw(14) << "Workload" << std::setw(6) << "Thr" << std::setw(20)
+            << "shared_mutex ns/op" << std::setw(18) << "skip-list ns/op" << std::setw(10) << "Speedup"
+            << std::setw(8) << "+-%" << std::endl;
+  std::cout << std::string(76, '-') << std::endl;
+  std::cout << std::fixed;
+  for (const auto& row : rows) {
+    const double ops = static_cast<double>(kOpsPerThread) * row.threads;
+    const auto comparison = microbench::compare(row.locked, row.skipList);
+    std::cout << std::left << std::setw(14) << row.workload << std::setw(6) << row.threads << std::setprecision(1)
+              << std::setw(20) << row.locked.medianNanos / ops << std::setw(18) << row.skipList.medianNanos / ops
+              << std::setprecision(3) << std::setw(10)
+              << (std::to_string(comparison.speedup).substr(0, 5) + (comparison.significant ? "*" : ""))
+              << std::setprecision(1) << std::setw(8) << row.skipList.relativeError() * 100.0 << std::endl;
+  }
+  std::cout << "\nSpeedup = shared_mutex time / skip-list time (* = 95% CIs do not overlap); +-% is the skip list's"
+            << "\nrelative CI half-width. Scans read " << kScanLength << " consecutive keys per read operation."
+            << std::endl;
+  return 0;
+}
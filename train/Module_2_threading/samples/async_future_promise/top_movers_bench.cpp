@@ -0,0 +1,322 @@
+/*
+Per-tick cost of TopMoversBoard as the number of tracked symbols grows.
+
+🔍 Practice
+* Feed a random walk (|% change| rises and falls on every tick) over 256 to 65536 symbols into the board and into a
+copy of its earlier design, which rescanned the whole shard whenever a ranked symbol's score dropped
+* With uniform flow a ranked symbol rarely ticks, so rescans are rare and the baseline's cheaper fixed cost wins
+* With hot-movers flow the ranked symbols are the busy ones: watch the baseline grow with symbols per shard while the
+heap-indexed board only grows with log(symbols)
+* Compare the board's top K with a brute-force ranking of the same ticks
+
+✅ Success Checklist
+* Per-tick cost of the board stays within a small factor across flows and symbol counts
+* Both rankings agree with the brute-force top K
+*/
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "MicroBenchmark.h"
+#include "TopMoversBoard.h"
+
+namespace {
+
+constexpr std::size_t kTop = 10;
+constexpr std::size_t kShards = 16;
+constexpr std::size_t kTicks = 1 << 16;
+
+const microbench::Options kOptions{
+    .warmupRuns = 2, .minSamples = 10, .maxSamples = 100, .timeBudget = std::chrono::milliseconds(300)};
+
+using Board = TopMoversBoard<kTop, kShards>;
+using Ranking = Board::Ranking;
+
+struct Tick {
+  const std::string* symbol;
+  double price;
+  std::int64_t volume;
+};
+
+// Baseline: the earlier per-shard design, a sorted top-K kept next to the symbol map and rebuilt by scanning the
+// shard whenever a ranked symbol falls. Like the board it locks the shard and, as the earlier design did, stores the
+// shard's whole top-K into relaxed atomic words on every tick.
+class RescanBoard {
+  struct State {
+    double open{0.0};
+    double percentChange{0.0};
+    std::int64_t volume{0};
+  };
+  struct Ranked {
+    const std::string* symbol;
+    const State* state;
+    double score;
+  };
+  struct Shard {
+    std::mutex mutex;
+    std::unordered_map<std::string, State> symbols;
+    std::array<std::vector<Ranked>, Board::kRankings> top;
+    std::atomic<std::uint64_t> sequence{0};
+    std::array<std::atomic<std::uint64_t>, Board::kRankings * kTop * 5> published{};
+  };
+
+  std::array<Shard, kShards> shards_;
+
+  static double score(const State& state, std::size_t r) {
+    return r == 0 ? std::abs(state.percentChange) : static_cast<double>(state.volume);
+  }
+
+  static void insertSorted(std::vector<Ranked>& top, const Ranked& entry) {
+    if (top.size() == kTop && entry.score <= top.back().score) {
+      return;
+    }
+    if (top.size() == kTop) {
+      top.pop_back();
+    }
+    top.insert(std::upper_bound(top.begin(), top.end(), entry,
+                                [](const Ranked& a, const Ranked& b) { return a.score > b.score; }),
+               entry);
+  }
+
+ public:
+  void onTick(const std::string& symbol, double price, std::int64_t volume) {
+    Shard& shard = shards_[std::hash<std::string>{}(symbol) % kShards];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto [it, inserted] = shard.symbols.try_emplace(symbol);
+    State& state = it->second;
+    if (inserted) {
+      state.open = price;
+    }
+    state.percentChange = (price - state.open) / state.open * 100.0;
+    state.volume += volume;
+
+    for (std::size_t r = 0; r < Board::kRankings; ++r) {
+      auto& top = shard.top[r];
+      const Ranked updated{&it->first, &state, score(state, r)};
+      const auto existing =
+          std::find_if(top.begin(), top.end(), [&](const Ranked& e) { return e.symbol == updated.symbol; });
+      if (existing == top.end()) {
+        insertSorted(top, updated);
+        continue;
+      }
+      const bool fell = updated.score < existing->score;
+      top.erase(existing);
+      if (fell && top.size() + 1 == kTop && shard.symbols.size() > kTop) {
+        top.clear();
+        for (const auto& [name, other] : shard.symbols) {
+          insertSorted(top, Ranked{&name, &other, score(other, r)});
+        }
+      } else {
+        insertSorted(top, updated);
+      }
+    }
+    publish(shard);
+  }
+
+ private:
+  static void publish(Shard& shard) {
+    const std::uint64_t seq = shard.sequence.load(std::memory_order_relaxed);
+    shard.sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::size_t word = 0;
+    for (const auto& top : shard.top) {
+      for (const Ranked& entry : top) {
+        const State& state = *entry.state;
+        shard.published[word++].store(reinterpret_cast<std::uintptr_t>(entry.symbol), std::memory_order_relaxed);
+        shard.published[word++].store(0, std::memory_order_relaxed);
+        shard.published[word++].store(std::bit_cast<std::uint64_t>(state.open), std::memory_order_relaxed);
+        shard.published[word++].store(std::bit_cast<std::uint64_t>(state.percentChange), std::memory_order_relaxed);
+        shard.published[word++].store(static_cast<std::uint64_t>(state.volume), std::memory_order_relaxed);
+      }
+    }
+    shard.sequence.store(seq + 2, std::memory_order_release);
+  }
+};
+
+std::vector<std::string> makeSymbols(std::size_t count) {
+  std::vector<std::string> symbols;
+  for (std::size_t idx = 0; idx < count; ++idx) {
+    symbols.push_back("SYM" + std::to_string(idx));
+  }
+  return symbols;
+}
+
+enum class Flow { Uniform, HotMovers };
+
+// A random walk per symbol: each tick moves the price up or down, so |% change| keeps rising and falling.
+// Uniform: every symbol equally active, steps up to 0.5%. HotMovers: half the ticks go to the first 32 symbols,
+// which step up to 2%, so the ranked symbols are also the busiest ones and keep dropping out of the top K.
+std::vector<Tick> makeTicks(const std::vector<std::string>& symbols, Flow flow) {
+  constexpr std::size_t kHot = 32;
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<std::size_t> pick(0, symbols.size() - 1);
+  std::uniform_int_distribution<std::size_t> pickHot(0, std::min(kHot, symbols.size()) - 1);
+  std::bernoulli_distribution hot(flow == Flow::HotMovers ? 0.5 : 0.0);
+  std::uniform_real_distribution<double> step(-0.005, 0.005);
+  std::uniform_int_distribution<std::int64_t> size(1, 1000);
+  std::vector<double> prices(symbols.size(), 100.0);
+  std::vector<Tick> ticks;
+  ticks.reserve(kTicks);
+  for (std::size_t idx = 0; idx < kTicks; ++idx) {
+    const bool hotTick = hot(rng);
+    const std::size_t symbol = hotTick ? pickHot(rng) : pick(rng);
+    prices[symbol] *= 1.0 + step(rng) * (hotTick ? 4.0 : 1.0);
+    ticks.push_back(Tick{&symbols[symbol], prices[symbol], size(rng)});
+  }
+  return ticks;
+}
+
+// Every symbol ticks once at its opening price before timing, so the tracked set is full from the first sample
+template <typename Target>
+void seed(Target& target, const std::vector<std::string>& symbols) {
+  for (const auto& symbol : symbols) {
+    target.onTick(symbol, 100.0, 1);
+  }
+}
+
+// The board's scores against a brute-force ranking of everything it was fed
+bool matchesBruteForce(const Board& board, const std::vector<std::string>& symbols, const std::vector<Tick>& fed) {
+  struct Reference {
+    double price{100.0};
+    std::int64_t volume{1};
+  };
+  std::unordered_map<const std::string*, Reference> reference;
+  for (const auto& symbol : symbols) {
+    reference[&symbol];
+  }
+  for (const auto& tick : fed) {
+    Reference& entry = reference[tick.symbol];
+    entry.price = tick.price;
+    entry.volume += tick.volume;
+  }
+
+  for (const Ranking ranking : {Ranking::PercentChange, Ranking::Volume}) {
+    std::vector<double> expected;
+    for (const auto& [symbol, entry] : reference) {
+      expected.push_back(ranking == Ranking::PercentChange ? std::abs((entry.price - 100.0) / 100.0 * 100.0)
+                                                           : static_cast<double>(entry.volume));
+    }
+    std::sort(expected.begin(), expected.end(), std::greater<>());
+    const auto top = board.top(ranking);
+    if (top.size() != std::min(kTop, expected.size())) {
+      return false;
+    }
+    for (std::size_t idx = 0; idx < top.size(); ++idx) {
+      const double actual =
+          ranking == Ranking::PercentChange ? std::abs(top[idx].percentChange) : static_cast<double>(top[idx].volume);
+      if (std::abs(actual - expected[idx]) > 1e-9 * std::max(1.0, expected[idx])) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+struct Row {
+  Flow flow;
+  std::size_t symbols;
+  microbench::Summary board;
+  microbench::Summary rescan;
+  bool correct;
+};
+
+void printTable(const std::vector<Row>& rows) {
+  std::cout << "\n=== TopMoversBoard per-tick cost (K=" << kTop << ", " << kShards << " shards, random walk) ==="
+            << std::endl;
+  std::cout << std::left << std::setw(12) << "Flow" << std::setw(10) << "Symbols" << std::setw(12) << "per shard"
+            << std::setw(14) << "board ns" << std::setw(14) << "rescan ns" << std::setw(12) << "speedup" << std::setw(8)
+            << "check" << std::endl;
+  std::cout << std::string(82, '-') << std::endl;
+  std::cout << std::fixed;
+  for (const auto& row : rows) {
+    const auto comparison = microbench::compare(row.rescan, row.board);
+    std::cout << std::left << std::setw(12) << (row.flow == Flow::Uniform ? "uniform" : "hot-movers") << std::setw(10)
+              << row.symbols << std::setw(12) << row.symbols / kShards
+              << std::setprecision(0) << std::setw(14) << row.board.medianNanos << std::setw(14)
+              << row.rescan.medianNanos << std::setw(12)
+              << (std::to_string(comparison.speedup).substr(0, 5) + (comparison.significant ? "*" : ""))
+              << std::setw(8) << (row.correct ? "ok" : "WRONG") << std::endl;
+  }
+  std::cout << "\nboard = TopMoversBoard::onTick (both rankings plus the seqlock publish); rescan = earlier design."
+            << "\nspeedup = rescan / board (* = 95% CIs do not overlap)." << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  const auto format = microbench::formatFromArgs(argc, argv);
+
+  std::vector<Row> rows;
+  bool allCorrect = true;
+  for (const Flow flow : {Flow::Uniform, Flow::HotMovers}) {
+    for (const std::size_t count : {256u, 4096u, 65536u}) {
+      const auto symbols = makeSymbols(count);
+      const auto ticks = makeTicks(symbols, flow);
+      const std::string suffix =
+          std::string(flow == Flow::Uniform ? "/uniform/" : "/hot-movers/") + std::to_string(count) + "sym";
+
+      // The brute-force check replays one pass of the stream on its own board
+      Board checked;
+      seed(checked, symbols);
+      for (const auto& tick : ticks) {
+        checked.onTick(*tick.symbol, tick.price, tick.volume);
+      }
+      const bool correct = matchesBruteForce(checked, symbols, ticks);
+      allCorrect = allCorrect && correct;
+
+      Board board;
+      seed(board, symbols);
+      std::size_t next = 0;
+      auto boardSummary = microbench::measure(
+          "TopMoversBoard::onTick" + suffix,
+          [&] {
+            const Tick& tick = ticks[next++ % kTicks];
+            board.onTick(*tick.symbol, tick.price, tick.volume);
+          },
+          kOptions);
+
+      RescanBoard rescan;
+      seed(rescan, symbols);
+      next = 0;
+      auto rescanSummary = microbench::measure(
+          "RescanBoard::onTick" + suffix,
+          [&] {
+            const Tick& tick = ticks[next++ % kTicks];
+            rescan.onTick(*tick.symbol, tick.price, tick.volume);
+          },
+          kOptions);
+
+      rows.push_back(Row{flow, count, std::move(boardSummary), std::move(rescanSummary), correct});
+    }
+  }
+
+  if (format != microbench::Format::Table) {
+    std::vector<microbench::Summary> summaries;
+    for (const auto& row : rows) {
+      summaries.push_back(row.board);
+      summaries.push_back(row.rescan);
+    }
+    microbench::write(std::cout, summaries, format);
+  } else {
+    printTable(rows);
+  }
+
+  if (!allCorrect) {
+    std::cerr << "TopMoversBoard disagrees with the brute-force ranking" << std::endl;
+    return 1;
+  }
+  return 0;
+}
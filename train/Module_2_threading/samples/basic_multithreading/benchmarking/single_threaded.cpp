@@ -47,14 +47,16 @@ Web Services: Implementing scalable server applications that handle thousands of
 Scientific Computing: Building simulation systems that leverage multiple CPU cores for complex calculations
 */
 
-// Compile (GCC/Clang): g++ -std=gnu++20 -O2 -pthread task4_benchmark.cpp -o bench
-// Compile (MSVC):      cl /std:c++20 /O2 task4_benchmark.cpp
+// Compile (GCC/Clang): g++ -std=gnu++20 -O2 -pthread -I../../async_future_promise single_threaded.cpp -o bench
+// Compile (MSVC):      cl /std:c++20 /O2 /I..\..\async_future_promise single_threaded.cpp
+// Run with --csv or --json for machine-readable results on stdout; progress and checksums then go to stderr.
 
 #include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cmath>
 #include <iostream>
+#include <ostream>
 #include <mutex>
 #include <numeric>
 #include <random>
@@ -62,16 +64,19 @@ Scientific Computing: Building simulation systems that leverage multiple CPU cor
 #include <thread>
 #include <vector>
 
+#include "MicroBenchmark.h"
+
 namespace bench {
 
 // ---------- Utilities ----------
 std::mutex ioMutex;
+std::ostream* progressOut = &std::cout;  // stderr when stdout carries CSV/JSON
 
-// Thread-safe print
+// Thread-safe print of progress and checksums
 template <class... Args>
 void ts_print(Args&&... args) {
   std::lock_guard<std::mutex> lock(ioMutex);
-  (std::cout << ... << args) << std::endl;
+  (*progressOut << ... << args) << std::endl;
 }
 
 // Deterministic RNG per thread
@@ -82,19 +87,30 @@ inline thread_local std::mt19937 rng{[] {
   return std::mt19937{seeder()};
 }()};
 
-// RAII benchmark timer
+// Repeated measurement (warmup, median, 95% CI) instead of a single timed run
 class PerformanceBenchmark {
-  std::chrono::high_resolution_clock::time_point start_;
-  std::string name_;
+  std::vector<microbench::Summary> results_;
 
  public:
-  explicit PerformanceBenchmark(std::string name)
-      : start_(std::chrono::high_resolution_clock::now()), name_(std::move(name)) {}
-  ~PerformanceBenchmark() {
-    const auto end = std::chrono::high_resolution_clock::now();
-    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start_).count();
-    ts_print(name_, " took: ", ms, " ms");
+  template <class Fn>
+  double run(std::string name, Fn&& fn) {
+    double result = 0.0;
+    const microbench::Options options{
+        .warmupRuns = 1, .minSamples = 5, .maxSamples = 50, .timeBudget = std::chrono::seconds(1)};
+    auto summary = microbench::measure(
+        std::move(name),
+        [&] {
+          result = fn();
+          microbench::DoNotOptimize(result);
+        },
+        options);
+    ts_print(summary.name, " took: ", summary.medianMillis(), " ms (95% CI ", summary.ciLowNanos / 1e6, "-",
+             summary.ciHighNanos / 1e6, " ms, ", summary.samples, " samples)");
+    results_.push_back(std::move(summary));
+    return result;
   }
+
+  const std::vector<microbench::Summary>& results() const { return results_; }
 };
 
 // ---------- Workload helpers ----------
@@ -104,7 +120,7 @@ inline double work_fn(double v) {
 }
 
 std::vector<double> make_data(int n) {
-  std::unFiform_real_distribution<> dis(1.0, 10.0);
+  std::uniform_real_distribution<> dis(1.0, 10.0);
   std::vector<double> data(n);
   std::generate(data.begin(), data.end(), [&] { return dis(rng); });
   return data;
@@ -152,24 +168,18 @@ double processMultiThreaded(const std::vector<double>& data, unsigned threads) {
 }
 
 // ---------- Benchmark harness ----------
-void runBenchmark(int dataSize, unsigned threadsForMulti /* 0 = auto */) {
+void runBenchmark(PerformanceBenchmark& b, int dataSize, unsigned threadsForMulti /* 0 = auto */) {
   auto data = make_data(dataSize);
 
-  double singleSum = 0.0;
-  {
-    PerformanceBenchmark b("Single-threaded processing");
-    singleSum = processSingleThreaded(data);
-  }
+  const double singleSum = b.run("Single-threaded processing", [&] { return processSingleThreaded(data); });
   ts_print("[single] checksum = ", singleSum);
 
   const unsigned autoThreads =
       threadsForMulti == 0 ? std::max(1u, std::thread::hardware_concurrency()) : threadsForMulti;
 
-  double multiSum = 0.0;
-  {
-    PerformanceBenchmark b(std::string("Multi-threaded processing (") + std::to_string(autoThreads) + " threads)");
-    multiSum = processMultiThreaded(data, autoThreads);
-  }
+  const double multiSum =
+      b.run(std::string("Multi-threaded processing (") + std::to_string(autoThreads) + " threads)",
+            [&] { return processMultiThreaded(data, autoThreads); });
   ts_print("[multi ] checksum = ", multiSum);
 
   const double diff = std::abs(singleSum - multiSum);
@@ -179,16 +189,25 @@ void runBenchmark(int dataSize, unsigned threadsForMulti /* 0 = auto */) {
 }  // namespace bench
 
 // ---------- Choose scenarios ----------
-int main() {
+int main(int argc, char* argv[]) {
   using namespace bench;
   const int DATA_SIZE = 2'000'000;
+  const auto format = microbench::formatFromArgs(argc, argv);
+  if (format != microbench::Format::Table) {
+    progressOut = &std::cerr;
+  }
 
-  runBenchmark(DATA_SIZE, 0);  // auto
-  runBenchmark(DATA_SIZE, 1);
-  runBenchmark(DATA_SIZE, 2);
-  runBenchmark(DATA_SIZE, 4);
-  runBenchmark(DATA_SIZE, 8);
-  runBenchmark(DATA_SIZE, 16);
+  PerformanceBenchmark b;
+  runBenchmark(b, DATA_SIZE, 0);  // auto
+  runBenchmark(b, DATA_SIZE, 1);
+  runBenchmark(b, DATA_SIZE, 2);
+  runBenchmark(b, DATA_SIZE, 4);
+  runBenchmark(b, DATA_SIZE, 8);
+  runBenchmark(b, DATA_SIZE, 16);
 
+  if (format == microbench::Format::Table) {
+    std::cout << std::endl;
+  }
+  microbench::write(std::cout, b.results(), format);
   return 0;
 }
\ No newline at end of file
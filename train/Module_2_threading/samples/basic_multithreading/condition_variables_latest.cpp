@@ -8,6 +8,8 @@ Producer threads generate data and add it to the thread-safe queue
 Consumer threads process data from the queue as it becomes available
 The system gracefully shuts down when all data is processed
 Experiment with different numbers of producers and consumers to observe performance characteristics.
+Then let one consumer react to whichever of several sources has data (ticks, control messages, a heartbeat timer):
+channels (Channel.h) plus select block on all of them with a single wakeup instead of polling each queue.
 
 ✅ Success Checklist
 
@@ -15,6 +17,7 @@ Producer threads successfully add data to the queue
 Consumer threads wait appropriately when queue is empty
 All produced data gets consumed without loss
 System shuts down cleanly when production is complete
+The select consumer handles every tick, every control message and some heartbeats, then drains and exits
 */
 #include <atomic>
 #include <chrono>
@@ -30,6 +33,8 @@ System shuts down cleanly when production is complete
 #include <thread>
 #include <vector>
 
+#include "Channel.h"
+
 using namespace std::chrono_literals;
 
 namespace {
@@ -165,11 +170,69 @@ void run_demo(const ProductionPlan& plan) {
 
   // Let consumers finish draining the queue before leaving scope (jthread joins automatically).
 }
+
+void run_select_demo(const ProductionPlan& plan) {
+  channels::Channel<ThreadSafeQueue::Item> ticks(8);  // buffered: producers only block when the consumer lags
+  channels::Channel<std::string> control;              // unbuffered: send() returns once the consumer has it
+  channels::Ticker heartbeat(25ms);
+  Metrics metrics;
+
+  std::jthread consumer([&](std::stop_token stopToken) {
+    int heartbeats = 0;
+    bool shutdown = false;
+    while (!shutdown &&
+           channels::select(
+               stopToken,
+               channels::onReceive(ticks,
+                                   [&](ThreadSafeQueue::Item item) {
+                                     ++metrics.consumed;
+                                     std::cout << "select: value " << item.second << " from producer " << item.first
+                                               << '\n';
+                                   }),
+               channels::onReceive(control,
+                                   [&](std::string command) {
+                                     std::cout << "select: control '" << command << "' after " << metrics.consumed
+                                               << " tick(s)" << std::endl;
+                                     shutdown = command == "shutdown";
+                                   }),
+               channels::onReceive(heartbeat.channel(), [&](auto) { ++heartbeats; }))) {
+    }
+    // Ticks is closed by now; take what is still buffered
+    while (auto item = ticks.receive(stopToken)) {
+      ++metrics.consumed;
+    }
+    std::cout << "select: consumer saw " << heartbeats << " heartbeat(s)" << std::endl;
+  });
+
+  {
+    std::vector<std::jthread> producers;
+    for (int id : std::views::iota(0, plan.producers)) {
+      producers.emplace_back([&, id](std::stop_token stopToken) {
+        for (double value : create_payloads(plan.itemsPerProducer, std::random_device{}() + id)) {
+          if (!ticks.send({id, value}, stopToken)) {
+            break;
+          }
+          ++metrics.produced;
+          std::this_thread::sleep_for(10ms);
+        }
+      });
+    }
+    control.send("report");
+  }  // producers completed their work here
+
+  ticks.close();
+  control.send("shutdown");
+  consumer.join();
+
+  std::cout << "Select demo: produced " << metrics.produced.load() << " item(s); consumed " << metrics.consumed.load()
+            << " item(s)." << std::endl;
+}
 }  // namespace
 
 int main() {
   ProductionPlan plan{};
   run_demo(plan);
+  run_select_demo(plan);
   std::cout << "All tasks finished." << std::endl;
   return 0;
 }
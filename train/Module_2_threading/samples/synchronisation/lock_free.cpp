@@ -41,136 +41,102 @@ these concepts to:
 * Financial Risk Management: Developing real-time portfolio analysis systems with complex synchronization requirements
 */
 #include <atomic>
+#include <chrono>
 #include <iostream>
 #include <memory>
 #include <mutex>
 #include <stack>
+#include <string>
 #include <thread>
 #include <vector>
 
-template <typename T>
-class LockFreeStack {
- private:
-  struct Node {
-    T data;
-    std::atomic<Node*> next;
-
-    Node(T item) : data(std::move(item)), next(nullptr) {}
-  };
-
-  std::atomic<Node*> head_;
-  std::atomic<size_t> size_{0};
-
- public:
-  LockFreeStack() : head_(nullptr) {}
-
-  ~LockFreeStack() {
-    Node* node = head_.load();
-    while (node) {
-      Node* next_node = node->next;
-      delete node;
-      head_.store(next_node);
-      node = next_node;
-    }
-  }
-
-  void push(T item) {
-    Node* newNode = new Node(std::move(item));
-    Node* oldHead = head_.load();  // Create an lvalue to hold the current head
-
-    do {
-      newNode->next = oldHead;  // Set the new node's next to the current head
-    }
-
-    while (!head_.compare_exchange_weak(oldHead, newNode));
-    size_.fetch_add(1);
-  }
+#include "LockFreeStack.h"
+#include "MicroBenchmark.h"
+#include "SpinLocks.h"
 
-  bool pop(T& result) {
-    Node* head = head_.load();
-
-    while (head && !head_.compare_exchange_weak(head, head->next.load())) {
-      // Retry with updated head
-    }
-
-    if (!head) {
-      return false;
-    }
-
-    result = std::move(head->data);
-    size_.fetch_sub(1);
-
-    // Safe deletion - in production, use hazard pointers or epochs
-    delete head;
-    return true;
-  }
-
-  bool empty() const { return head_.load() == nullptr; }
-
-  size_t size() const { return size_.load(); }
-};
+using lockfree::LockFreeStack;
 
 class PerformanceComparison {
  public:
-  static void benchmarkLockBased(int operations, int threads) {
-    std::stack<int> stack;
-    std::mutex stackMutex;
-
-    auto start = std::chrono::high_resolution_clock::now();
-
-    std::vector<std::thread> workerThreads;
-    for (int i = 0; i < threads; ++i) {
-      workerThreads.emplace_back([&, i]() {
+  // Same push/pop pairs as benchmarkLockFree, behind one lock of type Mutex
+  template <typename Mutex = std::mutex>
+  static microbench::Summary benchmarkLockBased(int operations, int threads) {
+    const std::string name = "Lock-based stack (" + std::string(locks::kLockName<Mutex>) + ")";
+    const auto summary = microbench::measureTimed(name, [&] {
+      std::stack<int> stack;
+      Mutex stackMutex;
+      return runWorkers(threads, [&](int i) {
         for (int j = 0; j < operations / threads; ++j) {
           {
-            std::lock_guard<std::mutex> lock(stackMutex);
+            std::lock_guard<Mutex> lock(stackMutex);
             stack.push(i * 1000 + j);
           }
 
           {
-            std::lock_guard<std::mutex> lock(stackMutex);
+            std::lock_guard<Mutex> lock(stackMutex);
             if (!stack.empty()) {
               stack.pop();
             }
           }
         }
       });
-    }
-
-    for (auto& t : workerThreads) {
-      t.join();
-    }
+    });
 
-    auto end = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+    report(summary);
+    return summary;
+  }
 
-    std::cout << "Lock-based stack: " << duration.count() << " ms" << std::endl;
+  // The lock-based stack once per lock type, the way thread_sync.cpp sweeps its read/write mix
+  static std::vector<microbench::Summary> benchmarkLockTypes(int operations, int threads) {
+    return {benchmarkLockBased<std::mutex>(operations, threads),
+            benchmarkLockBased<locks::TtasSpinLock>(operations, threads),
+            benchmarkLockBased<locks::TicketLock>(operations, threads),
+            benchmarkLockBased<locks::McsLock>(operations, threads),
+            benchmarkLockBased<locks::AdaptiveMutex>(operations, threads)};
   }
 
-  static void benchmarkLockFree(int operations, int threads) {
-    LockFreeStack<int> stack;
+  static microbench::Summary benchmarkLockFree(int operations, int threads) {
+    const auto summary = microbench::measureTimed("Lock-free stack", [&] {
+      LockFreeStack<int> stack;
+      return runWorkers(threads, [&](int i) {
+        for (int j = 0; j < operations / threads; ++j) {
+          stack.push(i * 1000 + j);
+
+          int dummy;
+          (void)stack.tryPop(dummy);
+        }
+      });
+    });
 
-    auto start = std::chrono::high_resolution_clock::now();
+    report(summary);
+    return summary;
+  }
 
+ private:
+  // Times from the moment all workers are released until the last one joins; thread creation is excluded
+  template <typename Work>
+  static std::chrono::nanoseconds runWorkers(int threads, Work work) {
+    std::atomic<bool> go{false};
     std::vector<std::thread> workerThreads;
     for (int i = 0; i < threads; ++i) {
       workerThreads.emplace_back([&, i]() {
-        for (int j = 0; j < operations / threads; ++j) {
-          stack.push(i * 1000 + j);
-
-          int dummy;
-          stack.pop(dummy);
+        while (!go.load(std::memory_order_acquire)) {
         }
+        work(i);
       });
     }
 
+    const auto start = microbench::Clock::now();
+    go.store(true, std::memory_order_release);
     for (auto& t : workerThreads) {
       t.join();
     }
+    return microbench::Clock::now() - start;
+  }
 
-    auto end = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-
-    std::cout << "Lock-free stack: " << duration.count() << " ms" << std::endl;
+  static void report(const microbench::Summary& summary) {
+    std::cout << summary.name << ": " << summary.medianMillis() << " ms (95% CI " << summary.ciLowNanos / 1e6 << "-"
+              << summary.ciHighNanos / 1e6 << " ms, " << summary.samples << " samples, " << summary.outliers
+              << " outliers)" << std::endl;
   }
-};
\ No newline at end of file
+};
@@ -47,118 +47,33 @@ these concepts to:
 #include <iomanip>
 #include <iostream>
 #include <map>
+#include <mutex>
 #include <random>
 #include <shared_mutex>
 #include <span>
+#include <sstream>
 #include <stop_token>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <utility>
 #include <vector>
 
-using namespace std::chrono_literals;
-
-template <typename T>
-class LockFreeStack {
- private:
-  struct Node {
-    T value;
-    Node* next{nullptr};
-
-    explicit Node(T data) : value(std::move(data)) {}
-  };
-
-  struct RetiredNode {
-    Node* node;
-    RetiredNode* next;
-  };
-
-  std::atomic<Node*> head_{nullptr};
-  std::atomic<RetiredNode*> retiredHead_{nullptr};
-  std::atomic<std::size_t> size_{0};
-
-  static void reclaim(Node* node) {
-    while (node) {
-      Node* next = node->next;
-      delete node;
-      node = next;
-    }
-  }
+#include "ContentionCounters.h"
+#include "EliminationBackoffStack.h"
+#include "FlatCombining.h"
+#include "LockFreeStack.h"
+#include "MicroBenchmark.h"
+#include "SpinLocks.h"
 
-  static void reclaimRetired(RetiredNode* retired) {
-    while (retired) {
-      RetiredNode* next = retired->next;
-      delete retired->node;
-      delete retired;
-      retired = next;
-    }
-  }
-
-  void deferDelete(Node* node) {
-    auto* retired = new RetiredNode{node, nullptr};
-    auto oldHead = retiredHead_.load(std::memory_order_relaxed);
-    do {
-      retired->next = oldHead;
-    } while (!retiredHead_.compare_exchange_weak(oldHead, retired, std::memory_order_release,
-                                                std::memory_order_relaxed));
-  }
-
- public:
-  LockFreeStack() = default;
-  LockFreeStack(const LockFreeStack&) = delete;
-  LockFreeStack& operator=(const LockFreeStack&) = delete;
-
-  ~LockFreeStack() {
-    reclaim(head_.exchange(nullptr, std::memory_order_acquire));
-    reclaimRetired(retiredHead_.exchange(nullptr, std::memory_order_acquire));
-  }
-
-  void push(T value) {
-    Node* newNode = new Node(std::move(value));
-    Node* oldHead = head_.load(std::memory_order_acquire);
-    do {
-      newNode->next = oldHead;
-    } while (!head_.compare_exchange_weak(oldHead, newNode, std::memory_order_release,
-                                          std::memory_order_acquire));
-    size_.fetch_add(1, std::memory_order_relaxed);
-  }
-
-  [[nodiscard]] bool tryPop(T& result) {
-    Node* oldHead = head_.load(std::memory_order_acquire);
-    while (oldHead &&
-           !head_.compare_exchange_weak(oldHead, oldHead->next, std::memory_order_acq_rel,
-                                        std::memory_order_acquire)) {
-    }
-
-    if (!oldHead) {
-      return false;
-    }
-
-    result = oldHead->value;
-    size_.fetch_sub(1, std::memory_order_relaxed);
-    deferDelete(oldHead);
-    return true;
-  }
-
-  [[nodiscard]] bool peek(T& result) const {
-    Node* snapshot = head_.load(std::memory_order_acquire);
-    if (!snapshot) {
-      return false;
-    }
-    result = snapshot->value;
-    return true;
-  }
-
-  [[nodiscard]] bool empty() const { return head_.load(std::memory_order_acquire) == nullptr; }
-
-  [[nodiscard]] std::size_t size() const { return size_.load(std::memory_order_relaxed); }
-};
+using namespace std::chrono_literals;
 
-template <typename T>
+// Mutex may be any Lockable (see SpinLocks.h); empty()/size() take a shared lock only if it has one
+template <typename T, typename Mutex = std::shared_mutex>
 class LockBasedStack {
  private:
   std::vector<T> storage_;
-  mutable std::shared_mutex mutex_;
+  mutable Mutex mutex_;
 
  public:
   LockBasedStack() = default;
@@ -175,46 +90,64 @@ class LockBasedStack {
     if (storage_.empty()) {
       return false;
     }
-    result = storage_.back();
+    result = std::move(storage_.back());
     storage_.pop_back();
     return true;
   }
 
-  [[nodiscard]] bool peek(T& result) const {
-    std::shared_lock lock(mutex_);
-    if (storage_.empty()) {
-      return false;
-    }
-    result = storage_.back();
-    return true;
-  }
-
   [[nodiscard]] bool empty() const {
-    std::shared_lock lock(mutex_);
+    locks::ReadLock<Mutex> lock(mutex_);
     return storage_.empty();
   }
 
   [[nodiscard]] std::size_t size() const {
-    std::shared_lock lock(mutex_);
+    locks::ReadLock<Mutex> lock(mutex_);
     return storage_.size();
   }
 };
 
 struct WorkloadProfile {
-  std::string label;
+  std::string_view label;  // string_view so kWorkloads can stay constexpr
   double writeProbability;  // 0..1 where 1 means always push/pop
 };
 
+// Exclusive locks swept through LockBasedStack, against the std::shared_mutex baseline
+template <typename... Mutexes>
+struct LockList {
+  static constexpr std::array<std::string_view, sizeof...(Mutexes)> kNames{locks::kLockName<Mutexes>...};
+};
+
+using SweptLocks = LockList<std::mutex, locks::TtasSpinLock, locks::TicketLock, locks::McsLock, locks::AdaptiveMutex>;
+
 struct ScenarioResult {
   int threads;
   int operations;
   std::string workload;
-  double lockBasedMs;
-  double lockFreeMs;
-
-  [[nodiscard]] double speedup() const { return lockFreeMs == 0.0 ? 0.0 : lockBasedMs / lockFreeMs; }
+  microbench::Summary lockBased;
+  microbench::Summary lockFree;
+  microbench::Summary elimination;
+  microbench::Summary flatCombining;
+  std::vector<microbench::Summary> lockSweep;  // LockBasedStack<int, Mutex> per SweptLocks entry
+  contention::Snapshot lockFreeContention;  // all samples and warmups of the measurement, zero unless compiled in
+  contention::Snapshot eliminationContention;
+
+  [[nodiscard]] double lockBasedMs() const { return lockBased.medianMillis(); }
+  [[nodiscard]] double lockFreeMs() const { return lockFree.medianMillis(); }
+  [[nodiscard]] double eliminationMs() const { return elimination.medianMillis(); }
+  [[nodiscard]] double flatCombiningMs() const { return flatCombining.medianMillis(); }
+  [[nodiscard]] double speedup() const { return microbench::compare(lockBased, lockFree).speedup; }
+  [[nodiscard]] double eliminationSpeedup() const { return microbench::compare(lockBased, elimination).speedup; }
+  [[nodiscard]] double flatCombiningSpeedup() const { return microbench::compare(lockBased, flatCombining).speedup; }
 };
 
+// Speedup with a '*' when the two medians' 95% confidence intervals do not overlap
+inline std::string speedupLabel(const microbench::Summary& baseline, const microbench::Summary& candidate) {
+  const auto comparison = microbench::compare(baseline, candidate);
+  std::ostringstream label;
+  label << std::fixed << std::setprecision(3) << comparison.speedup << (comparison.significant ? "*" : "");
+  return label.str();
+}
+
 struct SpeedAggregate {
   double total{0.0};
   int samples{0};
@@ -245,22 +178,29 @@ class BenchmarkHarness {
   }
 
   static void printTable(std::span<const ScenarioResult> rows) {
-    std::cout << "\n=== Benchmark Matrix (milliseconds) ===" << std::endl;
+    std::cout << "\n=== Benchmark Matrix (median milliseconds; * = significant at 95%) ===" << std::endl;
     std::cout << std::left << std::setw(8) << "Thr" << std::setw(12) << "Ops"
               << std::setw(22) << "Workload" << std::setw(16) << "Lock-Based"
-              << std::setw(16) << "Lock-Free" << std::setw(10) << "Speedup" << std::endl;
-    std::cout << std::string(84, '-') << std::endl;
+              << std::setw(16) << "Lock-Free" << std::setw(10) << "Speedup"
+              << std::setw(16) << "Elimination" << std::setw(10) << "Speedup"
+              << std::setw(16) << "Flat-Comb." << std::setw(10) << "Speedup" << std::endl;
+    std::cout << std::string(136, '-') << std::endl;
 
     std::cout << std::fixed << std::setprecision(3);
     for (const auto& row : rows) {
       std::cout << std::left << std::setw(8) << row.threads << std::setw(12) << row.operations
-                << std::setw(22) << row.workload << std::setw(16) << row.lockBasedMs
-                << std::setw(16) << row.lockFreeMs << std::setw(10) << row.speedup() << std::endl;
+                << std::setw(22) << row.workload << std::setw(16) << row.lockBasedMs()
+                << std::setw(16) << row.lockFreeMs() << std::setw(10) << speedupLabel(row.lockBased, row.lockFree)
+                << std::setw(16) << row.eliminationMs() << std::setw(10)
+                << speedupLabel(row.lockBased, row.elimination) << std::setw(16) << row.flatCombiningMs()
+                << std::setw(10) << speedupLabel(row.lockBased, row.flatCombining) << std::endl;
     }
   }
 
   static void printInsights(std::span<const ScenarioResult> rows) {
     std::map<int, SpeedAggregate> byThreads;
+    std::map<int, SpeedAggregate> eliminationByThreads;
+    std::map<int, SpeedAggregate> flatCombiningByThreads;
     std::map<std::string, SpeedAggregate> byWorkload;
     int lockFreeWins = 0;
     int lockBasedWins = 0;
@@ -270,6 +210,8 @@ class BenchmarkHarness {
     for (const auto& row : rows) {
       const double speed = row.speedup();
       byThreads[row.threads].add(speed);
+      eliminationByThreads[row.threads].add(row.eliminationSpeedup());
+      flatCombiningByThreads[row.threads].add(row.flatCombiningSpeedup());
       byWorkload[row.workload].add(speed);
       if (speed > 1.0) {
         ++lockFreeWins;
@@ -288,7 +230,9 @@ class BenchmarkHarness {
     std::cout << "\n=== Speedup by Thread Count (lock-based / lock-free) ===" << std::endl;
     for (const auto& [threads, aggregate] : byThreads) {
       std::cout << "Threads " << std::setw(2) << threads << ": avg speedup " << std::setw(6) << std::setprecision(3)
-                << aggregate.average() << std::endl;
+                << aggregate.average() << " | elimination " << std::setw(6)
+                << eliminationByThreads[threads].average() << " | flat-combining " << std::setw(6)
+                << flatCombiningByThreads[threads].average() << std::endl;
     }
 
     std::cout << "\n=== Speedup by Workload Mix ===" << std::endl;
@@ -307,23 +251,149 @@ class BenchmarkHarness {
     }
   }
 
+  // LockBasedStack with each swept lock; speedups are against the std::shared_mutex column
+  static void printLockSweep(std::span<const ScenarioResult> rows) {
+    constexpr auto& names = SweptLocks::kNames;
+    std::cout << "\n=== Lock Sweep: LockBasedStack (median milliseconds) ===" << std::endl;
+    std::cout << std::left << std::setw(8) << "Thr" << std::setw(12) << "Ops" << std::setw(22) << "Workload"
+              << std::setw(20) << locks::kLockName<std::shared_mutex>;
+    for (const auto name : names) {
+      std::cout << std::setw(14) << name;
+    }
+    std::cout << "Fastest" << std::endl;
+    std::cout << std::string(62 + 14 * names.size() + 20, '-') << std::endl;
+
+    std::map<int, std::vector<SpeedAggregate>> speedupByThreads;
+    std::cout << std::fixed << std::setprecision(3);
+    for (const auto& row : rows) {
+      std::cout << std::left << std::setw(8) << row.threads << std::setw(12) << row.operations << std::setw(22)
+                << row.workload << std::setw(20) << row.lockBasedMs();
+      std::string_view fastest = locks::kLockName<std::shared_mutex>;
+      double fastestMs = row.lockBasedMs();
+      auto& aggregates = speedupByThreads[row.threads];
+      aggregates.resize(names.size());
+      for (std::size_t idx = 0; idx < names.size(); ++idx) {
+        const auto& summary = row.lockSweep[idx];
+        std::cout << std::setw(14) << summary.medianMillis();
+        aggregates[idx].add(microbench::compare(row.lockBased, summary).speedup);
+        if (summary.medianMillis() < fastestMs) {
+          fastestMs = summary.medianMillis();
+          fastest = names[idx];
+        }
+      }
+      std::cout << fastest << std::endl;
+    }
+
+    std::cout << "\n=== Lock Sweep: avg speedup over std::shared_mutex by thread count ===" << std::endl;
+    std::cout << std::left << std::setw(8) << "Thr";
+    for (const auto name : names) {
+      std::cout << std::setw(14) << name;
+    }
+    std::cout << std::endl;
+    for (const auto& [threads, aggregates] : speedupByThreads) {
+      std::cout << std::setw(8) << threads;
+      for (const auto& aggregate : aggregates) {
+        std::cout << std::setw(14) << aggregate.average();
+      }
+      std::cout << std::endl;
+    }
+  }
+
+  // Head CAS attempts per operation and failure share, by thread count; needs -DLOCKFREE_CONTENTION_COUNTERS=1
+  static void printContention(std::span<const ScenarioResult> rows) {
+    if constexpr (!contention::kEnabled) {
+      std::cout << "\n(Rebuild with -DLOCKFREE_CONTENTION_COUNTERS=1 for CAS retry and reclamation counters.)"
+                << std::endl;
+      return;
+    }
+
+    std::map<int, std::pair<contention::Snapshot, double>> lockFreeByThreads;
+    std::map<int, std::pair<contention::Snapshot, double>> eliminationByThreads;
+    const auto accumulate = [](std::pair<contention::Snapshot, double>& total, const contention::Snapshot& delta,
+                               const microbench::Summary& summary, int operations) {
+      for (std::size_t idx = 0; idx < contention::kEventCount; ++idx) {
+        total.first.values[idx] += delta.values[idx];
+      }
+      total.second += static_cast<double>(operations) *
+                      static_cast<double>(summary.samples + kMeasurementOptions.warmupRuns);
+    };
+    for (const auto& row : rows) {
+      accumulate(lockFreeByThreads[row.threads], row.lockFreeContention, row.lockFree, row.operations);
+      accumulate(eliminationByThreads[row.threads], row.eliminationContention, row.elimination, row.operations);
+    }
+
+    const auto printRow = [](int threads, const std::pair<contention::Snapshot, double>& total) {
+      using contention::Event;
+      const auto& counters = total.first;
+      const auto perOp = [&](Event event) { return static_cast<double>(counters[event]) / total.second; };
+      std::cout << std::right << std::setw(8) << threads << std::setw(14) << perOp(Event::StackPushCas)
+                << std::setw(14) << counters.failureRate(Event::StackPushCas, Event::StackPushCasFailed) * 100.0
+                << std::setw(14) << perOp(Event::StackPopCas) << std::setw(14)
+                << counters.failureRate(Event::StackPopCas, Event::StackPopCasFailed) * 100.0 << std::setw(14)
+                << perOp(Event::FreeListCas) << std::left << std::endl;
+    };
+    const auto printHeader = [](std::string_view title) {
+      std::cout << "\n=== Contention: " << title << " (per operation) ===" << std::endl;
+      std::cout << std::right << std::setw(8) << "Thr" << std::setw(14) << "push CAS" << std::setw(14)
+                << "push fail %" << std::setw(14) << "pop CAS" << std::setw(14) << "pop fail %" << std::setw(14)
+                << "freelist CAS" << std::left << std::endl;
+    };
+
+    printHeader("lock-free stack");
+    for (const auto& [threads, total] : lockFreeByThreads) {
+      printRow(threads, total);
+    }
+    printHeader("elimination stack");
+    for (const auto& [threads, total] : eliminationByThreads) {
+      printRow(threads, total);
+    }
+  }
+
  private:
   static ScenarioResult runScenario(int operations, int threads, const WorkloadProfile& workload) {
-    ScenarioResult result{threads, operations, workload.label, 0.0, 0.0};
-    result.lockBasedMs = measureStack<LockBasedStack<int>>(operations, threads, workload);
-    result.lockFreeMs = measureStack<LockFreeStack<int>>(operations, threads, workload);
+    ScenarioResult result{threads, operations, std::string(workload.label), {}, {}, {}, {}, {}, {}, {}};
+    const std::string suffix =
+        "/" + std::to_string(threads) + "thr/" + std::to_string(operations) + "ops/" + result.workload;
+    result.lockBased = measureStack<LockBasedStack<int>>("lock-based" + suffix, operations, threads, workload);
+    auto before = contention::snapshot();
+    result.lockFree = measureStack<lockfree::LockFreeStack<int>>("lock-free" + suffix, operations, threads, workload);
+    result.lockFreeContention = contention::snapshot() - before;
+    before = contention::snapshot();
+    result.elimination =
+        measureStack<lockfree::EliminationBackoffStack<int>>("elimination" + suffix, operations, threads, workload);
+    result.eliminationContention = contention::snapshot() - before;
+    result.flatCombining =
+        measureStack<combining::FlatCombiningStack<int>>("flat-combining" + suffix, operations, threads, workload);
+    result.lockSweep = sweepLocks(SweptLocks{}, suffix, operations, threads, workload);
     return result;
   }
 
+  template <typename... Mutexes>
+  static std::vector<microbench::Summary> sweepLocks(LockList<Mutexes...>, const std::string& suffix, int operations,
+                                                     int threads, const WorkloadProfile& workload) {
+    // Braced initialisation runs the measurements in order
+    return {measureStack<LockBasedStack<int, Mutexes>>("lock-based[" + std::string(locks::kLockName<Mutexes>) + "]" +
+                                                           suffix,
+                                                       operations, threads, workload)...};
+  }
+
+  // Fresh stack per sample; only the barrier-to-join window is timed, not thread creation
   template <typename Stack>
-  static double measureStack(int operations, int threadCount, const WorkloadProfile& workload) {
-    Stack stack;
-    return executeWorkload(stack, operations, threadCount, workload);
+  static microbench::Summary measureStack(std::string name, int operations, int threadCount,
+                                          const WorkloadProfile& workload) {
+    return microbench::measureTimed(
+        std::move(name),
+        [&] {
+          Stack stack;
+          return executeWorkload(stack, operations, threadCount, workload);
+        },
+        kMeasurementOptions);
   }
 
   template <typename Stack>
-  static double executeWorkload(Stack& stack, int operations, int threadCount, const WorkloadProfile& workload) {
-    using Clock = std::chrono::steady_clock;
+  static std::chrono::nanoseconds executeWorkload(Stack& stack, int operations, int threadCount,
+                                                  const WorkloadProfile& workload) {
+    using Clock = microbench::Clock;
     std::vector<std::jthread> workers;
     workers.reserve(threadCount);
 
@@ -351,7 +421,8 @@ class BenchmarkHarness {
               (void)stack.tryPop(value);
             }
           } else {
-            (void)stack.peek(value);
+            // Read = observe the top; the lock-free stack has no safe peek, so both stacks check emptiness
+            (void)stack.empty();
           }
         }
       });
@@ -362,9 +433,12 @@ class BenchmarkHarness {
     }
 
     const auto endTime = Clock::now();
-    return std::chrono::duration<double, std::milli>(endTime - startTime).count();
+    return endTime - startTime;
   }
 
+  static constexpr microbench::Options kMeasurementOptions{
+      .warmupRuns = 1, .minSamples = 5, .maxSamples = 30, .timeBudget = 40ms, .minSampleTime = 0ns};
+
   static constexpr std::array<int, 5> kThreadCounts{1, 2, 4, 8, 16};
   static constexpr std::array<int, 3> kOperationCounts{1000, 10000, 100000};
   static constexpr std::array<WorkloadProfile, 3> kWorkloads{
@@ -374,11 +448,24 @@ class BenchmarkHarness {
   };
 };
 
-int main() {
+// --csv / --json print every measurement in machine-readable form instead of the tables
+int main(int argc, char* argv[]) {
+  const auto format = microbench::formatFromArgs(argc, argv);
   BenchmarkHarness harness;
   const auto results = harness.runAll();
+  if (format != microbench::Format::Table) {
+    std::vector<microbench::Summary> summaries;
+    for (const auto& row : results) {
+      summaries.insert(summaries.end(), {row.lockBased, row.lockFree, row.elimination, row.flatCombining});
+      summaries.insert(summaries.end(), row.lockSweep.begin(), row.lockSweep.end());
+    }
+    microbench::write(std::cout, summaries, format);
+    return 0;
+  }
   BenchmarkHarness::printTable(results);
   BenchmarkHarness::printInsights(results);
+  BenchmarkHarness::printLockSweep(results);
+  BenchmarkHarness::printContention(results);
   std::cout << "\nBenchmarking complete." << std::endl;
   return 0;
 }
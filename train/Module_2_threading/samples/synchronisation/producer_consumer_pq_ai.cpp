@@ -15,23 +15,35 @@ Implement graceful shutdown that processes all remaining tasks
 
 Test the system under various load conditions and priority distributions.
 */
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <cstddef>
 #include <cstdint>
 #include <iomanip>
 #include <iostream>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <queue>
 #include <random>
 #include <sstream>
 #include <stop_token>
 #include <string>
+#include <string_view>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
+#include "FlatCombining.h"
+#include "LatencyHistogram.h"
+#include "MicroBenchmark.h"
+#include "MultiQueue.h"
+#include "SchedulingPolicy.h"
+#include "SpinLocks.h"
+
 using namespace std::chrono_literals;
 
 enum class Priority { LOW = 1, NORMAL = 2, HIGH = 3, CRITICAL = 4 };
@@ -41,9 +53,18 @@ struct Task {
   Priority priority;
   std::string payload;
   std::chrono::steady_clock::time_point timestamp;
+  std::chrono::steady_clock::time_point deadline;  // must be processed by then
+
+  Task(int id, Priority p, std::string data, std::chrono::milliseconds budget)
+      : id(id),
+        priority(p),
+        payload(std::move(data)),
+        timestamp(std::chrono::steady_clock::now()),
+        deadline(timestamp + budget) {}
 
+  // Deadline from the class's default budget
   Task(int id, Priority p, std::string data)
-      : id(id), priority(p), payload(std::move(data)), timestamp(std::chrono::steady_clock::now()) {}
+      : Task(id, p, std::move(data), scheduling::kDefaultBudgets[static_cast<std::size_t>(p) - 1]) {}
 };
 
 struct TaskComparator {
@@ -55,67 +76,458 @@ struct TaskComparator {
   }
 };
 
-class PriorityTaskQueue {
+using TaskHeap = std::priority_queue<Task, std::vector<Task>, TaskComparator>;
+
+// Latency accounting shared by every queue backend. Besides the overall average wait it keeps, per priority, a
+// histogram of task queue wait (push to pop, from Task::timestamp) and, per consumer class (the consumer's minimum
+// priority), a histogram of consumer idle time inside pop, so tail latency of one priority is not averaged away by
+// the others.
+class ConsumerWaitStats {
  private:
-  mutable std::mutex mutex_;
-  std::priority_queue<Task, std::vector<Task>, TaskComparator> queue_;
-  std::condition_variable condition_;
-  std::atomic<bool> shutdown_{false};
+  static constexpr std::size_t kPriorities = 4;
+
   std::atomic<int> waitingConsumers_{0};
   std::atomic<std::uint64_t> totalWaitNanos_{0};
   std::atomic<std::uint64_t> waitSamples_{0};
+  std::array<metrics::LatencyHistogram, kPriorities> sojourn_;
+  std::array<metrics::LatencyHistogram, kPriorities> idle_;
+
+  static std::size_t slot(Priority priority) { return static_cast<std::size_t>(priority) - 1; }
+
+ public:
+  void beginWait() { waitingConsumers_.fetch_add(1, std::memory_order_relaxed); }
 
-  void recordWaitDuration(std::chrono::steady_clock::time_point start) {
+  void endWait(std::chrono::steady_clock::time_point start, Priority minPriority) {
+    waitingConsumers_.fetch_sub(1, std::memory_order_relaxed);
     const auto waited = std::chrono::steady_clock::now() - start;
+    idle_[slot(minPriority)].record(waited);
     const auto nanos = static_cast<std::uint64_t>(
         std::chrono::duration_cast<std::chrono::nanoseconds>(waited).count());
     totalWaitNanos_.fetch_add(nanos, std::memory_order_relaxed);
     waitSamples_.fetch_add(1, std::memory_order_relaxed);
   }
 
+  int waitingConsumers() const { return waitingConsumers_.load(std::memory_order_relaxed); }
+
+  double averageWaitMillis() const {
+    const auto samples = waitSamples_.load(std::memory_order_relaxed);
+    if (samples == 0) {
+      return 0.0;
+    }
+    const auto nanos = totalWaitNanos_.load(std::memory_order_relaxed);
+    return static_cast<double>(nanos) / 1'000'000.0 / static_cast<double>(samples);
+  }
+
+  // `now` lets pop_batch read the clock once for the whole batch
+  void recordSojourn(const Task& task, std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now()) {
+    sojourn_[slot(task.priority)].record(now - task.timestamp);
+  }
+
+  metrics::LatencyHistogram::Snapshot sojourn(Priority priority) const { return sojourn_[slot(priority)].snapshot(); }
+
+  metrics::LatencyHistogram::Snapshot idle(Priority minPriority) const { return idle_[slot(minPriority)].snapshot(); }
+};
+
+// Wakeup accounting for the condition-variable queue. A wakeup is futile when a push notified the consumer but
+// nothing it may take was there (another class's task, or someone else got there first), and spurious when no push
+// notified it at all.
+struct WakeupStats {
+  std::uint64_t notified{0};
+  std::uint64_t futile{0};
+  std::uint64_t spurious{0};
+};
+
+// Mutex may be any Lockable from SpinLocks.h; anything but std::mutex waits on std::condition_variable_any. Policy
+// (SchedulingPolicy.h) orders the tasks: strict priority, earliest deadline first or weighted-fair across classes.
+//
+// Consumers sleep on the wait list of their minimum priority, so a push of priority p notifies one consumer that can
+// take it: the most selective class at or below p that has a sleeper not already notified. Urgent-only consumers are
+// never woken for LOW tasks, and a LOW push never spends its single notify on one of them. PerPriorityWakeups = false
+// keeps the original single wait list (every class shares one condition variable) for comparison.
+template <typename Mutex = std::mutex, bool PerPriorityWakeups = true, typename Policy = scheduling::StrictPriority>
+class PriorityTaskQueue {
+ private:
+  using Condition = std::conditional_t<std::is_same_v<Mutex, std::mutex>, std::condition_variable,
+                                       std::condition_variable_any>;
+
+  static constexpr std::size_t kClasses = 4;
+
+  // One wait list: its condition, who sleeps on it and how many of them a push has already notified
+  struct WaitList {
+    Condition condition;
+    int sleepers{0};
+    int notifications{0};
+  };
+
+  mutable Mutex mutex_;
+  scheduling::ClassQueues<Task, Policy> queue_;
+  std::array<WaitList, PerPriorityWakeups ? kClasses : 1> waitLists_;
+  std::atomic<bool> shutdown_{false};
+  ConsumerWaitStats waitStats_;
+  std::atomic<std::uint64_t> notifiedWakeups_{0};
+  std::atomic<std::uint64_t> futileWakeups_{0};
+  std::atomic<std::uint64_t> spuriousWakeups_{0};
+
+  static std::size_t classOf(Priority priority) { return static_cast<std::size_t>(priority) - 1; }
+
+  static std::size_t listIndex(Priority priority) { return PerPriorityWakeups ? classOf(priority) : 0; }
+
+  bool eligibleTop(Priority minPriority) const { return queue_.next(classOf(minPriority)) != queue_.kNone; }
+
+  // Called with mutex_ held, so sleepers and notifications cannot change underneath
+  void notifyEligible(Priority priority) {
+    for (std::size_t idx = listIndex(priority) + 1; idx-- > 0;) {
+      WaitList& list = waitLists_[idx];
+      if (list.sleepers > list.notifications) {
+        ++list.notifications;
+        list.condition.notify_one();
+        return;
+      }
+    }
+  }
+
+  // Lock held throughout (except while asleep). True once an eligible task is on top; false on shutdown or timeout.
+  bool awaitEligible(std::unique_lock<Mutex>& lock, Priority minPriority,
+                     std::chrono::steady_clock::time_point deadline) {
+    WaitList& list = waitLists_[listIndex(minPriority)];
+    while (true) {
+      if (eligibleTop(minPriority)) {
+        return true;
+      }
+      if (shutdown_.load(std::memory_order_relaxed)) {
+        return false;
+      }
+
+      ++list.sleepers;
+      const bool timedOut = list.condition.wait_until(lock, deadline) == std::cv_status::timeout;
+      --list.sleepers;
+      // Whoever wakes first claims a pending notification, so the counts stay right whichever sleeper got it
+      const bool notified = list.notifications > 0;
+      if (notified) {
+        --list.notifications;
+        notifiedWakeups_.fetch_add(1, std::memory_order_relaxed);
+      }
+      if (eligibleTop(minPriority) || shutdown_.load(std::memory_order_relaxed)) {
+        continue;
+      }
+      if (notified) {
+        futileWakeups_.fetch_add(1, std::memory_order_relaxed);
+      } else if (!timedOut) {
+        spuriousWakeups_.fetch_add(1, std::memory_order_relaxed);
+      }
+      if (timedOut || std::chrono::steady_clock::now() >= deadline) {
+        return false;
+      }
+    }
+  }
+
+  // The task the policy runs next among those this consumer may take; call only when eligibleTop(minPriority)
+  Task takeTop(Priority minPriority) { return queue_.take(queue_.next(classOf(minPriority))); }
+
+  // The notify for what we took may have been meant for another task (e.g. we took a HIGH task after a LOW push woke
+  // us): pass it on, so a sleeper that can take the most urgent remaining task is not left asleep
+  void passWakeupOn() {
+    if (PerPriorityWakeups && !queue_.empty()) {
+      notifyEligible(static_cast<Priority>(queue_.highestNonEmpty() + 1));
+    }
+  }
+
  public:
   void push(const Task& task) {
-    {
-      std::lock_guard<std::mutex> lock(mutex_);
-      queue_.push(task);
-    }
-    condition_.notify_one();
+    std::lock_guard<Mutex> lock(mutex_);
+    queue_.push(classOf(task.priority), task.deadline, task);
+    notifyEligible(task.priority);
   }
 
   bool pop(Task& task, Priority minPriority = Priority::LOW,
            std::chrono::milliseconds timeout = std::chrono::milliseconds(1000)) {
     const auto startWait = std::chrono::steady_clock::now();
-    waitingConsumers_.fetch_add(1, std::memory_order_relaxed);
-    std::unique_lock<std::mutex> lock(mutex_);
-    const auto predicate = [this, minPriority]() {
-      if (shutdown_.load(std::memory_order_relaxed)) {
+    waitStats_.beginWait();
+    std::unique_lock<Mutex> lock(mutex_);
+    const bool ready = awaitEligible(lock, minPriority, startWait + timeout);
+    if (ready) {
+      task = takeTop(minPriority);
+      passWakeupOn();
+    }
+    lock.unlock();
+    if (ready) {
+      waitStats_.recordSojourn(task);
+    }
+    waitStats_.endWait(startWait, minPriority);
+    return ready;
+  }
+
+  // Waits like pop(), then moves up to maxTasks eligible tasks into `out` in priority order under the one lock
+  // acquisition. Returns how many it appended (0 on timeout or shutdown).
+  std::size_t pop_batch(std::vector<Task>& out, std::size_t maxTasks, Priority minPriority = Priority::LOW,
+                        std::chrono::milliseconds timeout = std::chrono::milliseconds(1000)) {
+    const auto startWait = std::chrono::steady_clock::now();
+    waitStats_.beginWait();
+    std::unique_lock<Mutex> lock(mutex_);
+    std::size_t taken = 0;
+    if (awaitEligible(lock, minPriority, startWait + timeout)) {
+      do {
+        out.push_back(takeTop(minPriority));
+        ++taken;
+      } while (taken < maxTasks && eligibleTop(minPriority));
+      passWakeupOn();
+    }
+    lock.unlock();
+    const auto now = std::chrono::steady_clock::now();
+    for (auto it = out.end() - static_cast<std::ptrdiff_t>(taken); it != out.end(); ++it) {
+      waitStats_.recordSojourn(*it, now);
+    }
+    waitStats_.endWait(startWait, minPriority);
+    return taken;
+  }
+
+  void shutdown() {
+    shutdown_.store(true, std::memory_order_relaxed);
+    std::lock_guard<Mutex> lock(mutex_);
+    for (WaitList& list : waitLists_) {
+      list.condition.notify_all();
+    }
+  }
+
+  size_t size() const {
+    std::lock_guard<Mutex> lock(mutex_);
+    return queue_.size();
+  }
+
+  int getWaitingConsumers() const { return waitStats_.waitingConsumers(); }
+
+  bool isShutdown() const { return shutdown_.load(std::memory_order_relaxed); }
+
+  double averageWaitMillis() const { return waitStats_.averageWaitMillis(); }
+
+  const ConsumerWaitStats& waitStats() const { return waitStats_; }
+
+  WakeupStats wakeupStats() const {
+    return WakeupStats{notifiedWakeups_.load(std::memory_order_relaxed), futileWakeups_.load(std::memory_order_relaxed),
+                       spuriousWakeups_.load(std::memory_order_relaxed)};
+  }
+};
+
+// Event count for the queues whose push path takes no mutex: consumers that found nothing eligible sleep until a push
+// lands after the epoch they sampled, and producers only touch the mutex when someone is actually asleep.
+//
+// Consumers sleep on the wait list of their minimum priority, as in PriorityTaskQueue: a push of priority p notifies
+// one sleeper of the most selective class at or below p that has not been notified yet, so a LOW push never spends
+// its notify on an urgent-only consumer that cannot take the task.
+class PushWakeups {
+ private:
+  static constexpr std::size_t kClasses = 4;
+
+  struct WaitList {
+    std::condition_variable condition;
+    int sleepers{0};
+    int notifications{0};
+  };
+
+  std::atomic<std::uint64_t> pushes_{0};
+  std::atomic<int> sleepers_{0};  // all classes; lets notifyPush skip the mutex
+  std::mutex sleepMutex_;
+  std::array<WaitList, kClasses> waitLists_;
+
+  static std::size_t classOf(Priority priority) { return static_cast<std::size_t>(priority) - 1; }
+
+  // Called with sleepMutex_ held; visits the classes from `first` in the given direction
+  bool notifyOne(std::size_t first, bool towardsLow) {
+    for (std::size_t step = 0; step < kClasses; ++step) {
+      const std::size_t idx = towardsLow ? first - step : first + step;
+      if (idx >= kClasses) {
+        break;
+      }
+      WaitList& list = waitLists_[idx];
+      if (list.sleepers > list.notifications) {
+        ++list.notifications;
+        list.condition.notify_one();
         return true;
       }
-      if (queue_.empty()) {
+    }
+    return false;
+  }
+
+ public:
+  // Sample before looking at the queue
+  std::uint64_t epoch() const { return pushes_.load(std::memory_order_seq_cst); }
+
+  void notifyPush(Priority priority) {
+    pushes_.fetch_add(1, std::memory_order_seq_cst);
+    if (sleepers_.load(std::memory_order_seq_cst) > 0) {
+      std::lock_guard<std::mutex> lock(sleepMutex_);
+      notifyOne(classOf(priority), true);
+    }
+  }
+
+  // A consumer that took a task while more are queued may have used up the notify meant for one of them: wake the
+  // least selective sleeper, which can take whatever is left
+  void passOn() {
+    if (sleepers_.load(std::memory_order_seq_cst) > 0) {
+      std::lock_guard<std::mutex> lock(sleepMutex_);
+      notifyOne(0, false);
+    }
+  }
+
+  // False on timeout; the seq_cst pair pushes_/sleepers_ makes the check race-free
+  bool sleepUntilPushAfter(std::uint64_t seen, std::chrono::steady_clock::time_point deadline,
+                           const std::atomic<bool>& shutdown, Priority minPriority) {
+    WaitList& list = waitLists_[classOf(minPriority)];
+    std::unique_lock<std::mutex> lock(sleepMutex_);
+    sleepers_.fetch_add(1, std::memory_order_seq_cst);
+    ++list.sleepers;
+    const bool woken = list.condition.wait_until(lock, deadline, [&] {
+      return pushes_.load(std::memory_order_seq_cst) != seen || shutdown.load(std::memory_order_relaxed);
+    });
+    --list.sleepers;
+    // Whoever wakes first claims a pending notification, so the counts stay right whichever sleeper got it
+    if (list.notifications > 0) {
+      --list.notifications;
+    }
+    sleepers_.fetch_sub(1, std::memory_order_relaxed);
+    return woken;
+  }
+
+  void notifyAll() {
+    std::lock_guard<std::mutex> lock(sleepMutex_);
+    for (WaitList& list : waitLists_) {
+      list.condition.notify_all();
+    }
+  }
+};
+
+// Same interface, but the heap sits behind a flat combiner instead of a mutex: concurrent pushes and pops are
+// executed in batches by whichever thread holds the combiner lock. Consumers that find nothing eligible sleep on a
+// PushWakeups event count, on the wait list of their minimum priority.
+class FlatCombiningPriorityTaskQueue {
+ private:
+  combining::FlatCombiner<TaskHeap> heap_;
+  std::atomic<std::size_t> size_{0};  // written by the combiner only
+  PushWakeups wakeups_;
+  std::atomic<bool> shutdown_{false};
+  ConsumerWaitStats waitStats_;
+
+  bool tryPop(Task& task, Priority minPriority) {
+    return heap_.apply([&](TaskHeap& heap) {
+      if (heap.empty() || static_cast<int>(heap.top().priority) < static_cast<int>(minPriority)) {
         return false;
       }
-      return static_cast<int>(queue_.top().priority) >= static_cast<int>(minPriority);
-    };
+      task = std::move(const_cast<Task&>(heap.top()));
+      heap.pop();
+      size_.store(heap.size(), std::memory_order_relaxed);
+      return true;
+    });
+  }
+
+ public:
+  void push(const Task& task) {
+    heap_.apply([&](TaskHeap& heap) {
+      heap.push(task);
+      size_.store(heap.size(), std::memory_order_relaxed);
+    });
+    wakeups_.notifyPush(task.priority);
+  }
 
+  bool pop(Task& task, Priority minPriority = Priority::LOW,
+           std::chrono::milliseconds timeout = std::chrono::milliseconds(1000)) {
+    const auto startWait = std::chrono::steady_clock::now();
+    const auto deadline = startWait + timeout;
+    waitStats_.beginWait();
     while (true) {
-      if (!condition_.wait_for(lock, timeout, predicate)) {
-        waitingConsumers_.fetch_sub(1, std::memory_order_relaxed);
-        recordWaitDuration(startWait);
+      const std::uint64_t seen = wakeups_.epoch();
+      if (tryPop(task, minPriority)) {
+        if (size_.load(std::memory_order_relaxed) > 0) {
+          wakeups_.passOn();
+        }
+        waitStats_.recordSojourn(task);
+        waitStats_.endWait(startWait, minPriority);
+        return true;
+      }
+      // Nothing eligible: after shutdown no push can change that, and the timeout holds even when the sleep below
+      // returns early without an eligible push
+      if (shutdown_.load(std::memory_order_relaxed) || std::chrono::steady_clock::now() >= deadline) {
+        waitStats_.endWait(startWait, minPriority);
+        return false;
+      }
+      if (!wakeups_.sleepUntilPushAfter(seen, deadline, shutdown_, minPriority)) {
+        waitStats_.endWait(startWait, minPriority);
         return false;
       }
+    }
+  }
+
+  void shutdown() {
+    shutdown_.store(true, std::memory_order_relaxed);
+    wakeups_.notifyAll();
+  }
+
+  size_t size() const { return size_.load(std::memory_order_relaxed); }
+
+  int getWaitingConsumers() const { return waitStats_.waitingConsumers(); }
 
-      if (!queue_.empty() &&
-          static_cast<int>(queue_.top().priority) >= static_cast<int>(minPriority)) {
-        task = queue_.top();
-        queue_.pop();
-        waitingConsumers_.fetch_sub(1, std::memory_order_relaxed);
-        recordWaitDuration(startWait);
+  bool isShutdown() const { return shutdown_.load(std::memory_order_relaxed); }
+
+  double averageWaitMillis() const { return waitStats_.averageWaitMillis(); }
+
+  const ConsumerWaitStats& waitStats() const { return waitStats_; }
+};
+
+// Relaxed backend: the tasks are spread over LanesPerThread * P MultiQueue lanes, P being the hardware threads but at
+// least 4 (the simulations oversubscribe small machines), so producers and consumers rarely share a lock. A pop
+// returns a task near the top rather than the top: more lanes mean less contention and more priority inversions, more
+// Candidates the reverse. Sleeping works as in the flat-combining queue.
+template <std::size_t LanesPerThread = 2, std::size_t Candidates = 2>
+class MultiQueuePriorityTaskQueue {
+ private:
+  // Priority in the top byte, then the inverted timestamp so that older tasks of equal priority rank higher
+  struct TaskKey {
+    static constexpr std::uint64_t kStampMask = (std::uint64_t{1} << 56) - 1;
+
+    std::uint64_t operator()(const Task& task) const {
+      const auto stamp = static_cast<std::uint64_t>(task.timestamp.time_since_epoch().count());
+      return (static_cast<std::uint64_t>(task.priority) << 56) | (kStampMask - (stamp & kStampMask));
+    }
+  };
+
+  static constexpr std::uint64_t minKey(Priority minPriority) {
+    return static_cast<std::uint64_t>(minPriority) << 56;
+  }
+
+  relaxed::MultiQueue<Task, TaskKey> tasks_{
+      LanesPerThread * std::max<std::size_t>(std::thread::hardware_concurrency(), 4), Candidates};
+  PushWakeups wakeups_;
+  std::atomic<bool> shutdown_{false};
+  ConsumerWaitStats waitStats_;
+
+ public:
+  void push(const Task& task) {
+    tasks_.push(task);
+    wakeups_.notifyPush(task.priority);
+  }
+
+  bool pop(Task& task, Priority minPriority = Priority::LOW,
+           std::chrono::milliseconds timeout = std::chrono::milliseconds(1000)) {
+    const auto startWait = std::chrono::steady_clock::now();
+    const auto deadline = startWait + timeout;
+    waitStats_.beginWait();
+    while (true) {
+      const std::uint64_t seen = wakeups_.epoch();
+      if (tasks_.tryPop(task, minKey(minPriority))) {
+        if (!tasks_.empty()) {
+          wakeups_.passOn();
+        }
+        waitStats_.recordSojourn(task);
+        waitStats_.endWait(startWait, minPriority);
         return true;
       }
-
-      if (shutdown_.load(std::memory_order_relaxed) && queue_.empty()) {
-        waitingConsumers_.fetch_sub(1, std::memory_order_relaxed);
-        recordWaitDuration(startWait);
+      // Nothing eligible: after shutdown no push can change that, and the timeout holds even when the sleep below
+      // returns early without an eligible push
+      if (shutdown_.load(std::memory_order_relaxed) || std::chrono::steady_clock::now() >= deadline) {
+        waitStats_.endWait(startWait, minPriority);
+        return false;
+      }
+      if (!wakeups_.sleepUntilPushAfter(seen, deadline, shutdown_, minPriority)) {
+        waitStats_.endWait(startWait, minPriority);
         return false;
       }
     }
@@ -123,35 +535,66 @@ class PriorityTaskQueue {
 
   void shutdown() {
     shutdown_.store(true, std::memory_order_relaxed);
-    condition_.notify_all();
+    wakeups_.notifyAll();
   }
 
-  size_t size() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return queue_.size();
-  }
+  size_t size() const { return tasks_.size(); }
 
-  int getWaitingConsumers() const { return waitingConsumers_.load(std::memory_order_relaxed); }
+  int getWaitingConsumers() const { return waitStats_.waitingConsumers(); }
 
   bool isShutdown() const { return shutdown_.load(std::memory_order_relaxed); }
 
-  double averageWaitMillis() const {
-    const auto samples = waitSamples_.load(std::memory_order_relaxed);
-    if (samples == 0) {
-      return 0.0;
+  double averageWaitMillis() const { return waitStats_.averageWaitMillis(); }
+
+  const ConsumerWaitStats& waitStats() const { return waitStats_; }
+};
+
+// Tasks queued per priority, maintained around the queue, so any backend can be checked for priority inversions: a
+// pop is an inversion when a strictly more urgent task was still queued. Producers count after the push completes, so
+// a racing pop can only miss an inversion, never invent one; the strict queue therefore reports (close to) zero.
+class PriorityCensus {
+ private:
+  std::array<std::atomic<int>, 4> queued_{};
+  std::atomic<int> pops_{0};
+  std::atomic<int> inversions_{0};
+
+  static std::size_t slot(Priority priority) { return static_cast<std::size_t>(priority) - 1; }
+
+ public:
+  void onPushed(Priority priority) { queued_[slot(priority)].fetch_add(1, std::memory_order_relaxed); }
+
+  void onPopped(Priority priority) {
+    queued_[slot(priority)].fetch_sub(1, std::memory_order_relaxed);
+    pops_.fetch_add(1, std::memory_order_relaxed);
+    for (std::size_t higher = slot(priority) + 1; higher < queued_.size(); ++higher) {
+      if (queued_[higher].load(std::memory_order_relaxed) > 0) {
+        inversions_.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
     }
-    const auto nanos = totalWaitNanos_.load(std::memory_order_relaxed);
-    return static_cast<double>(nanos) / 1'000'000.0 / static_cast<double>(samples);
+  }
+
+  double inversionRate() const {
+    const int pops = pops_.load(std::memory_order_relaxed);
+    return pops == 0 ? 0.0 : static_cast<double>(inversions_.load(std::memory_order_relaxed)) / pops;
   }
 };
 
+// Push-to-processed latency per priority (indexed by priority - 1), shared by all processors of a simulation
+using LatencyByPriority = std::array<metrics::LatencyHistogram, 4>;
+
 class TaskProcessor {
  private:
   int processorId_;
+  LatencyByPriority& endToEnd_;
   std::atomic<int> processedTasks_{0};
+  std::array<std::atomic<int>, 4> completedByPriority_{};
+  std::array<std::atomic<int>, 4> missedByPriority_{};  // finished after Task::deadline
+
+  static std::size_t slot(Priority priority) { return static_cast<std::size_t>(priority) - 1; }
 
  public:
-  explicit TaskProcessor(int id) : processorId_(id) {}
+  TaskProcessor(int id, LatencyByPriority& endToEnd) : processorId_(id), endToEnd_(endToEnd) {}
 
   void processTask(const Task& task) {
     const auto processingTime = std::chrono::milliseconds(50 + static_cast<int>(task.priority) * 25);
@@ -161,9 +604,23 @@ class TaskProcessor {
 
     std::this_thread::sleep_for(processingTime);
     processedTasks_.fetch_add(1, std::memory_order_relaxed);
+    completedByPriority_[slot(task.priority)].fetch_add(1, std::memory_order_relaxed);
+    const auto now = std::chrono::steady_clock::now();
+    endToEnd_[slot(task.priority)].record(now - task.timestamp);
+    if (now > task.deadline) {
+      missedByPriority_[slot(task.priority)].fetch_add(1, std::memory_order_relaxed);
+    }
   }
 
   int getProcessedCount() const { return processedTasks_.load(std::memory_order_relaxed); }
+
+  int getCompletedCount(Priority priority) const {
+    return completedByPriority_[slot(priority)].load(std::memory_order_relaxed);
+  }
+
+  int getMissedCount(Priority priority) const {
+    return missedByPriority_[slot(priority)].load(std::memory_order_relaxed);
+  }
 };
 
 struct ProducerProfile {
@@ -171,6 +628,7 @@ struct ProducerProfile {
   std::chrono::milliseconds minDelay;
   std::chrono::milliseconds maxDelay;
   std::array<int, 4> priorityWeights;
+  std::array<std::chrono::milliseconds, 4> deadlineBudgets{scheduling::kDefaultBudgets};  // push to processed
 };
 
 struct SimulationProfile {
@@ -181,6 +639,7 @@ struct SimulationProfile {
   Priority urgentThreshold{Priority::HIGH};
   std::chrono::milliseconds duration{0ms};
   std::chrono::milliseconds monitorInterval{500ms};
+  std::chrono::milliseconds criticalSlo{300ms};  // bound on CRITICAL p99 end-to-end latency (push to processed)
 };
 
 Priority pickPriority(const ProducerProfile& profile, std::mt19937& rng) {
@@ -188,8 +647,9 @@ Priority pickPriority(const ProducerProfile& profile, std::mt19937& rng) {
   return static_cast<Priority>(dist(rng) + 1);
 }
 
-void runProducer(std::stop_token stopToken, PriorityTaskQueue& queue, const ProducerProfile& profile,
-                 std::atomic<int>& nextTaskId, std::atomic<int>& producedCount) {
+template <typename Queue>
+void runProducer(std::stop_token stopToken, Queue& queue, const ProducerProfile& profile,
+                 std::atomic<int>& nextTaskId, std::atomic<int>& producedCount, PriorityCensus& census) {
   std::mt19937 rng(std::random_device{}());
   std::uniform_int_distribution<int> delayDist(static_cast<int>(profile.minDelay.count()),
                                                static_cast<int>(profile.maxDelay.count()));
@@ -201,18 +661,53 @@ void runProducer(std::stop_token stopToken, PriorityTaskQueue& queue, const Prod
     std::ostringstream payload;
     payload << profile.name << "-task-" << id;
 
-    queue.push(Task{id, priority, payload.str()});
+    queue.push(Task{id, priority, payload.str(), profile.deadlineBudgets[static_cast<std::size_t>(priority) - 1]});
+    census.onPushed(priority);
     producedCount.fetch_add(1, std::memory_order_relaxed);
     std::this_thread::sleep_for(std::chrono::milliseconds(delayDist(rng)));
   }
 }
 
-void consumerLoop(std::stop_token stopToken, PriorityTaskQueue& queue, TaskProcessor& processor,
-                  Priority minPriority) {
-  Task placeholder{0, Priority::LOW, ""};
+// Consumer-side batch size for pop_batch: doubles while batches come back full (a backlog is building), halves when
+// they come back short. At low load a consumer therefore takes one task at a time and no task sits in another
+// consumer's batch while an idle consumer could have started it. Only worth it when a task costs about as much as the
+// lock round trip it saves (the --bench pump); consumerLoop's tasks run for 75-150 ms, so it pops one at a time.
+class AdaptiveBatch {
+ private:
+  std::size_t current_{1};
+  std::size_t max_;
+
+ public:
+  explicit AdaptiveBatch(std::size_t max = 32) : max_(std::max<std::size_t>(max, 1)) {}
+
+  std::size_t next() const { return current_; }
+
+  void record(std::size_t taken) {
+    if (taken >= current_) {
+      current_ = std::min(current_ * 2, max_);
+    } else if (taken > 0) {
+      current_ = std::max<std::size_t>(current_ / 2, 1);
+    }
+  }
+};
+
+template <typename Queue>
+void consumerLoop(std::stop_token stopToken, Queue& queue, TaskProcessor& processor, Priority minPriority,
+                  PriorityCensus& census) {
+  // One task per pop: a popped task is hidden from the other consumers and from priority ordering until it is
+  // processed, and each one takes far longer than the lock round trip a batch would save
+  Task task{0, Priority::LOW, ""};
+  const auto serveOnce = [&](std::chrono::milliseconds timeout) {
+    if (!queue.pop(task, minPriority, timeout)) {
+      return false;
+    }
+    census.onPopped(task.priority);
+    processor.processTask(task);
+    return true;
+  };
+
   while (!stopToken.stop_requested()) {
-    if (queue.pop(placeholder, minPriority, 750ms)) {
-      processor.processTask(placeholder);
+    if (serveOnce(750ms)) {
       continue;
     }
 
@@ -221,8 +716,7 @@ void consumerLoop(std::stop_token stopToken, PriorityTaskQueue& queue, TaskProce
     }
   }
 
-  while (queue.pop(placeholder, minPriority, 100ms)) {
-    processor.processTask(placeholder);
+  while (serveOnce(100ms)) {
   }
 }
 
@@ -232,11 +726,42 @@ std::string formatMillis(double value) {
   return stream.str();
 }
 
-void monitorQueue(const PriorityTaskQueue& queue, std::stop_token stopToken,
-                  std::chrono::milliseconds interval) {
+constexpr std::array<std::string_view, 4> kPriorityNames{"LOW", "NORMAL", "HIGH", "CRITICAL"};
+
+std::string_view priorityName(Priority priority) { return kPriorityNames[static_cast<std::size_t>(priority) - 1]; }
+
+double toMillis(std::chrono::nanoseconds value) { return std::chrono::duration<double, std::milli>(value).count(); }
+
+// "p50/p99/max" in milliseconds
+std::string formatLatency(const metrics::LatencyHistogram::Snapshot& latency) {
+  return formatMillis(toMillis(latency.p50)) + "/" + formatMillis(toMillis(latency.p99)) + "/" +
+         formatMillis(toMillis(latency.max));
+}
+
+// One "NAME p50/p99/max" entry per priority that has samples
+template <typename SnapshotOf>
+std::string formatLatencies(SnapshotOf&& snapshotOf) {
+  std::string line;
+  for (int level = 1; level <= 4; ++level) {
+    const auto priority = static_cast<Priority>(level);
+    if (const auto latency = snapshotOf(priority); latency.count > 0) {
+      line += " ";
+      line += priorityName(priority);
+      line += " " + formatLatency(latency);
+    }
+  }
+  return line.empty() ? " -" : line;
+}
+
+template <typename Queue>
+void monitorQueue(const Queue& queue, std::stop_token stopToken, std::chrono::milliseconds interval) {
+  const ConsumerWaitStats& stats = queue.waitStats();
   while (!stopToken.stop_requested()) {
     std::cout << "[Monitor] pending=" << queue.size() << " waitingConsumers=" << queue.getWaitingConsumers()
-              << " avgWaitMs=" << formatMillis(queue.averageWaitMillis()) << std::endl;
+              << " avgWaitMs=" << formatMillis(queue.averageWaitMillis()) << "\n[Monitor] queue wait ms p50/p99/max:"
+              << formatLatencies([&](Priority priority) { return stats.sojourn(priority); })
+              << "\n[Monitor] consumer idle ms p50/p99/max by class:"
+              << formatLatencies([&](Priority priority) { return stats.idle(priority); }) << std::endl;
     std::this_thread::sleep_for(interval);
   }
 }
@@ -245,25 +770,37 @@ struct SimulationSummary {
   int produced{0};
   std::vector<int> processedPerConsumer;
   double averageWaitMs{0.0};
+  double tasksPerSecond{0.0};  // processed tasks over the whole run, drain included
+  double inversionRate{0.0};
+  std::optional<WakeupStats> wakeups;  // condition-variable backends only
+  std::array<metrics::LatencyHistogram::Snapshot, 4> queueWait{};  // push to pop, indexed by priority - 1
+  std::array<metrics::LatencyHistogram::Snapshot, 4> endToEnd{};   // push to processed
+  bool criticalSloMet{true};
+  std::array<double, 4> deadlineMissRate{};  // indexed by priority - 1
+  double overallMissRate{0.0};
 };
 
+template <typename Queue>
 SimulationSummary runSimulation(const SimulationProfile& profile) {
   std::cout << "\n=== Scenario: " << profile.label << " ===" << std::endl;
 
-  PriorityTaskQueue queue;
+  Queue queue;
   std::atomic<int> nextTaskId{0};
   std::atomic<int> producedCount{0};
+  PriorityCensus census;
+  const auto start = std::chrono::steady_clock::now();
 
   std::vector<std::jthread> producers;
   producers.reserve(profile.producerProfiles.size());
 
   for (const auto& producerProfile : profile.producerProfiles) {
-    producers.emplace_back([&queue, &nextTaskId, &producedCount, producerProfile](std::stop_token token) {
-      runProducer(token, queue, producerProfile, nextTaskId, producedCount);
+    producers.emplace_back([&queue, &nextTaskId, &producedCount, &census, producerProfile](std::stop_token token) {
+      runProducer(token, queue, producerProfile, nextTaskId, producedCount, census);
     });
   }
 
   const int totalConsumers = profile.generalConsumers + profile.urgentOnlyConsumers;
+  LatencyByPriority endToEnd;
   std::vector<std::unique_ptr<TaskProcessor>> processors;
   processors.reserve(totalConsumers);
   std::vector<std::jthread> consumers;
@@ -271,19 +808,20 @@ SimulationSummary runSimulation(const SimulationProfile& profile) {
 
   int processorId = 1;
   for (int idx = 0; idx < profile.generalConsumers; ++idx) {
-    processors.emplace_back(std::make_unique<TaskProcessor>(processorId++));
+    processors.emplace_back(std::make_unique<TaskProcessor>(processorId++, endToEnd));
     auto* processorPtr = processors.back().get();
-    consumers.emplace_back([&queue, processorPtr](std::stop_token token) {
-      consumerLoop(token, queue, *processorPtr, Priority::LOW);
+    consumers.emplace_back([&queue, &census, processorPtr](std::stop_token token) {
+      consumerLoop(token, queue, *processorPtr, Priority::LOW, census);
     });
   }
 
   for (int idx = 0; idx < profile.urgentOnlyConsumers; ++idx) {
-    processors.emplace_back(std::make_unique<TaskProcessor>(processorId++));
+    processors.emplace_back(std::make_unique<TaskProcessor>(processorId++, endToEnd));
     auto* processorPtr = processors.back().get();
-    consumers.emplace_back([&queue, processorPtr, threshold = profile.urgentThreshold](std::stop_token token) {
-      consumerLoop(token, queue, *processorPtr, threshold);
-    });
+    consumers.emplace_back(
+        [&queue, &census, processorPtr, threshold = profile.urgentThreshold](std::stop_token token) {
+          consumerLoop(token, queue, *processorPtr, threshold, census);
+        });
   }
 
   std::jthread monitorThread([&queue, interval = profile.monitorInterval](std::stop_token token) {
@@ -305,16 +843,47 @@ SimulationSummary runSimulation(const SimulationProfile& profile) {
   for (auto& consumer : consumers) {
     consumer.request_stop();
   }
+  for (auto& consumer : consumers) {
+    consumer.join();
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
 
   monitorThread.request_stop();
 
   SimulationSummary summary;
   summary.produced = producedCount.load(std::memory_order_relaxed);
   summary.processedPerConsumer.reserve(processors.size());
+  int processed = 0;
   for (const auto& processor : processors) {
     summary.processedPerConsumer.push_back(processor->getProcessedCount());
+    processed += summary.processedPerConsumer.back();
   }
+  int missed = 0;
+  for (int level = 1; level <= 4; ++level) {
+    const auto priority = static_cast<Priority>(level);
+    int completedAtLevel = 0;
+    int missedAtLevel = 0;
+    for (const auto& processor : processors) {
+      completedAtLevel += processor->getCompletedCount(priority);
+      missedAtLevel += processor->getMissedCount(priority);
+    }
+    summary.deadlineMissRate[level - 1] =
+        completedAtLevel == 0 ? 0.0 : static_cast<double>(missedAtLevel) / completedAtLevel;
+    missed += missedAtLevel;
+  }
+  summary.overallMissRate = processed == 0 ? 0.0 : static_cast<double>(missed) / processed;
   summary.averageWaitMs = queue.averageWaitMillis();
+  summary.tasksPerSecond = processed / elapsed.count();
+  summary.inversionRate = census.inversionRate();
+  if constexpr (requires { queue.wakeupStats(); }) {
+    summary.wakeups = queue.wakeupStats();
+  }
+  for (int level = 1; level <= 4; ++level) {
+    summary.queueWait[level - 1] = queue.waitStats().sojourn(static_cast<Priority>(level));
+    summary.endToEnd[level - 1] = endToEnd[level - 1].snapshot();
+  }
+  const auto& critical = summary.endToEnd[static_cast<std::size_t>(Priority::CRITICAL) - 1];
+  summary.criticalSloMet = critical.p99 <= profile.criticalSlo;
 
   std::cout << "Produced tasks: " << summary.produced << std::endl;
   for (std::size_t idx = 0; idx < summary.processedPerConsumer.size(); ++idx) {
@@ -322,16 +891,242 @@ SimulationSummary runSimulation(const SimulationProfile& profile) {
               << std::endl;
   }
   std::cout << "Average consumer wait: " << formatMillis(summary.averageWaitMs) << " ms" << std::endl;
+  std::cout << "Throughput: " << formatMillis(summary.tasksPerSecond) << " tasks/s, priority inversions: "
+            << formatMillis(summary.inversionRate * 100.0) << "% of pops" << std::endl;
+  if (summary.wakeups) {
+    std::cout << "Wakeups: " << summary.wakeups->notified << " notified, " << summary.wakeups->futile << " futile, "
+              << summary.wakeups->spurious << " spurious" << std::endl;
+  }
+  const auto slot = [](Priority priority) { return static_cast<std::size_t>(priority) - 1; };
+  std::cout << "Queue wait ms p50/p99/max (push to pop):"
+            << formatLatencies([&](Priority priority) { return summary.queueWait[slot(priority)]; }) << std::endl;
+  std::cout << "End-to-end ms p50/p99/max (push to processed):"
+            << formatLatencies([&](Priority priority) { return summary.endToEnd[slot(priority)]; }) << std::endl;
+  std::cout << "CRITICAL p99 end-to-end " << formatMillis(toMillis(critical.p99)) << " ms vs SLO "
+            << profile.criticalSlo.count() << " ms: " << (summary.criticalSloMet ? "met" : "MISSED") << std::endl;
+  std::cout << "Deadline misses:";
+  for (int level = 1; level <= 4; ++level) {
+    std::cout << " " << priorityName(static_cast<Priority>(level)) << " "
+              << formatMillis(summary.deadlineMissRate[level - 1] * 100.0) << "%";
+  }
+  std::cout << " (all " << formatMillis(summary.overallMissRate * 100.0) << "%)" << std::endl;
 
   return summary;
 }
 
-int main() {
+// Raw queue throughput: producers push tasks back to back, consumers pop until everything is drained
+// Batched: consumers drain with pop_batch and an AdaptiveBatch instead of one pop per task
+template <typename Queue, bool Batched = false>
+std::chrono::nanoseconds pumpTasks(int producers, int consumers, int tasksPerProducer) {
+  Queue queue;
+  const int total = producers * tasksPerProducer;
+  std::atomic<int> consumed{0};
+  std::atomic<bool> go{false};
+  std::vector<std::jthread> threads;
+
+  for (int p = 0; p < producers; ++p) {
+    threads.emplace_back([&, p] {
+      while (!go.load(std::memory_order_acquire)) {
+      }
+      for (int i = 0; i < tasksPerProducer; ++i) {
+        queue.push(Task{p * tasksPerProducer + i, static_cast<Priority>(i % 4 + 1), "bench"});
+      }
+    });
+  }
+  for (int c = 0; c < consumers; ++c) {
+    threads.emplace_back([&] {
+      Task task{0, Priority::LOW, ""};
+      std::vector<Task> batch;
+      AdaptiveBatch sizer;
+      while (!go.load(std::memory_order_acquire)) {
+      }
+      while (consumed.load(std::memory_order_relaxed) < total) {
+        if constexpr (Batched) {
+          batch.clear();
+          const std::size_t taken = queue.pop_batch(batch, sizer.next(), Priority::LOW, 1ms);
+          sizer.record(taken);
+          consumed.fetch_add(static_cast<int>(taken), std::memory_order_relaxed);
+        } else if (queue.pop(task, Priority::LOW, 1ms)) {
+          consumed.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    });
+  }
+
+  const auto start = microbench::Clock::now();
+  go.store(true, std::memory_order_release);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return microbench::Clock::now() - start;
+}
+
+constexpr int kTasksPerProducer = 20'000;
+
+// PriorityTaskQueue on each spin / adaptive lock, for the same producer/consumer mix
+template <typename... Mutexes>
+std::vector<microbench::Summary> measureLockTypes(const std::string& suffix, int producers, int consumers,
+                                                  const microbench::Options& options) {
+  return {microbench::measureTimed(
+      std::string(locks::kLockName<Mutexes>) + suffix,
+      [&] { return pumpTasks<PriorityTaskQueue<Mutexes>>(producers, consumers, kTasksPerProducer); }, options)...};
+}
+
+void runThroughputMatrix(microbench::Format format) {
+  const microbench::Options options{.warmupRuns = 1, .minSamples = 5, .maxSamples = 15, .timeBudget = 200ms};
+
+  std::vector<microbench::Summary> summaries;
+  if (format == microbench::Format::Table) {
+    std::cout << "=== PriorityTaskQueue throughput (" << kTasksPerProducer
+              << " tasks per producer, median ms; * = significant at 95%) ===" << std::endl;
+    std::cout << std::left << std::setw(6) << "Prod" << std::setw(6) << "Cons" << std::setw(12) << "std::mutex"
+              << std::setw(10) << "Batched" << std::setw(10) << "Speedup" << std::setw(16) << "Flat-combining"
+              << std::setw(10) << "Speedup" << std::setw(12) << "MultiQueue" << std::setw(10) << "Speedup"
+              << std::setw(14) << "ttas-backoff" << std::setw(10) << "ticket" << std::setw(10) << "mcs"
+              << std::setw(10) << "adaptive" << std::endl;
+    std::cout << std::string(136, '-') << std::endl;
+  }
+
+  for (const int producers : {1, 2, 4}) {
+    for (const int consumers : {1, 2, 4}) {
+      const std::string suffix = "/" + std::to_string(producers) + "p" + std::to_string(consumers) + "c";
+      auto mutexQueue = microbench::measureTimed(
+          "mutex" + suffix,
+          [&] { return pumpTasks<PriorityTaskQueue<>>(producers, consumers, kTasksPerProducer); }, options);
+      auto batchedQueue = microbench::measureTimed(
+          "mutex-batched" + suffix,
+          [&] { return pumpTasks<PriorityTaskQueue<>, true>(producers, consumers, kTasksPerProducer); }, options);
+      auto combiningQueue = microbench::measureTimed(
+          "flat-combining" + suffix,
+          [&] { return pumpTasks<FlatCombiningPriorityTaskQueue>(producers, consumers, kTasksPerProducer); },
+          options);
+      auto multiQueue = microbench::measureTimed(
+          "multiqueue" + suffix,
+          [&] { return pumpTasks<MultiQueuePriorityTaskQueue<>>(producers, consumers, kTasksPerProducer); }, options);
+      auto lockQueues = measureLockTypes<locks::TtasSpinLock, locks::TicketLock, locks::McsLock,
+                                         locks::AdaptiveMutex>(suffix, producers, consumers, options);
+
+      if (format == microbench::Format::Table) {
+        const auto speedupOver = [&mutexQueue](const microbench::Summary& candidate) {
+          const auto comparison = microbench::compare(mutexQueue, candidate);
+          std::ostringstream speedup;
+          speedup << std::fixed << std::setprecision(3) << comparison.speedup << (comparison.significant ? "*" : "");
+          return speedup.str();
+        };
+        std::cout << std::left << std::fixed << std::setprecision(2) << std::setw(6) << producers << std::setw(6)
+                  << consumers << std::setw(12) << mutexQueue.medianMillis() << std::setw(10)
+                  << batchedQueue.medianMillis() << std::setw(10) << speedupOver(batchedQueue) << std::setw(16)
+                  << combiningQueue.medianMillis() << std::setw(10) << speedupOver(combiningQueue) << std::setw(12)
+                  << multiQueue.medianMillis() << std::setw(10) << speedupOver(multiQueue) << std::setw(14)
+                  << lockQueues[0].medianMillis();
+        for (std::size_t idx = 1; idx < lockQueues.size(); ++idx) {
+          std::cout << std::setw(10) << lockQueues[idx].medianMillis();
+        }
+        std::cout << std::endl;
+      }
+      summaries.push_back(std::move(mutexQueue));
+      summaries.push_back(std::move(batchedQueue));
+      summaries.push_back(std::move(combiningQueue));
+      summaries.push_back(std::move(multiQueue));
+      summaries.insert(summaries.end(), lockQueues.begin(), lockQueues.end());
+    }
+  }
+
+  if (format != microbench::Format::Table) {
+    microbench::write(std::cout, summaries, format);
+  }
+}
+
+// Several queue backends (or policies) on every scenario, side by side
+template <typename... Queues>
+void compareQueues(const std::vector<SimulationProfile>& profiles,
+                   const std::array<std::string_view, sizeof...(Queues)>& names) {
+  struct Row {
+    std::string_view label;
+    std::array<SimulationSummary, sizeof...(Queues)> runs;
+  };
+  std::vector<Row> rows;
+  for (const auto& profile : profiles) {
+    // Braced initialisation runs the simulations in order, one at a time
+    rows.push_back(Row{profile.label, {runSimulation<Queues>(profile)...}});
+  }
+
+  std::cout << "\n===";
+  for (std::size_t idx = 0; idx < names.size(); ++idx) {
+    std::cout << (idx == 0 ? " " : " vs ") << names[idx];
+  }
+  std::cout << " ===" << std::endl;
+  std::cout << std::left << std::setw(26) << "Scenario" << std::setw(10) << "Queue" << std::setw(10) << "tasks/s"
+            << std::setw(12) << "inversions" << std::setw(10) << "notified" << std::setw(8) << "futile"
+            << std::setw(10) << "spurious" << std::setw(14) << "crit p99 ms" << std::setw(10) << "missed"
+            << std::setw(22) << "missed L/N/H/C %" << std::endl;
+  std::cout << std::string(132, '-') << std::endl;
+  const auto count = [](const std::optional<WakeupStats>& wakeups, std::uint64_t WakeupStats::*field) {
+    return wakeups ? std::to_string((*wakeups).*field) : std::string("-");
+  };
+  const auto missesByClass = [](const SimulationSummary& run) {
+    std::ostringstream misses;
+    misses << std::fixed << std::setprecision(1);
+    for (std::size_t idx = 0; idx < run.deadlineMissRate.size(); ++idx) {
+      misses << (idx == 0 ? "" : "/") << run.deadlineMissRate[idx] * 100.0;
+    }
+    return misses.str();
+  };
+  for (const auto& row : rows) {
+    for (std::size_t idx = 0; idx < row.runs.size(); ++idx) {
+      const auto& run = row.runs[idx];
+      std::cout << std::left << std::setw(26) << (idx == 0 ? row.label : "") << std::setw(10) << names[idx]
+                << std::setw(10) << formatMillis(run.tasksPerSecond) << std::setw(12)
+                << (formatMillis(run.inversionRate * 100.0) + "%") << std::setw(10)
+                << count(run.wakeups, &WakeupStats::notified) << std::setw(8)
+                << count(run.wakeups, &WakeupStats::futile) << std::setw(10)
+                << count(run.wakeups, &WakeupStats::spurious) << std::setw(14)
+                << (formatMillis(toMillis(run.endToEnd[static_cast<std::size_t>(Priority::CRITICAL) - 1].p99)) +
+                    (run.criticalSloMet ? "" : " !"))
+                << std::setw(10) << (formatMillis(run.overallMissRate * 100.0) + "%") << std::setw(22)
+                << missesByClass(run) << std::endl;
+    }
+  }
+  std::cout << "Inversions: share of pops that left a strictly more urgent task queued. Futile: notified, but nothing"
+            << "\nthe consumer may take was left; spurious: woke without being notified. Crit p99: CRITICAL"
+            << "\npush-to-processed p99 (! = over the scenario's SLO). Missed: tasks processed after their deadline,"
+            << "\noverall and per class." << std::endl;
+}
+
+// --bench [--csv|--json]: throughput matrix instead of the simulations
+// --flat-combining:        run the simulations on FlatCombiningPriorityTaskQueue
+// --multiqueue:            run the simulations on MultiQueuePriorityTaskQueue
+// --compare-backends:      run every simulation on the strict and the MultiQueue backend and tabulate both
+// --compare-wakeups:       same for the shared wait list vs per-priority wait lists of the strict queue
+// --compare-policies:      same for strict priority vs earliest deadline first vs weighted-fair ordering
+int main(int argc, char* argv[]) {
+  bool flatCombining = false;
+  bool multiQueue = false;
+  bool compare = false;
+  bool compareWakeups = false;
+  bool comparePolicies = false;
+  for (int idx = 1; idx < argc; ++idx) {
+    const std::string_view arg(argv[idx]);
+    if (arg == "--bench") {
+      runThroughputMatrix(microbench::formatFromArgs(argc, argv));
+      return 0;
+    }
+    flatCombining = flatCombining || arg == "--flat-combining";
+    multiQueue = multiQueue || arg == "--multiqueue";
+    compare = compare || arg == "--compare-backends";
+    compareWakeups = compareWakeups || arg == "--compare-wakeups";
+    comparePolicies = comparePolicies || arg == "--compare-policies";
+  }
+
   const std::vector<SimulationProfile> profiles{
       {.label = "Balanced mixed workload",
        .producerProfiles = {
            {.name = "telemetry", .minDelay = 30ms, .maxDelay = 90ms, .priorityWeights = {6, 5, 3, 1}},
-           {.name = "payments", .minDelay = 40ms, .maxDelay = 120ms, .priorityWeights = {2, 4, 6, 3}},
+           {.name = "payments",
+            .minDelay = 40ms,
+            .maxDelay = 120ms,
+            .priorityWeights = {2, 4, 6, 3},
+            .deadlineBudgets = {2000ms, 300ms, 400ms, 250ms}},
        },
        .generalConsumers = 2,
        .urgentOnlyConsumers = 1,
@@ -360,10 +1155,50 @@ int main() {
        .urgentOnlyConsumers = 2,
        .urgentThreshold = Priority::CRITICAL,
        .duration = 3s,
-       .monitorInterval = 300ms}};
+       .monitorInterval = 300ms},
+      {.label = "Producer fan-in",
+       .producerProfiles = {
+           {.name = "feed-a", .minDelay = 40ms, .maxDelay = 120ms, .priorityWeights = {6, 4, 2, 1}},
+           {.name = "feed-b", .minDelay = 40ms, .maxDelay = 120ms, .priorityWeights = {6, 4, 2, 1}},
+           {.name = "feed-c", .minDelay = 40ms, .maxDelay = 120ms, .priorityWeights = {5, 5, 2, 1}},
+           {.name = "feed-d", .minDelay = 40ms, .maxDelay = 120ms, .priorityWeights = {5, 5, 2, 1}},
+           {.name = "orders-a", .minDelay = 60ms, .maxDelay = 160ms, .priorityWeights = {1, 2, 5, 4}},
+           {.name = "orders-b", .minDelay = 60ms, .maxDelay = 160ms, .priorityWeights = {1, 2, 5, 4}},
+           {.name = "risk", .minDelay = 80ms, .maxDelay = 200ms, .priorityWeights = {0, 1, 3, 6}},
+           {.name = "reports", .minDelay = 100ms, .maxDelay = 300ms, .priorityWeights = {8, 2, 0, 0}},
+       },
+       .generalConsumers = 6,
+       .urgentOnlyConsumers = 2,
+       .urgentThreshold = Priority::HIGH,
+       .duration = 2s,
+       .monitorInterval = 500ms}};
+
+  if (compare || compareWakeups || comparePolicies) {
+    if (compare) {
+      compareQueues<PriorityTaskQueue<>, MultiQueuePriorityTaskQueue<>>(profiles, {"strict", "multiqueue"});
+    } else if (compareWakeups) {
+      compareQueues<PriorityTaskQueue<std::mutex, false>, PriorityTaskQueue<>>(profiles, {"shared", "per-class"});
+    } else {
+      using scheduling::EarliestDeadlineFirst;
+      using scheduling::StrictPriority;
+      using scheduling::WeightedFair;
+      compareQueues<PriorityTaskQueue<std::mutex, true, StrictPriority>,
+                    PriorityTaskQueue<std::mutex, true, EarliestDeadlineFirst>,
+                    PriorityTaskQueue<std::mutex, true, WeightedFair>>(
+          profiles, {StrictPriority::kName, EarliestDeadlineFirst::kName, WeightedFair::kName});
+    }
+    std::cout << "\nAll simulations completed successfully." << std::endl;
+    return 0;
+  }
 
   for (const auto& profile : profiles) {
-    runSimulation(profile);
+    if (flatCombining) {
+      runSimulation<FlatCombiningPriorityTaskQueue>(profile);
+    } else if (multiQueue) {
+      runSimulation<MultiQueuePriorityTaskQueue<>>(profile);
+    } else {
+      runSimulation<PriorityTaskQueue<>>(profile);
+    }
   }
 
   std::cout << "\nAll simulations completed successfully." << std::endl;
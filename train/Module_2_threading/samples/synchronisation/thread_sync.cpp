@@ -17,49 +17,23 @@ Writers get exclusive access and block all other operations
 No data corruption occurs during concurrent read/write operations
 Performance metrics show the benefits of reader-writer synchronization
 */
+#include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <iostream>
 #include <map>
 #include <mutex>
 #include <random>
 #include <ranges>
 #include <shared_mutex>
+#include <string>
 #include <string_view>
 #include <thread>
 #include <vector>
 
-template <typename T>
-class ThreadSafeMap {
- private:
-  mutable std::shared_mutex mutex_;
-  std::map<std::string, T> data_;
-
- public:
-  void insert(const std::string& key, const T& value) {
-    std::unique_lock<std::shared_mutex> lock(mutex_);
-    data_[key] = value;
-  }
-
-  bool find(const std::string& key, T& value) const {
-    std::shared_lock<std::shared_mutex> lock(mutex_);
-    auto it = data_.find(key);
-    if (it != data_.end()) {
-      value = it->second;
-      return true;
-    }
-    return false;
-  }
-
-  size_t size() const {
-    std::shared_lock<std::shared_mutex> lock(mutex_);
-    return data_.size();
-  }
-
-  std::vector<std::pair<std::string, T>> getAllEntries() const {
-    std::shared_lock<std::shared_mutex> lock(mutex_);
-    return std::vector<std::pair<std::string, T>>(data_.begin(), data_.end());
-  }
-};
+#include "MicroBenchmark.h"
+#include "SpinLocks.h"
+#include "ThreadSafeMap.h"
 
 // Performance monitoring class
 class PerformanceTracker {
@@ -117,6 +91,59 @@ void log_thread_safe(std::string_view message) {
   std::cout << message << "\n";
 }
 
+// Same 10 readers / 3 writers, without the sleeps, once per lock type. Each sample starts every worker behind a
+// barrier and times from its release to the last join, so thread creation stays out of the measurement.
+template <typename Mutex>
+void timeReadWriteMix() {
+  constexpr int kWriters = 3;
+  constexpr int kReaders = 10;
+  constexpr int kOpsPerThread = 20000;
+  const microbench::Options options{
+      .warmupRuns = 1, .minSamples = 5, .maxSamples = 20, .timeBudget = std::chrono::milliseconds(500)};
+
+  std::size_t keys = 0;
+  const auto summary = microbench::measureTimed(std::string(locks::kLockName<Mutex>), [&] {
+    ThreadSafeMap<double, Mutex> map;
+    std::atomic<bool> go{false};
+    std::vector<std::thread> workers;
+    for (int idx = 0; idx < kWriters; ++idx) {
+      workers.emplace_back([&map, &go, idx] {
+        while (!go.load(std::memory_order_acquire)) {
+          std::this_thread::yield();
+        }
+        for (int j = 0; j < kOpsPerThread; ++j) {
+          map.insert("stock" + std::to_string((idx * kOpsPerThread + j) % 300), 100.0 + j % 100);
+        }
+      });
+    }
+    for (int idx = 0; idx < kReaders; ++idx) {
+      workers.emplace_back([&map, &go, idx] {
+        std::mt19937 rng(idx);
+        double price = 0.0;
+        while (!go.load(std::memory_order_acquire)) {
+          std::this_thread::yield();
+        }
+        for (int j = 0; j < kOpsPerThread; ++j) {
+          (void)map.find("stock" + std::to_string(rng() % 300), price);
+        }
+      });
+    }
+
+    const auto start = microbench::Clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& worker : workers) {
+      worker.join();
+    }
+    const auto elapsed = microbench::Clock::now() - start;
+    keys = map.size();
+    return elapsed;
+  }, options);
+
+  std::cout << "  " << summary.name << ": " << summary.medianMillis() << " ms median (95% CI "
+            << summary.ciLowNanos / 1e6 << "-" << summary.ciHighNanos / 1e6 << " ms, " << summary.samples
+            << " samples, " << summary.outliers << " outliers, " << keys << " keys)" << std::endl;
+}
+
 int main() {
   ThreadSafeMap<double> priceMap;
   PerformanceTracker tracker;
@@ -156,5 +183,15 @@ int main() {
   tracker.printStatistics();
   std::cout << "Final map size: " << priceMap.size() << std::endl;
 
+  readers.clear();  // joins, so the demo threads do not skew the timings below
+  writters.clear();
+  std::cout << "Read/write mix by lock type:" << std::endl;
+  timeReadWriteMix<std::shared_mutex>();
+  timeReadWriteMix<std::mutex>();
+  timeReadWriteMix<locks::TtasSpinLock>();
+  timeReadWriteMix<locks::TicketLock>();
+  timeReadWriteMix<locks::McsLock>();
+  timeReadWriteMix<locks::AdaptiveMutex>();
+
   return 0;
 }
\ No newline at end of file